@@ -13,6 +13,19 @@ extern "C" {
 // enable dtls for data channel
 #define MBEDTLS_SSL_DTLS_SRTP
 
+// TLS 1.3 with ticket based PSK resumption and client 0-RTT for signaling reconnects
+#define MBEDTLS_SSL_PROTO_TLS1_3
+#define MBEDTLS_SSL_TLS1_3_COMPATIBILITY_MODE
+#define MBEDTLS_SSL_SESSION_TICKETS
+#define MBEDTLS_SSL_EARLY_DATA
+
+// record buffers shrink to the negotiated max fragment length after the handshake
+#define MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
+#define MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH
+
+// server private key operations can run on a worker thread instead of the event loop
+#define MBEDTLS_SSL_ASYNC_PRIVATE
+
 #undef MBEDTLS_SSL_CBC_RECORD_SPLITTING
 #undef MBEDTLS_SSL_PROTO_TLS1
 #undef MBEDTLS_SSL_PROTO_TLS1_1
@@ -87,6 +87,11 @@ extern "C" {
  */
 #define VOLC_RTC_SHA1_DIGEST_LENGTH 20
 
+/**
+ * @brief 定义 SHA256 哈希算法的摘要长度，单位为字节。
+ */
+#define VOLC_RTC_SHA256_DIGEST_LENGTH 32
+
 /**
  * @brief 定义 AES256 加密算法的密钥长度，单位为字节。
  * 
@@ -118,7 +123,7 @@ typedef void* volc_pkey_t;
 /**
  * @brief 定义 SRTP 配置文件的枚举类型。
  * 
- * 该枚举类型定义了不同的 SRTP 配置文件，包括 AES128_CM_HMAC_SHA1_80 和 AES128_CM_HMAC_SHA1_32。
+ * 该枚举类型定义了不同的 SRTP 配置文件，包括 AES128_CM_HMAC_SHA1_80、AES128_CM_HMAC_SHA1_32 以及 AEAD_AES_128_GCM、AEAD_AES_256_GCM。
  */
 typedef enum {
     /**
@@ -129,8 +134,69 @@ typedef enum {
      * @brief 使用 AES128-CM 和 HMAC-SHA1-32 的 SRTP 配置文件。
      */
     VOLC_SRTP_PROFILE_AES128_CM_HMAC_SHA1_32 = 1,
+    /**
+     * @brief 使用 AES-128-GCM 认证加密的 SRTP 配置文件（RFC 7714），单次遍历完成加密和认证。
+     */
+    VOLC_SRTP_PROFILE_AEAD_AES_128_GCM = 2,
+    /**
+     * @brief 使用 AES-256-GCM 认证加密的 SRTP 配置文件（RFC 7714）。
+     */
+    VOLC_SRTP_PROFILE_AEAD_AES_256_GCM = 3,
 } volc_srtp_profile_t;
 
+/**
+ * @brief SRTP 主密钥的最大长度。
+ */
+#define VOLC_SRTP_MAX_MASTER_KEY_LENGTH  32
+/**
+ * @brief SRTP 主盐的最大长度。
+ */
+#define VOLC_SRTP_MAX_MASTER_SALT_LENGTH 14
+/**
+ * @brief AES-CM 配置文件的主盐长度。
+ */
+#define VOLC_SRTP_CM_MASTER_SALT_LENGTH  14
+/**
+ * @brief AEAD AES-GCM 配置文件的主盐长度。
+ */
+#define VOLC_SRTP_GCM_MASTER_SALT_LENGTH 12
+
+/**
+ * @brief DTLS-SRTP 协商得到的密钥材料。
+ *
+ * local 为本端发送方向使用的密钥，remote 为对端发送方向（本端接收）使用的密钥。
+ */
+typedef struct {
+    /**
+     * @brief 协商得到的 SRTP 配置文件。
+     */
+    volc_srtp_profile_t profile;
+    /**
+     * @brief 本端主密钥。
+     */
+    uint8_t local_master_key[VOLC_SRTP_MAX_MASTER_KEY_LENGTH];
+    /**
+     * @brief 本端主盐。
+     */
+    uint8_t local_master_salt[VOLC_SRTP_MAX_MASTER_SALT_LENGTH];
+    /**
+     * @brief 对端主密钥。
+     */
+    uint8_t remote_master_key[VOLC_SRTP_MAX_MASTER_KEY_LENGTH];
+    /**
+     * @brief 对端主盐。
+     */
+    uint8_t remote_master_salt[VOLC_SRTP_MAX_MASTER_SALT_LENGTH];
+    /**
+     * @brief 主密钥的有效长度。
+     */
+    uint32_t master_key_length;
+    /**
+     * @brief 主盐的有效长度。
+     */
+    uint32_t master_salt_length;
+} volc_srtp_keying_material_t;
+
 /**
  * @brief 创建证书和密钥对。
  *
@@ -180,6 +246,199 @@ __byte_rtc_api__ void volc_md5(const unsigned char* input, size_t ilen, unsigned
  */
 __byte_rtc_api__ void volc_sha1_hmac(const unsigned char* key, size_t keylen, const unsigned char* input, size_t ilen, unsigned char* output, uint32_t* plen);
 
+/**
+ * @brief 当前选用的密码算法实现，每一项为实现名称的字符串常量，例如 "portable"、"aesni"、"sha-ni"。
+ */
+typedef struct {
+    /**
+     * @brief AES 分组加密，由 mbedtls 在运行时选择（"aesni"、"armv8-ce"、"hw-alt" 或 "portable"）。
+     */
+    const char* aes;
+    /**
+     * @brief AES-GCM 使用的 GHASH，由 mbedtls 在运行时选择（"pclmulqdq"、"armv8-pmull"、"hw-alt" 或 "table"）。
+     */
+    const char* ghash;
+    /**
+     * @brief HAL 内 SHA1（HMAC-SHA1、SRTP 认证）使用的压缩函数（"sha-ni" 或 "portable"）。
+     */
+    const char* sha1;
+    /**
+     * @brief HAL 内 SHA256 使用的压缩函数（"sha-ni" 或 "portable"）。
+     */
+    const char* sha256;
+    /**
+     * @brief HAL 内 AES-CTR（`volc_aes_ctr_*`、SRTP 加解密）使用的实现，"aesni-x8" 表示 8 个计数器块交错流水，否则与 aes 相同由 mbedtls 完成。
+     */
+    const char* aes_ctr;
+    /**
+     * @brief 批量 HMAC-SHA1 使用的实现，"avx2-x8" 表示 8 条消息并行计算，否则逐条使用 sha1 的实现。
+     */
+    const char* sha1_batch;
+    /**
+     * @brief `volc_crc32` 使用的实现（"pclmulqdq" 或 "slice-by-8"）。
+     */
+    const char* crc32;
+    /**
+     * @brief `volc_crc32c` 使用的实现（"sse4.2" 或 "slice-by-8"）。
+     */
+    const char* crc32c;
+} volc_crypto_implementations_t;
+
+/**
+ * @brief 获取当前选用的密码算法实现。
+ *
+ * 首次使用任何 HAL 密码函数时会按 `volc_get_cpu_features` 的结果自动选择实现，本函数用于日志上报和排查性能差异。
+ *
+ * @param p_impls 用于存储各算法的实现名称。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_crypto_get_implementations(volc_crypto_implementations_t* p_impls);
+
+/**
+ * @brief 按给定的 CPU 特性重新选择 HAL 内的密码算法实现。
+ *
+ * 传入 `volc_get_cpu_features()` 去掉部分特性位的结果可以屏蔽对应的加速实现，传入 0 则全部使用可移植实现，
+ * 用于性能对比或规避个别 CPU 的问题。只影响 HAL 自身的实现，AES 和 GHASH 仍由 mbedtls 自行选择。
+ * 该函数不是线程安全的，应在进程启动、尚未使用任何密码函数时调用；已创建的上下文继续使用创建时的实现。
+ *
+ * @param cpu_features VOLC_CPU_FEATURE_* 特性位的组合，不支持的特性位会被忽略。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_crypto_select_implementations(uint32_t cpu_features);
+
+/**
+ * @brief 计算 SHA256 哈希值，CPU 支持时使用 SHA 扩展指令。
+ *
+ * @param input 输入数据的指针。
+ * @param ilen 输入数据的长度。
+ * @param output 存储哈希值的数组，长度必须为 VOLC_RTC_SHA256_DIGEST_LENGTH。
+ */
+__byte_rtc_api__ void volc_sha256(const unsigned char* input, size_t ilen, unsigned char output[VOLC_RTC_SHA256_DIGEST_LENGTH]);
+
+/**
+ * @brief 计算 CRC-32（IEEE 802.3 多项式，与 zlib 的 crc32 相同），STUN FINGERPRINT 即为该值与 0x5354554e 异或。
+ *
+ * 支持分段计算：第一段传入 crc 为 0，之后每段传入上一段的返回值，结果与一次计算全部数据相同。
+ * CPU 支持 PCLMULQDQ 时使用无进位乘法折叠，否则使用 slicing-by-8 查表。
+ *
+ * @param crc 之前数据的 CRC 值，从头开始计算时为 0。
+ * @param data 输入数据的指针。
+ * @param len 输入数据的长度。
+ * @return 包含本段数据后的 CRC 值。
+ */
+__byte_rtc_api__ uint32_t volc_crc32(uint32_t crc, const unsigned char* data, size_t len);
+
+/**
+ * @brief 计算 CRC-32C（Castagnoli 多项式，SCTP、iSCSI 等使用），用法与 `volc_crc32` 相同。
+ *
+ * CPU 支持 SSE4.2 时使用 crc32 指令并以三路交错隐藏指令延迟，否则使用 slicing-by-8 查表。
+ *
+ * @param crc 之前数据的 CRC 值，从头开始计算时为 0。
+ * @param data 输入数据的指针。
+ * @param len 输入数据的长度。
+ * @return 包含本段数据后的 CRC 值。
+ */
+__byte_rtc_api__ uint32_t volc_crc32c(uint32_t crc, const unsigned char* data, size_t len);
+
+/**
+ * @brief 预计算密钥的 HMAC-SHA1 上下文句柄。
+ *
+ * 上下文在创建时把密钥与内外填充（ipad/opad）各压缩一次并保存中间状态，之后每条消息只需从保存的状态继续计算，
+ * 比 `volc_sha1_hmac` 每次调用少两次 SHA1 压缩，适合 STUN MESSAGE-INTEGRITY、SRTP 认证等同一密钥反复使用的场景。
+ * 上下文不是线程安全的。
+ */
+typedef void* volc_sha1_hmac_t;
+
+/**
+ * @brief 创建预计算密钥的 HMAC-SHA1 上下文。
+ *
+ * 创建后即可直接调用 `volc_sha1_hmac_update` 开始计算第一条消息。
+ *
+ * @param key 用于 HMAC 计算的密钥，函数返回后即可释放。
+ * @param keylen 密钥的长度。
+ * @param p_ctx 用于存储新创建的上下文句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_sha1_hmac_create(const unsigned char* key, size_t keylen, volc_sha1_hmac_t* p_ctx);
+
+/**
+ * @brief 销毁 HMAC-SHA1 上下文并清除保存的密钥状态。
+ *
+ * @param ctx 上下文句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_sha1_hmac_destroy(volc_sha1_hmac_t ctx);
+
+/**
+ * @brief 丢弃当前未完成的消息，重新从预计算的内填充状态开始。
+ *
+ * @param ctx 上下文句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_sha1_hmac_reset(volc_sha1_hmac_t ctx);
+
+/**
+ * @brief 向当前消息追加数据，可多次调用。
+ *
+ * @param ctx 上下文句柄。
+ * @param input 输入数据的指针。
+ * @param ilen 输入数据的长度。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_sha1_hmac_update(volc_sha1_hmac_t ctx, const unsigned char* input, size_t ilen);
+
+/**
+ * @brief 结束当前消息并输出 HMAC 值，上下文随后自动重置，可直接计算下一条消息。
+ *
+ * @param ctx 上下文句柄。
+ * @param output 存储 HMAC 值的数组，长度必须为 VOLC_RTC_SHA1_DIGEST_LENGTH。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_sha1_hmac_finish(volc_sha1_hmac_t ctx, unsigned char output[VOLC_RTC_SHA1_DIGEST_LENGTH]);
+
+/**
+ * @brief 使用预计算密钥的上下文一次性计算一条消息的 HMAC 值，结果与 `volc_sha1_hmac` 相同。
+ *
+ * @param ctx 上下文句柄，之前未完成的消息会被丢弃。
+ * @param input 输入数据的指针。
+ * @param ilen 输入数据的长度。
+ * @param output 存储 HMAC 值的数组，长度必须为 VOLC_RTC_SHA1_DIGEST_LENGTH。
+ * @param plen 指向存储 HMAC 值长度的指针，可以为 NULL。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_sha1_hmac_compute(volc_sha1_hmac_t ctx, const unsigned char* input, size_t ilen, unsigned char* output, uint32_t* plen);
+
+/**
+ * @brief 批量计算 HMAC 时的一条消息。
+ */
+typedef struct {
+    /**
+     * @brief 输入数据。
+     */
+    const unsigned char* input;
+    /**
+     * @brief 输入数据的长度。
+     */
+    size_t ilen;
+    /**
+     * @brief HMAC 值，由 `volc_sha1_hmac_compute_batch` 填写。
+     */
+    unsigned char output[VOLC_RTC_SHA1_DIGEST_LENGTH];
+} volc_sha1_hmac_buffer_t;
+
+/**
+ * @brief 使用同一密钥批量计算多条消息的 HMAC 值，结果与对每条消息调用 `volc_sha1_hmac_compute` 相同。
+ *
+ * CPU 支持 AVX2 且不支持 SHA 扩展指令时，8 条消息在 SIMD 的各个通道中同时计算，短消息（如 SRTP 数据包）的吞吐量显著提高；
+ * 其他情况下逐条计算。实际使用的实现可通过 `volc_crypto_get_implementations` 的 sha1_batch 查询。
+ *
+ * @param ctx 上下文句柄，之前未完成的消息会被丢弃。
+ * @param buffers 消息数组，计算完成后填写每条消息的 output。
+ * @param count 消息数量。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_sha1_hmac_compute_batch(volc_sha1_hmac_t ctx, volc_sha1_hmac_buffer_t* buffers, uint32_t count);
+
 /**
  * @brief 对输入数据进行加密或解密操作。
  *
@@ -194,7 +453,87 @@ __byte_rtc_api__ void volc_sha1_hmac(const unsigned char* key, size_t keylen, co
  * @param olen 指向存储输出数据长度的指针。
  * @return 操作结果的状态码。
  */
-__byte_rtc_api__ uint32_t volc_encrypt_or_decrypt(bool encrypt, const char* key, uint64_t iv, const unsigned char* input, uint32_t ilen, unsigned char* output, __byte_rtc_api__ uint32_t* olen);
+__byte_rtc_api__ uint32_t volc_encrypt_or_decrypt(bool encrypt, const char* key, uint64_t iv, const unsigned char* input, uint32_t ilen, unsigned char* output, uint32_t* olen);
+
+/**
+ * @brief AES-128-CTR 加解密上下文句柄。
+ *
+ * 上下文在创建时完成一次 AES 密钥扩展，之后每次加解密只需设置初始化向量，适合同一密钥处理大量消息的场景。
+ * 上下文不是线程安全的，多个线程并发使用时应各自创建。
+ */
+typedef void* volc_aes_ctr_t;
+
+/**
+ * @brief 批量加解密中的一个缓冲区。
+ */
+typedef struct {
+    /**
+     * @brief 初始化向量，与 `volc_encrypt_or_decrypt` 的 iv 参数含义相同。
+     */
+    uint64_t iv;
+    /**
+     * @brief 输入数据。
+     */
+    const unsigned char* input;
+    /**
+     * @brief 输入数据的长度。
+     */
+    uint32_t ilen;
+    /**
+     * @brief 输出缓冲区，至少 ilen + 1 字节，可以与 input 相同。
+     */
+    unsigned char* output;
+    /**
+     * @brief 输出数据的长度，由 `volc_aes_ctr_crypt_batch` 填写。
+     */
+    uint32_t olen;
+} volc_aes_ctr_buffer_t;
+
+/**
+ * @brief 创建 AES-128-CTR 加解密上下文。
+ *
+ * @param key 长度为 VOLC_AES128_KEY_LENGTH 的密钥，函数返回后即可释放。
+ * @param p_ctx 用于存储新创建的上下文句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_aes_ctr_create(const char* key, volc_aes_ctr_t* p_ctx);
+
+/**
+ * @brief 销毁 AES-128-CTR 加解密上下文并清除扩展后的密钥。
+ *
+ * @param ctx 上下文句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_aes_ctr_destroy(volc_aes_ctr_t ctx);
+
+/**
+ * @brief 使用已创建的上下文加密或解密数据。
+ *
+ * CTR 模式下加密和解密是同一操作，结果与使用相同密钥调用 `volc_encrypt_or_decrypt` 一致，
+ * 输出末尾同样追加一个 '\0'，因此 output 至少需要 ilen + 1 字节。
+ *
+ * @param ctx 上下文句柄。
+ * @param iv 初始化向量。
+ * @param input 输入数据的指针。
+ * @param ilen 输入数据的长度。
+ * @param output 存储加密或解密结果的数组，可以与 input 相同。
+ * @param olen 指向存储输出数据长度的指针。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_aes_ctr_crypt(volc_aes_ctr_t ctx, uint64_t iv, const unsigned char* input, uint32_t ilen, unsigned char* output, uint32_t* olen);
+
+/**
+ * @brief 使用已创建的上下文批量加密或解密多个缓冲区。
+ *
+ * 每个缓冲区使用各自的初始化向量，结果与对每个缓冲区依次调用 `volc_aes_ctr_crypt` 相同。
+ * 支持 AES-NI 时不同缓冲区的计数器块交错送入流水线，批量处理短数据包比逐个调用快得多。
+ *
+ * @param ctx 上下文句柄。
+ * @param buffers 缓冲区数组，处理完成后填写每个缓冲区的 olen。
+ * @param count 缓冲区数量。
+ * @return 操作结果的状态码，0 表示成功；参数错误时所有缓冲区都不会被处理。
+ */
+__byte_rtc_api__ uint32_t volc_aes_ctr_crypt_batch(volc_aes_ctr_t ctx, volc_aes_ctr_buffer_t* buffers, uint32_t count);
 
 /**
  * @brief 使用公钥验证签名。
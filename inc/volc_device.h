@@ -55,6 +55,35 @@ __byte_rtc_api__ uint32_t volc_get_os_version(char* name, uint32_t len);
  */
 __byte_rtc_api__ uint32_t volc_get_compiler_info(char* name, uint32_t len);
 
+/**
+ * @brief CPU 特性位，由 `volc_get_cpu_features` 返回，x86 和 ARM 的特性位互不重叠。
+ */
+#define VOLC_CPU_FEATURE_SSE2      (1u << 0)
+#define VOLC_CPU_FEATURE_SSSE3     (1u << 1)
+#define VOLC_CPU_FEATURE_SSE41     (1u << 2)
+#define VOLC_CPU_FEATURE_SSE42     (1u << 3)
+#define VOLC_CPU_FEATURE_AESNI     (1u << 4)
+#define VOLC_CPU_FEATURE_PCLMULQDQ (1u << 5)
+#define VOLC_CPU_FEATURE_AVX       (1u << 6)
+#define VOLC_CPU_FEATURE_AVX2      (1u << 7)
+#define VOLC_CPU_FEATURE_SHA       (1u << 8)
+#define VOLC_CPU_FEATURE_BMI2      (1u << 9)
+#define VOLC_CPU_FEATURE_NEON      (1u << 16)
+#define VOLC_CPU_FEATURE_ARM_AES   (1u << 17)
+#define VOLC_CPU_FEATURE_ARM_PMULL (1u << 18)
+#define VOLC_CPU_FEATURE_ARM_SHA1  (1u << 19)
+#define VOLC_CPU_FEATURE_ARM_SHA2  (1u << 20)
+#define VOLC_CPU_FEATURE_ARM_CRC32 (1u << 21)
+
+/**
+ * @brief 获取当前 CPU 支持的指令集扩展。
+ *
+ * 首次调用时通过 CPUID（x86）或系统接口（ARM）探测，之后返回缓存的结果。AVX/AVX2 只有在操作系统保存 YMM 寄存器时才会报告。
+ *
+ * @return VOLC_CPU_FEATURE_* 特性位的组合，无法探测的平台返回 0。
+ */
+__byte_rtc_api__ uint32_t volc_get_cpu_features(void);
+
 #ifdef __cplusplus
 }
 #endif
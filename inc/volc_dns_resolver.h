@@ -0,0 +1,124 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef __HAL_VOLC_DNS_RESOLVER_H__
+#define __HAL_VOLC_DNS_RESOLVER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "volc_network.h"
+#include "volc_worker_pool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_MSC_VER)
+#if defined(__BUILDING_BYTE_RTC_SDK__)
+#define __byte_rtc_api__ __declspec(dllexport)
+#else
+#define __byte_rtc_api__ __declspec(dllimport)
+#endif
+#else
+#define __byte_rtc_api__ __attribute__((visibility("default")))
+#endif
+
+/**
+ * @brief 主机名的最大长度。
+ */
+#define VOLC_DNS_MAX_HOST_NAME_LENGTH 255
+
+/**
+ * @brief 异步 DNS 解析器句柄
+ *
+ * 解析器不是线程安全的，所有接口和回调都在调用 volc_worker_pool_dispatch 的线程（通常是事件循环线程）中执行。
+ */
+typedef void* volc_dns_resolver_t;
+
+/**
+ * @brief 解析完成回调。
+ *
+ * @param status 解析结果的状态码，0 表示成功；解析失败为 VOLC_STATUS_RESOLVE_HOSTNAME_FAILED，解析器销毁时为 VOLC_STATUS_USER_CANCELED。
+ * @param addrs 地址列表，IPv6 地址在前，端口已设置为请求的端口（网络字节序），仅在回调期间有效。
+ * @param count 地址数量。
+ * @param custom_data 用户自定义的数据。
+ */
+typedef void (*volc_dns_resolve_callback_t)(uint32_t status, const volc_ip_addr_t* addrs, uint32_t count, uint64_t custom_data);
+
+/**
+ * @brief 异步 DNS 解析器配置。
+ */
+typedef struct {
+    /**
+     * @brief 解析成功结果的缓存时间，单位毫秒。系统解析接口不返回记录的 TTL，因此使用固定值。
+     */
+    uint32_t cache_ttl_ms;
+    /**
+     * @brief 解析失败结果的缓存时间，单位毫秒，0 表示不缓存失败结果。
+     */
+    uint32_t negative_ttl_ms;
+    /**
+     * @brief 缓存命中且距离过期不足该时间时，在后台提前刷新，单位毫秒，0 表示不预取。
+     */
+    uint32_t prefetch_before_ms;
+    /**
+     * @brief 最多缓存的主机名数量，超出时淘汰最久未使用的条目。
+     */
+    uint32_t max_entries;
+} volc_dns_resolver_config_t;
+
+/**
+ * @brief 获取默认的解析器配置。
+ *
+ * @param config 用于存储默认配置的结构体指针。
+ */
+__byte_rtc_api__ void volc_dns_resolver_get_default_config(volc_dns_resolver_config_t* config);
+
+/**
+ * @brief 创建异步 DNS 解析器。
+ *
+ * @param pool 执行阻塞解析的工作线程池，生命周期必须长于解析器，建议至少 2 个线程以并行查询 A/AAAA 记录。
+ * @param config 解析器配置，为 NULL 时使用默认配置。
+ * @param p_resolver 用于存储新创建的解析器句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_dns_resolver_create(volc_worker_pool_t pool, const volc_dns_resolver_config_t* config, volc_dns_resolver_t* p_resolver);
+
+/**
+ * @brief 销毁解析器，未完成的请求以 VOLC_STATUS_USER_CANCELED 回调。
+ *
+ * @param resolver 要销毁的解析器句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_dns_resolver_destroy(volc_dns_resolver_t resolver);
+
+/**
+ * @brief 异步解析主机名。
+ *
+ * 缓存命中时在本函数内直接回调；否则在工作线程中并行查询 A 和 AAAA 记录，
+ * 相同主机名的并发请求会合并为一次查询，结果通过 volc_worker_pool_dispatch 回调。
+ *
+ * @param resolver 解析器句柄。
+ * @param host 主机名或 IP 地址字符串。
+ * @param port 目标端口，主机字节序。
+ * @param callback 解析完成回调。
+ * @param custom_data 用户自定义的数据，将传递给回调函数。
+ * @return 操作结果的状态码，0 表示请求已受理，非 0 表示失败且不会回调。
+ */
+__byte_rtc_api__ uint32_t volc_dns_resolver_resolve(volc_dns_resolver_t resolver, const char* host, uint16_t port, volc_dns_resolve_callback_t callback, uint64_t custom_data);
+
+/**
+ * @brief 清空解析缓存，不影响正在进行的查询。
+ *
+ * @param resolver 解析器句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_dns_resolver_clear_cache(volc_dns_resolver_t resolver);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __HAL_VOLC_DNS_RESOLVER_H__ */
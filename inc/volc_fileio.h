@@ -8,6 +8,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <sys/types.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -93,6 +94,20 @@ __byte_rtc_api__ uint32_t volc_file_create(const char* path, uint64_t size);
  */
 __byte_rtc_api__ uint32_t volc_file_delete(const char* path);
 
+/**
+ * @brief 从文件描述符的指定偏移处读取内容。
+ *
+ * 该函数用于从已打开的文件中读取内容，不改变文件当前的读写位置，被信号中断时自动重试。
+ *
+ * @param fd 已打开的文件描述符。
+ * @param buffer 用于存储读取内容的缓冲区。
+ * @param size 最多读取的字节数。
+ * @param offset 读取的起始偏移。
+ * @param p_status 指向存储操作结果状态码的变量的指针，失败时为 VOLC_STATUS_READ_FILE_FAILED。
+ * @return 实际读取的字节数，0 表示已到文件末尾，-1 表示失败。
+ */
+__byte_rtc_api__ ssize_t volc_file_pread(int fd, uint8_t* buffer, size_t size, int64_t offset, uint32_t* p_status);
+
 
 #ifdef __cplusplus
 }
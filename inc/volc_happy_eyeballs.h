@@ -0,0 +1,95 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef __HAL_VOLC_HAPPY_EYEBALLS_H__
+#define __HAL_VOLC_HAPPY_EYEBALLS_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "volc_network.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_MSC_VER)
+#if defined(__BUILDING_BYTE_RTC_SDK__)
+#define __byte_rtc_api__ __declspec(dllexport)
+#else
+#define __byte_rtc_api__ __declspec(dllimport)
+#endif
+#else
+#define __byte_rtc_api__ __attribute__((visibility("default")))
+#endif
+
+/**
+ * @brief 同时进行的连接尝试的最大数量，受 volc_poll 支持的描述符数量限制。
+ */
+#define VOLC_HAPPY_EYEBALLS_MAX_ATTEMPTS 8
+
+/**
+ * @brief Happy Eyeballs（RFC 8305）连接配置。
+ */
+typedef struct {
+    /**
+     * @brief 相邻两次连接尝试之间的间隔，单位毫秒，默认 250 毫秒，最小 10 毫秒。
+     */
+    uint32_t connection_attempt_delay_ms;
+    /**
+     * @brief 整个连接过程的超时时间，单位毫秒。
+     */
+    uint32_t timeout_ms;
+    /**
+     * @brief 同时进行的连接尝试的最大数量，不超过 VOLC_HAPPY_EYEBALLS_MAX_ATTEMPTS。
+     */
+    uint32_t max_attempts;
+    /**
+     * @brief 是否优先尝试 IPv6 地址；为 false 时以解析结果中第一个地址的协议族优先。
+     */
+    bool prefer_ipv6;
+} volc_happy_eyeballs_config_t;
+
+/**
+ * @brief 获取默认的 Happy Eyeballs 连接配置。
+ *
+ * @param config 用于存储默认配置的结构体指针。
+ */
+__byte_rtc_api__ void volc_happy_eyeballs_get_default_config(volc_happy_eyeballs_config_t* config);
+
+/**
+ * @brief 使用 Happy Eyeballs 算法连接到已解析的地址列表。
+ *
+ * 地址按协议族交替排序（IPv6、IPv4、IPv6 ...），每隔 connection_attempt_delay_ms 发起一次新的非阻塞连接，
+ * 某次尝试失败时立即发起下一次，最先建立的连接胜出，其余连接被关闭。
+ *
+ * @param addrs 目标地址列表，端口为网络字节序。
+ * @param count 地址数量。
+ * @param config 连接配置，为 NULL 时使用默认配置。
+ * @param p_sockfd 用于存储已连接的 TCP 套接字，套接字为非阻塞模式，由调用者负责关闭。
+ * @param p_addr 用于存储实际连接的地址，可以为 NULL。
+ * @return 操作结果的状态码：<br>
+ *         - VOLC_STATUS_SUCCESS: 连接已建立 <br>
+ *         - VOLC_STATUS_OPERATION_TIMED_OUT: 在超时时间内没有连接成功 <br>
+ *         - VOLC_STATUS_SOCKET_CONNECT_FAILED: 所有地址都连接失败
+ */
+__byte_rtc_api__ uint32_t volc_happy_eyeballs_connect_addrs(const volc_ip_addr_t* addrs, uint32_t count, const volc_happy_eyeballs_config_t* config, int* p_sockfd, volc_ip_addr_t* p_addr);
+
+/**
+ * @brief 解析主机名的 A/AAAA 记录并使用 Happy Eyeballs 算法建立 TCP 连接。
+ *
+ * @param host 主机名或 IP 地址字符串。
+ * @param port 目标端口，主机字节序。
+ * @param config 连接配置，为 NULL 时使用默认配置。
+ * @param p_sockfd 用于存储已连接的 TCP 套接字，套接字为非阻塞模式，由调用者负责关闭。
+ * @param p_addr 用于存储实际连接的地址，可以为 NULL。
+ * @return 操作结果的状态码，解析失败时返回 VOLC_STATUS_RESOLVE_HOSTNAME_FAILED，其余同 volc_happy_eyeballs_connect_addrs。
+ */
+__byte_rtc_api__ uint32_t volc_happy_eyeballs_connect(const char* host, uint16_t port, const volc_happy_eyeballs_config_t* config, int* p_sockfd, volc_ip_addr_t* p_addr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __HAL_VOLC_HAPPY_EYEBALLS_H__ */
@@ -0,0 +1,228 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef __HAL_VOLC_SEND_SCHEDULER_H__
+#define __HAL_VOLC_SEND_SCHEDULER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "volc_network.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_MSC_VER)
+#if defined(__BUILDING_BYTE_RTC_SDK__)
+#define __byte_rtc_api__ __declspec(dllexport)
+#else
+#define __byte_rtc_api__ __declspec(dllimport)
+#endif
+#else
+#define __byte_rtc_api__ __attribute__((visibility("default")))
+#endif
+
+/**
+ * @brief 发送调度器句柄
+ *
+ * 每个套接字对应一个调度器，在发送缓冲区满时按优先级缓存并发送数据。
+ */
+typedef void* volc_send_scheduler_t;
+
+/**
+ * @brief 定义发送优先级，数值越小优先级越高。
+ */
+typedef enum {
+    /**
+     * @brief 音频数据，默认最高优先级。
+     */
+    VOLC_SEND_PRIORITY_AUDIO = 0,
+    /**
+     * @brief 视频数据。
+     */
+    VOLC_SEND_PRIORITY_VIDEO = 1,
+    /**
+     * @brief 其他数据，例如数据通道、日志等。
+     */
+    VOLC_SEND_PRIORITY_DATA  = 2,
+    /**
+     * @brief 优先级数量。
+     */
+    VOLC_SEND_PRIORITY_COUNT = 3,
+} volc_send_priority_e;
+
+/**
+ * @brief 定义队列之间的调度方式。
+ */
+typedef enum {
+    /**
+     * @brief 严格优先级：高优先级队列非空时不发送低优先级数据。
+     */
+    VOLC_SEND_SCHEDULE_STRICT   = 0,
+    /**
+     * @brief 加权调度：按各队列的权重（字节配额）轮询发送，避免低优先级饿死。
+     */
+    VOLC_SEND_SCHEDULE_WEIGHTED = 1,
+} volc_send_schedule_mode_e;
+
+/**
+ * @brief 定义队列满时的丢弃策略。
+ */
+typedef enum {
+    /**
+     * @brief 拒绝新的数据包，返回 VOLC_STATUS_SEND_QUEUE_FULL。
+     */
+    VOLC_SEND_DROP_NEWEST = 0,
+    /**
+     * @brief 丢弃队列中最旧的数据包，为新的数据包腾出空间，适用于实时媒体。
+     */
+    VOLC_SEND_DROP_OLDEST = 1,
+} volc_send_drop_policy_e;
+
+/**
+ * @brief 单个优先级队列的配置。
+ */
+typedef struct {
+    /**
+     * @brief 队列中最多缓存的数据包数量，0 表示不限制。
+     */
+    uint32_t max_packets;
+    /**
+     * @brief 队列中最多缓存的字节数，0 表示不限制。
+     */
+    uint32_t max_bytes;
+    /**
+     * @brief 数据包在队列中的最长等待时间，单位毫秒，超时的数据包会被丢弃，0 表示不过期。
+     */
+    uint32_t max_delay_ms;
+    /**
+     * @brief 加权调度时每轮可发送的字节配额。
+     */
+    uint32_t weight;
+    /**
+     * @brief 队列满时的丢弃策略。
+     */
+    volc_send_drop_policy_e drop_policy;
+} volc_send_queue_config_t;
+
+/**
+ * @brief 发送调度器配置。
+ */
+typedef struct {
+    /**
+     * @brief 队列之间的调度方式。
+     */
+    volc_send_schedule_mode_e mode;
+    /**
+     * @brief 每个优先级队列的配置，下标为 volc_send_priority_e。
+     */
+    volc_send_queue_config_t queues[VOLC_SEND_PRIORITY_COUNT];
+} volc_send_scheduler_config_t;
+
+/**
+ * @brief 发送调度器统计信息，下标为 volc_send_priority_e。
+ */
+typedef struct {
+    uint64_t sent_packets[VOLC_SEND_PRIORITY_COUNT];
+    uint64_t sent_bytes[VOLC_SEND_PRIORITY_COUNT];
+    uint64_t dropped_packets[VOLC_SEND_PRIORITY_COUNT];
+    uint32_t queued_packets[VOLC_SEND_PRIORITY_COUNT];
+    uint32_t queued_bytes[VOLC_SEND_PRIORITY_COUNT];
+} volc_send_scheduler_stats_t;
+
+/**
+ * @brief 获取默认的发送调度器配置。
+ *
+ * 默认使用严格优先级，音频和视频队列在满或超时时丢弃最旧的数据包，数据队列拒绝新的数据包。
+ *
+ * @param config 用于存储默认配置的结构体指针。
+ */
+__byte_rtc_api__ void volc_send_scheduler_get_default_config(volc_send_scheduler_config_t* config);
+
+/**
+ * @brief 为指定套接字创建发送调度器。
+ *
+ * @param sockfd 非阻塞套接字描述符，调度器不持有该套接字，销毁调度器时不会关闭它。
+ * @param config 调度器配置，为 NULL 时使用默认配置。
+ * @param p_scheduler 用于存储新创建的调度器句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_send_scheduler_create(int sockfd, const volc_send_scheduler_config_t* config, volc_send_scheduler_t* p_scheduler);
+
+/**
+ * @brief 销毁发送调度器，丢弃所有未发送的数据包。
+ *
+ * @param scheduler 要销毁的调度器句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_send_scheduler_destroy(volc_send_scheduler_t scheduler);
+
+/**
+ * @brief 通过调度器发送一个数据包。
+ *
+ * 所有队列为空时直接调用 volc_send_msg 发送；发送缓冲区已满或有更早的数据包在排队时，
+ * 会拷贝数据并放入对应优先级的队列，等待 POLLOUT 时发送。部分写入的数据包的剩余部分总是入队，
+ * 不受队列上限和丢弃策略限制，以免破坏流式套接字上的数据。
+ *
+ * @param scheduler 调度器句柄。
+ * @param priority 数据包的优先级。
+ * @param data 要发送的数据。
+ * @param size 要发送的数据长度。
+ * @param addr 目标地址，已连接的套接字（如 TCP）传 NULL。
+ * @return 操作结果的状态码：<br>
+ *         - VOLC_STATUS_SUCCESS: 已发送或已入队 <br>
+ *         - VOLC_STATUS_SEND_QUEUE_FULL: 队列已满且丢弃策略为 VOLC_SEND_DROP_NEWEST <br>
+ *         - VOLC_STATUS_MESSAGE_TOO_BIG: 数据包超过路径 MTU，已排队的此类数据包会被直接丢弃 <br>
+ *         - VOLC_STATUS_EVLOOP_PERFORM_FAILED: 套接字发送失败
+ */
+__byte_rtc_api__ uint32_t volc_send_scheduler_send(volc_send_scheduler_t scheduler, volc_send_priority_e priority, const void* data, size_t size, const volc_ip_addr_t* addr);
+
+/**
+ * @brief 尽可能多地发送队列中的数据包。
+ *
+ * @param scheduler 调度器句柄。
+ * @return 操作结果的状态码：<br>
+ *         - VOLC_STATUS_SUCCESS: 队列已清空 <br>
+ *         - VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY: 发送缓冲区再次变满，需要等待 POLLOUT <br>
+ *         - VOLC_STATUS_EVLOOP_PERFORM_FAILED: 套接字发送失败
+ */
+__byte_rtc_api__ uint32_t volc_send_scheduler_drain(volc_send_scheduler_t scheduler);
+
+/**
+ * @brief 获取调度器需要监听的事件。
+ *
+ * 队列非空时返回 VOLC_EVLOOP_POLLOUT，事件循环应将其加入 volc_pollfd 的 events 中。
+ *
+ * @param scheduler 调度器句柄。
+ * @return 需要监听的事件掩码，0 表示无需监听可写事件。
+ */
+__byte_rtc_api__ short volc_send_scheduler_get_poll_events(volc_send_scheduler_t scheduler);
+
+/**
+ * @brief 处理 volc_poll 返回的事件。
+ *
+ * revents 中包含 VOLC_EVLOOP_POLLOUT 时自动调用 volc_send_scheduler_drain。
+ *
+ * @param scheduler 调度器句柄。
+ * @param revents volc_poll 返回的事件掩码。
+ * @return 操作结果的状态码，同 volc_send_scheduler_drain。
+ */
+__byte_rtc_api__ uint32_t volc_send_scheduler_on_poll_event(volc_send_scheduler_t scheduler, short revents);
+
+/**
+ * @brief 获取调度器的统计信息。
+ *
+ * @param scheduler 调度器句柄。
+ * @param stats 用于存储统计信息的结构体指针。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_send_scheduler_get_stats(volc_send_scheduler_t scheduler, volc_send_scheduler_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __HAL_VOLC_SEND_SCHEDULER_H__ */
@@ -50,6 +50,47 @@ typedef enum {
     VOLC_SOCK_DGRAM  = 2,		
 } volc_socket_type_e;
 
+/**
+ * @brief 定义路径 MTU 探测模式，用于控制 UDP 数据包的 DF（Don't Fragment）标志。
+ */
+typedef enum {
+    /**
+     * @brief 不设置 DF 标志，超过路径 MTU 的数据包由协议栈分片。
+     */
+    VOLC_PMTU_DISCOVER_DONT  = 0,
+    /**
+     * @brief 系统默认行为，按路径 MTU 缓存决定是否设置 DF 标志。
+     */
+    VOLC_PMTU_DISCOVER_WANT  = 1,
+    /**
+     * @brief 始终设置 DF 标志，超过路径 MTU 的数据包发送失败并返回 VOLC_STATUS_MESSAGE_TOO_BIG。
+     */
+    VOLC_PMTU_DISCOVER_DO    = 2,
+    /**
+     * @brief 设置 DF 标志但忽略路径 MTU 缓存，用于发送大于当前路径 MTU 的探测包。
+     */
+    VOLC_PMTU_DISCOVER_PROBE = 3,
+} volc_pmtu_discover_mode_e;
+
+/**
+ * @brief 内核 TLS（kTLS）支持的加密算法。
+ */
+typedef enum {
+    VOLC_KTLS_CIPHER_AES_128_GCM = 1,
+    VOLC_KTLS_CIPHER_AES_256_GCM = 2,
+} volc_ktls_cipher_e;
+
+/**
+ * @brief 一个方向的 TLS 1.2 记录层密钥，用于 `volc_sockopt_set_ktls`。
+ */
+typedef struct {
+    volc_ktls_cipher_e cipher;
+    uint8_t key[32];     /* 写密钥，AES-128-GCM 只使用前 16 字节 */
+    uint8_t salt[4];     /* 隐式 nonce，即密钥块中的 write IV */
+    uint8_t iv[8];       /* 下一条记录的显式 nonce */
+    uint8_t rec_seq[8];  /* 下一条记录的序列号，网络字节序 */
+} volc_ktls_crypto_info_t;
+
 struct volc_pollfd {
     int   fd;         /* file descriptor */
     short events;     /* requested events */
@@ -119,6 +160,61 @@ int volc_accept(int sockfd, volc_ip_addr_t* addr, int* addrlen);
  */
 int volc_connect(int sockfd, volc_ip_addr_t* addr);
 
+/**
+ * @brief 检查非阻塞连接是否完成
+ * 
+ * `volc_connect` 返回 VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY 后，事件循环在套接字可写（POLLOUT/POLLERR）
+ * 或定时器到期时调用此函数获取连接结果，截止时间由调用者统一管理。
+ * 
+ * @param sockfd 正在连接的套接字描述符。
+ * @param deadline_ms 连接截止时间，为 `volc_get_montionic_time_ms` 的绝对时间，VOLC_INFINITE_TIME_VALUE 表示不超时。
+ * @return uint32_t 连接结果：<br>
+ *         - VOLC_STATUS_SUCCESS: 连接已建立 <br>
+ *         - VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY: 连接仍在进行中 <br>
+ *         - VOLC_STATUS_OPERATION_TIMED_OUT: 超过截止时间仍未建立连接 <br>
+ *         - VOLC_STATUS_SOCKET_CONNECT_FAILED: 连接失败
+ */
+uint32_t volc_connect_check(int sockfd, uint64_t deadline_ms);
+
+/**
+ * @brief 在超时时间内建立连接
+ * 
+ * 发起非阻塞连接，并使用 `volc_poll` 等待连接完成，最多等待 `timeout_ms` 毫秒。
+ * 
+ * @param sockfd 非阻塞套接字描述符。
+ * @param addr 远程地址。
+ * @param timeout_ms 超时时间，单位毫秒。
+ * @return uint32_t 连接结果，同 `volc_connect_check`。
+ */
+uint32_t volc_connect_with_timeout(int sockfd, volc_ip_addr_t* addr, uint32_t timeout_ms);
+
+/**
+ * @brief 设置 TCP Fast Open 连接模式
+ * 
+ * 对应 TCP_FASTOPEN_CONNECT。启用后 `volc_connect` 不会立即发送 SYN，而是在第一次写入数据时
+ * 将数据（例如 TLS ClientHello）放在 SYN 中一起发送，有 Fast Open cookie 时可节省一个 RTT。
+ * 
+ * @param sockfd TCP 套接字描述符，必须在 `volc_connect` 之前调用。
+ * @param enable 是否启用。
+ * @return uint32_t 操作结果的状态码，平台不支持时返回 VOLC_STATUS_NOT_IMPLEMENTED。
+ */
+uint32_t volc_sockopt_set_fast_open_connect(int sockfd, bool enable);
+
+/**
+ * @brief 使用 TCP Fast Open 发起连接，并在 SYN 中携带数据
+ * 
+ * 对应 MSG_FASTOPEN。没有 Fast Open cookie 或平台不支持时退化为普通连接，此时 `p_sent` 为 0，
+ * 调用者需要在连接建立后重新发送数据。
+ * 
+ * @param sockfd 非阻塞 TCP 套接字描述符。
+ * @param addr 远程地址。
+ * @param data 随 SYN 发送的数据。
+ * @param size 数据长度。
+ * @param p_sent 用于存储已随 SYN 发送的字节数。
+ * @return uint32_t 操作结果，同 `volc_connect`。
+ */
+uint32_t volc_connect_fast_open(int sockfd, volc_ip_addr_t* addr, const void* data, size_t size, size_t* p_sent);
+
 /**
  * @brief 从指定套接字接收消息
  * 
@@ -145,8 +241,9 @@ ssize_t volc_recv_msg(int sockfd, void* data, size_t size, volc_ip_addr_t *p_add
  * @param sockfd 用于发送消息的套接字描述符。
  * @param data 指向要发送的数据的缓冲区的指针。
  * @param size 要发送的数据的字节数。
- * @param addr 指向 `struct sockaddr_in` 结构体的指针，包含目标地址信息。
- * @param p_status 发送状态，可用于设置特定的发送条件或标志。
+ * @param addr 目标地址，为 NULL 时在已连接的套接字上发送。
+ * @param p_status 发送状态：VOLC_STATUS_SUCCESS 表示成功，VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY 表示发送缓冲区已满，
+ *                 VOLC_STATUS_MESSAGE_TOO_BIG 表示数据包超过路径 MTU 且设置了 DF 标志，其他值表示失败。
  * @return ssize_t 如果成功，返回实际发送的字节数；如果发生错误，返回 -1。
  */
 ssize_t volc_send_msg(int sockfd, void* data, size_t size, volc_ip_addr_t* addr, uint32_t* p_status);
@@ -186,8 +283,110 @@ int volc_sockopt_set_buffer_size(int __fd, bool _is_send_buffer,int buffer_size)
  
 int volc_sockopt_get_buffer_size(int __fd, bool _is_send_buffer) ;
 
+/**
+ * @brief 设置套接字的路径 MTU 探测模式
+ * 
+ * 对应 IP_MTU_DISCOVER / IPV6_MTU_DISCOVER，设置为 VOLC_PMTU_DISCOVER_DO 或 VOLC_PMTU_DISCOVER_PROBE 后，
+ * 超过路径 MTU 的数据包不会被分片，`volc_send_msg` 会在 `p_status` 中返回 VOLC_STATUS_MESSAGE_TOO_BIG。
+ * 
+ * @param sockfd UDP 套接字描述符。
+ * @param mode 路径 MTU 探测模式。
+ * @return uint32_t 操作结果的状态码，平台不支持时返回 VOLC_STATUS_NOT_IMPLEMENTED。
+ */
+uint32_t volc_sockopt_set_pmtu_discover(int sockfd, volc_pmtu_discover_mode_e mode);
+
+/**
+ * @brief 获取已连接套接字当前的路径 MTU
+ * 
+ * 对应 IP_MTU / IPV6_MTU，只对调用过 `volc_connect` 的套接字有效。
+ * 
+ * @param sockfd 已连接的套接字描述符。
+ * @param p_mtu 用于存储路径 MTU 的指针，单位字节，包含 IP 头。
+ * @return uint32_t 操作结果的状态码，平台不支持时返回 VOLC_STATUS_NOT_IMPLEMENTED。
+ */
+uint32_t volc_sockopt_get_path_mtu(int sockfd, uint32_t* p_mtu);
+
+/**
+ * @brief 获取已连接 UDP 套接字在不分片前提下的最大载荷
+ * 
+ * 由当前路径 MTU 减去 IP 头和 UDP 头得到，打包器可以据此选择数据包大小。
+ * 
+ * @param sockfd 已连接的 UDP 套接字描述符。
+ * @param p_payload 用于存储最大载荷的指针，单位字节。
+ * @return uint32_t 操作结果的状态码，平台不支持时返回 VOLC_STATUS_NOT_IMPLEMENTED。
+ */
+uint32_t volc_get_max_udp_payload(int sockfd, uint32_t* p_payload);
+
+/**
+ * @brief 将已完成 TLS 握手的 TCP 连接的记录层加解密交给内核
+ * 
+ * 对应 TCP_ULP "tls" 与 SOL_TLS 的 TLS_RX / TLS_TX。成功后套接字上收发的都是明文，
+ * 接收需使用 `volc_ktls_recv` 以识别告警记录。先设置接收方向，接收方向不可用时套接字保持原样，可继续在用户态加解密。
+ * 
+ * @param sockfd 已连接的 TCP 套接字描述符，调用前用户态 TLS 不能有未处理的已接收数据。
+ * @param tx 发送方向的密钥。
+ * @param rx 接收方向的密钥。
+ * @return uint32_t 操作结果的状态码：<br>
+ *         - VOLC_STATUS_SUCCESS: 收发均已由内核处理 <br>
+ *         - VOLC_STATUS_NOT_IMPLEMENTED: 平台或内核不支持，套接字未被修改 <br>
+ *         - VOLC_STATUS_SET_SOCKET_FLAG_FAILED: 接收方向已交给内核而发送方向失败，连接已不可用
+ */
+uint32_t volc_sockopt_set_ktls(int sockfd, const volc_ktls_crypto_info_t* tx, const volc_ktls_crypto_info_t* rx);
+
+/**
+ * @brief 从启用 kTLS 的套接字接收应用数据
+ * 
+ * @param sockfd 启用 kTLS 的套接字描述符。
+ * @param data 接收缓冲区。
+ * @param size 缓冲区长度。
+ * @param p_status 接收状态：VOLC_STATUS_SUCCESS 表示成功（返回 0 表示对端关闭或收到 close_notify），
+ *                 VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY 表示暂无数据，VOLC_STATUS_SSL_CONNECTION_FAILED 表示收到告警或非应用数据记录，其他值表示失败。
+ * @return ssize_t 接收到的字节数，失败返回 -1。
+ */
+ssize_t volc_ktls_recv(int sockfd, void* data, size_t size, uint32_t* p_status);
+
+/**
+ * @brief 向已连接的流式套接字发送数据
+ * 
+ * @param sockfd 已连接的套接字描述符，启用 kTLS 后数据由内核加密。
+ * @param data 要发送的数据。
+ * @param size 数据长度。
+ * @param p_status 发送状态：VOLC_STATUS_SUCCESS 表示成功，VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY 表示发送缓冲区已满，其他值表示失败。
+ * @return ssize_t 实际发送的字节数，失败返回 -1。
+ */
+ssize_t volc_ktls_send(int sockfd, const void* data, size_t size, uint32_t* p_status);
+
+/**
+ * @brief 在内核中将文件内容直接发送到套接字
+ * 
+ * 对应 sendfile，数据不经过用户态。与 kTLS 结合时由内核完成加密，可用于零拷贝上传日志包等文件。
+ * 
+ * @param sockfd 已连接的套接字描述符。
+ * @param file_fd 打开的文件描述符。
+ * @param offset 文件内的起始偏移。
+ * @param count 最多发送的字节数。
+ * @param p_status 发送状态：VOLC_STATUS_SUCCESS 表示成功，VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY 表示发送缓冲区已满，
+ *                 VOLC_STATUS_NOT_IMPLEMENTED 表示平台不支持，其他值表示失败。
+ * @return ssize_t 实际发送的字节数，失败返回 -1。
+ */
+ssize_t volc_sendfile(int sockfd, int file_fd, int64_t offset, size_t count, uint32_t* p_status);
+
 int volc_getaddrinfo(const char* host, uint16_t port, volc_ip_addr_t** addrs, int* count);
 
+/**
+ * @brief 按协议族解析主机名
+ * 
+ * 与 `volc_getaddrinfo` 相同，但只查询指定协议族的地址，可用于分别并行查询 A 和 AAAA 记录。
+ * 
+ * @param host 主机名或 IP 地址字符串。
+ * @param port 端口号，主机字节序。
+ * @param family VOLC_IP_FAMILY_TYPE_IPV4 只查询 A 记录，VOLC_IP_FAMILY_TYPE_IPV6 只查询 AAAA 记录，0 表示不限制。
+ * @param addrs 用于存储地址列表，使用 `volc_freeaddrinfo` 释放。
+ * @param count 用于存储地址数量。
+ * @return int 成功返回 0，失败返回非 0。
+ */
+int volc_getaddrinfo_with_family(const char* host, uint16_t port, uint16_t family, volc_ip_addr_t** addrs, int* count);
+
 int volc_freeaddrinfo(volc_ip_addr_t* addrs);
 
 int volc_poll(struct volc_pollfd *fds, int nfds, int timeout);
@@ -0,0 +1,196 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef __HAL_VOLC_SRTP_H__
+#define __HAL_VOLC_SRTP_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "volc_crypto.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_MSC_VER)
+#if defined(__BUILDING_BYTE_RTC_SDK__)
+#define __byte_rtc_api__ __declspec(dllexport)
+#else
+#define __byte_rtc_api__ __declspec(dllimport)
+#endif
+#else
+#define __byte_rtc_api__ __attribute__((visibility("default")))
+#endif
+
+/**
+ * @brief 加密后数据包最多增加的字节数（AES-GCM 的 SRTCP：16 字节认证标签 + 4 字节索引），调用者应按此预留缓冲区。
+ */
+#define VOLC_SRTP_MAX_TRAILER_LENGTH 20
+
+/**
+ * @brief 每个会话默认最多跟踪的 SSRC 数量。
+ */
+#define VOLC_SRTP_DEFAULT_MAX_STREAMS 16
+
+/**
+ * @brief SRTP 会话句柄
+ *
+ * 会话按 RFC 3711 从主密钥派生 SRTP/SRTCP 会话密钥，创建时完成 AES 密钥扩展和 HMAC 内外填充的预计算，
+ * 每个数据包的加解密都在调用者的缓冲区中原地进行，不分配内存。
+ * AEAD AES-GCM 配置文件使用 mbedtls 的 GCM 实现，CPU 支持时在运行时自动选用 AES-NI 和 PCLMULQDQ（ARMv8 为 AES/PMULL 指令）。
+ * 每个方向使用一个会话：发送方向只调用 protect，接收方向只调用 unprotect。会话不是线程安全的。
+ */
+typedef void* volc_srtp_session_t;
+
+/**
+ * @brief SRTP 会话参数。
+ */
+typedef struct {
+    /**
+     * @brief SRTP 配置文件。
+     */
+    volc_srtp_profile_t profile;
+    /**
+     * @brief 主密钥，AES-CM 和 AES-128-GCM 配置文件为 16 字节，AES-256-GCM 配置文件为 32 字节。
+     */
+    const uint8_t* master_key;
+    uint32_t master_key_length;
+    /**
+     * @brief 主盐，AES-CM 配置文件为 14 字节，AES-GCM 配置文件为 12 字节。
+     */
+    const uint8_t* master_salt;
+    uint32_t master_salt_length;
+    /**
+     * @brief 最多跟踪的 SSRC 数量，为 0 时使用 VOLC_SRTP_DEFAULT_MAX_STREAMS。每个 SSRC 独立维护 ROC、序列号和重放窗口。
+     */
+    uint32_t max_streams;
+} volc_srtp_policy_t;
+
+/**
+ * @brief 创建 SRTP 会话。
+ *
+ * @param policy 会话参数，密钥内容在函数返回后即可清除。
+ * @param p_session 用于存储新创建的会话句柄。
+ * @return 操作结果的状态码，0 表示成功；不支持的配置文件返回 VOLC_STATUS_SSL_UNKNOWN_SRTP_PROFILE，密钥长度不符返回 VOLC_STATUS_INVALID_ARG_LEN。
+ */
+__byte_rtc_api__ uint32_t volc_srtp_session_create(const volc_srtp_policy_t* policy, volc_srtp_session_t* p_session);
+
+/**
+ * @brief 使用 DTLS-SRTP 协商得到的密钥材料创建 SRTP 会话。
+ *
+ * @param material `volc_tls_export_srtp_keying_material` 导出的密钥材料。
+ * @param outbound 为 true 时使用本端密钥（发送方向），否则使用对端密钥（接收方向）。
+ * @param p_session 用于存储新创建的会话句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_srtp_session_create_from_keying_material(const volc_srtp_keying_material_t* material, bool outbound, volc_srtp_session_t* p_session);
+
+/**
+ * @brief 销毁 SRTP 会话并清除会话密钥。
+ *
+ * @param session 会话句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_srtp_session_destroy(volc_srtp_session_t session);
+
+/**
+ * @brief 原地加密 RTP 数据包并追加认证标签。
+ *
+ * @param session 会话句柄。
+ * @param packet RTP 数据包，加密结果写回同一缓冲区。
+ * @param p_len 输入为 RTP 数据包长度，输出为 SRTP 数据包长度。
+ * @param capacity packet 缓冲区的总大小，至少为 RTP 长度加 VOLC_SRTP_MAX_TRAILER_LENGTH。
+ * @return 操作结果的状态码，0 表示成功；缓冲区不足返回 VOLC_STATUS_BUFFER_TOO_SMALL，
+ *         新的 SSRC 超过 max_streams 时返回 VOLC_STATUS_SRTP_TOO_MANY_STREAMS。
+ */
+__byte_rtc_api__ uint32_t volc_srtp_protect(volc_srtp_session_t session, uint8_t* packet, uint32_t* p_len, uint32_t capacity);
+
+/**
+ * @brief 原地校验并解密 SRTP 数据包。
+ *
+ * 认证失败或命中重放窗口（64 个数据包）的数据包不会改变会话状态。AES-CM 配置文件认证失败时数据包保持原样，
+ * AES-GCM 配置文件的认证与解密在同一遍中完成，认证失败时负载被清零，应直接丢弃。
+ *
+ * @param session 会话句柄。
+ * @param packet SRTP 数据包，解密结果写回同一缓冲区。
+ * @param p_len 输入为 SRTP 数据包长度，输出为 RTP 数据包长度。
+ * @return 操作结果的状态码，0 表示成功；认证失败返回 VOLC_STATUS_SRTP_AUTHENTICATION_FAILED，
+ *         重放或过旧的数据包返回 VOLC_STATUS_SRTP_REPLAYED_PACKET，格式错误返回 VOLC_STATUS_SRTP_INVALID_PACKET。
+ */
+__byte_rtc_api__ uint32_t volc_srtp_unprotect(volc_srtp_session_t session, uint8_t* packet, uint32_t* p_len);
+
+/**
+ * @brief 批量加解密中的一个数据包。
+ */
+typedef struct {
+    /**
+     * @brief 数据包缓冲区，结果原地写回。
+     */
+    uint8_t* packet;
+    /**
+     * @brief 输入为数据包长度，成功时更新为处理后的长度。
+     */
+    uint32_t len;
+    /**
+     * @brief packet 缓冲区的总大小，仅 `volc_srtp_protect_batch` 使用。
+     */
+    uint32_t capacity;
+    /**
+     * @brief 该数据包的处理结果，与对它单独调用 `volc_srtp_protect` 或 `volc_srtp_unprotect` 的返回值相同。
+     */
+    uint32_t status;
+} volc_srtp_packet_t;
+
+/**
+ * @brief 批量原地加密多个 RTP 数据包，结果与按数组顺序逐个调用 `volc_srtp_protect` 相同。
+ *
+ * AES-CM 配置文件下，多个数据包的 AES-CTR 计数器块交错送入 AES-NI 流水线，HMAC-SHA1 在 CPU 支持时由 AVX2 的 8 个通道同时计算，
+ * 适合一次收发多个数据包（如 sendmmsg/recvmmsg）的场景。AES-GCM 配置文件逐个处理。
+ *
+ * @param session 会话句柄。
+ * @param packets 数据包数组，每个数据包的结果写入其 status。
+ * @param count 数据包数量。
+ * @return 操作结果的状态码，0 表示调用成功，单个数据包的失败只记录在其 status 中；参数为空时返回 VOLC_STATUS_NULL_ARG，此时不处理任何数据包。
+ */
+__byte_rtc_api__ uint32_t volc_srtp_protect_batch(volc_srtp_session_t session, volc_srtp_packet_t* packets, uint32_t count);
+
+/**
+ * @brief 批量原地校验并解密多个 SRTP 数据包，结果与按数组顺序逐个调用 `volc_srtp_unprotect` 相同。
+ *
+ * 重放检查和会话状态更新仍按数组顺序进行，批量计算的只有认证标签和解密。
+ *
+ * @param session 会话句柄。
+ * @param packets 数据包数组，每个数据包的结果写入其 status，capacity 不使用。
+ * @param count 数据包数量。
+ * @return 操作结果的状态码，与 `volc_srtp_protect_batch` 相同。
+ */
+__byte_rtc_api__ uint32_t volc_srtp_unprotect_batch(volc_srtp_session_t session, volc_srtp_packet_t* packets, uint32_t count);
+
+/**
+ * @brief 原地加密 RTCP 复合包并追加 SRTCP 索引和认证标签。
+ *
+ * @param session 会话句柄。
+ * @param packet RTCP 数据包，加密结果写回同一缓冲区。
+ * @param p_len 输入为 RTCP 数据包长度，输出为 SRTCP 数据包长度。
+ * @param capacity packet 缓冲区的总大小，至少为 RTCP 长度加 VOLC_SRTP_MAX_TRAILER_LENGTH。
+ * @return 操作结果的状态码，0 表示成功；SRTCP 索引用尽（2^31 个数据包）时返回 VOLC_STATUS_SRTP_KEY_EXHAUSTED，应重新协商密钥。
+ */
+__byte_rtc_api__ uint32_t volc_srtp_protect_rtcp(volc_srtp_session_t session, uint8_t* packet, uint32_t* p_len, uint32_t capacity);
+
+/**
+ * @brief 原地校验并解密 SRTCP 数据包。
+ *
+ * @param session 会话句柄。
+ * @param packet SRTCP 数据包，解密结果写回同一缓冲区。
+ * @param p_len 输入为 SRTCP 数据包长度，输出为 RTCP 数据包长度。
+ * @return 操作结果的状态码，与 `volc_srtp_unprotect` 相同。
+ */
+__byte_rtc_api__ uint32_t volc_srtp_unprotect_rtcp(volc_srtp_session_t session, uint8_t* packet, uint32_t* p_len);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __HAL_VOLC_SRTP_H__ */
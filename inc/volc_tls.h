@@ -10,6 +10,9 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "volc_crypto.h"
+#include "volc_worker_pool.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -29,6 +32,11 @@ extern "C" {
 #define VOLC_MBEDTLS_ERR_SSL_WANT_READ -0x6900
 #define VOLC_MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY -0x7880
 
+/**
+ * @brief 主机名的最大长度，超过该长度的主机名不参与会话缓存。
+ */
+#define VOLC_TLS_MAX_HOST_NAME_LENGTH 255
+
 /**
  * @brief TLS句柄
  * 
@@ -36,6 +44,80 @@ extern "C" {
  */
 typedef void* volc_tls_t;
 
+/**
+ * @brief TLS 共享配置句柄
+ *
+ * 包含客户端和服务端的 mbedtls 配置、线程安全的随机数生成器以及 CA 证书链，可被多个 TLS 连接共享，
+ * 避免每个连接重复初始化配置和采集熵。配置在被连接使用后不应再修改。
+ */
+typedef void* volc_tls_config_t;
+
+/**
+ * @brief TLS 协议版本。
+ */
+typedef enum {
+    VOLC_TLS_VERSION_1_2 = 0x0303,
+    VOLC_TLS_VERSION_1_3 = 0x0304,
+} volc_tls_version_e;
+
+/**
+ * @brief 0-RTT 早期数据的发送结果。
+ */
+typedef enum {
+    VOLC_TLS_EARLY_DATA_NOT_SENT = 0, /* 未发送：没有可复用的 TLS 1.3 会话、未排队数据或握手未完成 */
+    VOLC_TLS_EARLY_DATA_ACCEPTED = 1, /* 服务端已接受 */
+    VOLC_TLS_EARLY_DATA_REJECTED = 2, /* 服务端已拒绝，调用者需在握手完成后通过 `volc_tls_write` 重发 */
+} volc_tls_early_data_status_e;
+
+/**
+ * @brief 创建 TLS 连接的选项，使用 `volc_tls_get_default_options` 初始化。
+ */
+typedef struct {
+    /**
+     * @brief 共享配置，为 NULL 时使用进程内默认配置。
+     */
+    volc_tls_config_t config;
+    /**
+     * @brief 客户端请求的最大分片长度（RFC 6066），可选 0（不限制）、512、1024、2048、4096。
+     *
+     * 服务端同意后双方的记录不超过该长度，握手完成后收发缓冲区随之缩小。config 不为 NULL 时必须为 0
+     * 或与 `volc_tls_config_set_max_fragment_length` 的设置一致。
+     */
+    uint32_t max_fragment_length;
+    /**
+     * @brief 写合并缓冲区大小，0 表示不合并，见 `volc_tls_set_write_coalescing`。
+     */
+    uint32_t write_coalescing_size;
+    /**
+     * @brief 写合并数据的最长等待时间，单位毫秒。
+     */
+    uint32_t write_coalescing_delay_ms;
+    /**
+     * @brief 是否启用动态记录大小，见 `volc_tls_set_dynamic_record_sizing`。
+     */
+    bool dynamic_record_sizing;
+} volc_tls_options_t;
+
+/**
+ * @brief TLS 连接的内存占用，单位字节。
+ */
+typedef struct {
+    size_t context_size;          /* 连接上下文本身 */
+    size_t in_buffer_size;        /* mbedtls 接收记录缓冲区 */
+    size_t out_buffer_size;       /* mbedtls 发送记录缓冲区 */
+    size_t coalesce_buffer_size;  /* 写合并缓冲区 */
+    size_t early_data_size;       /* 排队的 0-RTT 早期数据 */
+    size_t total_size;            /* 以上之和 */
+    bool handshake_in_progress;   /* 握手进行中时 mbedtls 另有握手状态和对端证书链等内存未计入 */
+} volc_tls_memory_report_t;
+
+/**
+ * @brief 异步私钥运算完成回调，收到后应再次调用 `volc_tls_handshake_step`。
+ *
+ * @param custom_data `volc_tls_set_async_ready_callback` 设置的用户数据。
+ */
+typedef void (*volc_tls_async_ready_callback)(void* custom_data);
+
 /**
  * @brief 定义 TLS 发送回调函数类型。
  * 
@@ -70,6 +152,17 @@ typedef int32_t (*volc_tls_recv_callback)(void* custom_data, unsigned char* buf,
  */
 __byte_rtc_api__ uint32_t volc_tls_create(volc_tls_t* tls);
 
+/**
+ * @brief 使用共享配置创建 TLS 句柄。
+ *
+ * TLS 句柄持有配置的引用，配置在所有引用它的句柄销毁后才会释放。
+ *
+ * @param config 共享配置句柄。
+ * @param tls 用于存储新创建的 TLS 句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_create_with_config(volc_tls_config_t config, volc_tls_t* tls);
+
 /**
  * @brief 销毁一个 TLS 上下文。
  * 
@@ -95,6 +188,99 @@ __byte_rtc_api__ uint32_t volc_tls_destroy(volc_tls_t tls);
  */
 __byte_rtc_api__ int volc_tls_start(volc_tls_t tls, bool is_server, const char* host, volc_tls_send_callback send_callback, volc_tls_recv_callback recv_callback, void* custom_data);
 
+/**
+ * @brief 以 DTLS 模式启动握手。
+ *
+ * 使用数据报传输，协商 use_srtp 扩展，不使用 HelloVerifyRequest（由 ICE 保证地址有效），并要求对端提供证书，
+ * 证书指纹由调用者通过 `volc_tls_get_peer_certificate` 校验。握手的后续推进与 TLS 模式相同，使用 `volc_tls_handshake_step`；
+ * 重传定时器由事件循环驱动：以 `volc_tls_get_timeout_ms` 作为 volc_poll 的超时时间，超时后调用 `volc_tls_handshake_step` 触发重传。
+ *
+ * @param tls TLS 句柄。
+ * @param is_server 是否为服务端。
+ * @param mtu 路径 MTU 允许的最大数据报长度，握手消息会按此分片，0 表示使用 mbedtls 默认值，可通过 `volc_get_max_udp_payload` 获取。
+ * @param send_callback 发送一个数据报的回调函数。
+ * @param recv_callback 接收一个数据报的回调函数，无数据时应返回 VOLC_MBEDTLS_ERR_SSL_WANT_READ。
+ * @param custom_data 传递给回调函数的用户数据。
+ * @return 与 `volc_tls_start` 相同，0 表示握手已完成，负数为 mbedtls 错误码。
+ */
+__byte_rtc_api__ int volc_tls_start_dtls(volc_tls_t tls, bool is_server, uint16_t mtu, volc_tls_send_callback send_callback, volc_tls_recv_callback recv_callback, void* custom_data);
+
+/**
+ * @brief 获取 DTLS 重传定时器的剩余时间。
+ *
+ * @param tls TLS 句柄。
+ * @return 距离下一次重传的毫秒数，0 表示已到期；没有运行中的定时器或非 DTLS 模式时返回 VOLC_INFINITE_TIME_VALUE。
+ */
+__byte_rtc_api__ uint64_t volc_tls_get_timeout_ms(volc_tls_t tls);
+
+/**
+ * @brief 导出 DTLS-SRTP 密钥材料（RFC 5764）。
+ *
+ * 使用标签 VOLC_KEYING_EXTRACTOR_LABEL 从 DTLS 主密钥派生 SRTP 主密钥和主盐，并按本端角色区分发送和接收方向。
+ *
+ * @param tls 已完成 DTLS 握手的 TLS 句柄。
+ * @param p_material 用于存储密钥材料。
+ * @return 操作结果的状态码：<br>
+ *         - VOLC_STATUS_SUCCESS: 导出成功 <br>
+ *         - VOLC_STATUS_SSL_PACKET_BEFORE_DTLS_READY: DTLS 握手尚未完成 <br>
+ *         - VOLC_STATUS_SSL_UNKNOWN_SRTP_PROFILE: 未协商出支持的 SRTP 配置文件
+ */
+__byte_rtc_api__ uint32_t volc_tls_export_srtp_keying_material(volc_tls_t tls, volc_srtp_keying_material_t* p_material);
+
+/**
+ * @brief 获取对端证书。
+ *
+ * @param tls 已完成握手的 TLS 句柄。
+ * @param p_der 用于存储 DER 格式证书的指针，在 TLS 句柄销毁或重新启动前有效。
+ * @param p_len 用于存储证书长度。
+ * @return 操作结果的状态码，对端未提供证书时返回 VOLC_STATUS_NOT_FOUND。
+ */
+__byte_rtc_api__ uint32_t volc_tls_get_peer_certificate(volc_tls_t tls, const uint8_t** p_der, size_t* p_len);
+
+/**
+ * @brief 推进一次非阻塞握手。
+ *
+ * 在 `volc_tls_start` 之后，事件循环在套接字就绪时反复调用本函数，直到握手完成或失败；
+ * 发送和接收回调在没有数据可读或无法写入时应返回 VOLC_MBEDTLS_ERR_SSL_WANT_READ / VOLC_MBEDTLS_ERR_SSL_WANT_WRITE。
+ *
+ * @param tls TLS 句柄。
+ * @param p_events 用于存储继续握手前需要等待的事件（VOLC_EVLOOP_POLLIN 或 VOLC_EVLOOP_POLLOUT），
+ *                 为 0 表示正在等待异步操作（例如异步私钥运算）完成，无需等待套接字事件。
+ * @return 操作结果的状态码：<br>
+ *         - VOLC_STATUS_SUCCESS: 握手已完成 <br>
+ *         - VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY: 握手尚未完成，等待 p_events 后再次调用 <br>
+ *         - VOLC_STATUS_SSL_CONNECTION_FAILED: 握手失败 <br>
+ *         - VOLC_STATUS_INVALID_OPERATION: 尚未调用 `volc_tls_start`
+ */
+__byte_rtc_api__ uint32_t volc_tls_handshake_step(volc_tls_t tls, short* p_events);
+
+/**
+ * @brief 更换已开始的 TLS 连接的发送和接收回调，连接状态和已缓存的记录保持不变。
+ *
+ * 用于接管在其他地方完成握手的连接，例如 `volc_tls_preconnect_take` 取出的预连接。
+ *
+ * @param tls TLS 句柄。
+ * @param send_callback 发送数据的回调函数。
+ * @param recv_callback 接收数据的回调函数。
+ * @param custom_data 用户自定义的数据，将传递给回调函数。
+ * @return 操作结果的状态码，0 表示成功；尚未调用 `volc_tls_start` 时返回 VOLC_STATUS_INVALID_OPERATION。
+ */
+__byte_rtc_api__ uint32_t volc_tls_set_transport(volc_tls_t tls, volc_tls_send_callback send_callback, volc_tls_recv_callback recv_callback, void* custom_data);
+
+/**
+ * @brief 基于非阻塞 TCP 套接字的发送回调，custom_data 为 (void*)(intptr_t)sockfd。
+ *
+ * 套接字发送缓冲区已满时返回 VOLC_MBEDTLS_ERR_SSL_WANT_WRITE。
+ */
+__byte_rtc_api__ int32_t volc_tls_socket_send(void* custom_data, const unsigned char* buf, unsigned long len);
+
+/**
+ * @brief 基于非阻塞 TCP 套接字的接收回调，custom_data 为 (void*)(intptr_t)sockfd。
+ *
+ * 没有数据可读时返回 VOLC_MBEDTLS_ERR_SSL_WANT_READ。
+ */
+__byte_rtc_api__ int32_t volc_tls_socket_recv(void* custom_data, unsigned char* buf, unsigned long len);
+
 /**
  * @brief 从 TLS 会话中读取数据。
  * 
@@ -139,6 +325,298 @@ __byte_rtc_api__ bool volc_tls_is_handshake_over(volc_tls_t tls);
  */
 __byte_rtc_api__ size_t volc_tls_get_bytes_avail(volc_tls_t tls);
 
+/**
+ * @brief 获取默认的 TLS 连接选项。
+ *
+ * @param options 用于存储默认选项的结构体指针。
+ */
+__byte_rtc_api__ void volc_tls_get_default_options(volc_tls_options_t* options);
+
+/**
+ * @brief 按选项创建 TLS 上下文。
+ *
+ * 相同 max_fragment_length 的连接共享同一份进程内默认配置，可用于大量空闲信令连接或 ESP32 等内存受限的场景，
+ * 以单条记录的最大长度换取连接密度。
+ *
+ * @param options 创建选项。
+ * @param tls 用于存储新创建的 TLS 句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_create_ex(const volc_tls_options_t* options, volc_tls_t* tls);
+
+/**
+ * @brief 获取 TLS 连接当前的内存占用。
+ *
+ * @param tls TLS 句柄。
+ * @param p_report 用于存储内存占用。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_get_memory_report(volc_tls_t tls, volc_tls_memory_report_t* p_report);
+
+/**
+ * @brief 设置写合并缓冲区。
+ *
+ * 启用后 `volc_tls_write` 先将小块数据拷贝到缓冲区并立即返回写入长度，缓冲区装满、最早的数据等待超过 max_delay_ms
+ * 或调用 `volc_tls_flush` 时才合并为尽量少的 TLS 记录发送，减少记录头、认证标签和发送回调的开销。
+ * 不小于缓冲区大小的数据在缓冲区为空时直接发送。缓冲区中的数据在 `volc_tls_destroy` 时被丢弃。
+ *
+ * @param tls TLS 句柄，只适用于流式 TLS。
+ * @param buffer_size 缓冲区大小，0 表示关闭写合并。
+ * @param max_delay_ms 数据在缓冲区中的最长等待时间，单位毫秒，0 表示每次写入都立即尝试发送。
+ * @return 操作结果的状态码，0 表示成功；缓冲区中仍有数据时返回 VOLC_STATUS_INVALID_OPERATION，需先调用 `volc_tls_flush`。
+ */
+__byte_rtc_api__ uint32_t volc_tls_set_write_coalescing(volc_tls_t tls, uint32_t buffer_size, uint32_t max_delay_ms);
+
+/**
+ * @brief 发送写合并缓冲区中的全部数据。
+ *
+ * 交互式消息（例如信令请求）写入后应立即调用，批量数据可依赖缓冲区装满或等待超时自动发送。
+ *
+ * @param tls TLS 句柄。
+ * @return 0 表示缓冲区已清空；VOLC_MBEDTLS_ERR_SSL_WANT_WRITE 表示需在套接字可写后再次调用；其他负数表示错误。
+ */
+__byte_rtc_api__ int volc_tls_flush(volc_tls_t tls);
+
+/**
+ * @brief 获取写合并缓冲区距离必须发送的剩余时间。
+ *
+ * 事件循环以该值作为 volc_poll 的超时时间之一，超时后调用 `volc_tls_flush`。
+ *
+ * @param tls TLS 句柄。
+ * @return 剩余时间，单位毫秒；0 表示应立即发送；缓冲区为空时返回 VOLC_INFINITE_TIME_VALUE。
+ */
+__byte_rtc_api__ uint64_t volc_tls_get_flush_timeout_ms(volc_tls_t tls);
+
+/**
+ * @brief 设置动态记录大小。
+ *
+ * 启用后连接开始阶段（以及空闲 1 秒以上后）每条记录的载荷不超过一个 TCP 报文段，接收端收到一个报文段即可解密，
+ * 缩短首字节时间；累计发送 1MB 后使用最大 16KB 的记录以提高吞吐。此时 `volc_tls_write` 可能只写入部分数据，调用者需按返回值继续写入。
+ * 启用 kTLS 后记录大小由内核决定。
+ *
+ * @param tls TLS 句柄。
+ * @param enable 是否启用。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_set_dynamic_record_sizing(volc_tls_t tls, bool enable);
+
+/**
+ * @brief 将握手完成后的记录层加解密交给内核（kTLS）。
+ *
+ * 仅支持 TLS 1.2 的 AES-GCM 套件，且必须在握手完成后、第一次 `volc_tls_read` / `volc_tls_write` 之前调用。
+ * 流式连接默认最高协商 TLS 1.3，需要 kTLS 时应先用 `volc_tls_config_set_version_range` 将最高版本限制为 TLS 1.2，
+ * 否则 TLS 1.3 连接总是返回 VOLC_STATUS_NOT_IMPLEMENTED：TLS 1.3 握手后的 NewSessionTicket 和 KeyUpdate 消息
+ * 仍需 mbedtls 处理，不能交给内核。
+ * 成功后 `volc_tls_read` / `volc_tls_write` 直接在套接字上收发明文，省去用户态加密和回调中的一次拷贝，
+ * 发送回调和接收回调不再被调用；失败时连接保持原状，继续在用户态加解密。
+ *
+ * @param tls TLS 句柄。
+ * @param sockfd 该 TLS 连接所使用的 TCP 套接字。
+ * @return 操作结果的状态码：<br>
+ *         - VOLC_STATUS_SUCCESS: 已启用 <br>
+ *         - VOLC_STATUS_NOT_IMPLEMENTED: 协议版本、加密套件、平台或内核不支持，可继续使用用户态加解密 <br>
+ *         - VOLC_STATUS_INVALID_OPERATION: 握手未完成或已经收发过应用数据 <br>
+ *         - VOLC_STATUS_SET_SOCKET_FLAG_FAILED: 内核只接管了接收方向，连接已不可用
+ */
+__byte_rtc_api__ uint32_t volc_tls_enable_ktls(volc_tls_t tls, int sockfd);
+
+/**
+ * @brief 检查是否已启用 kTLS。
+ *
+ * @param tls TLS 句柄。
+ * @return 已启用返回 true，否则返回 false。
+ */
+__byte_rtc_api__ bool volc_tls_is_ktls_enabled(volc_tls_t tls);
+
+/**
+ * @brief 通过 TLS 连接发送文件内容。
+ *
+ * 启用 kTLS 时使用 sendfile 在内核中完成读取和加密，数据不经过用户态；否则每次读取最多 16KB 并通过 `volc_tls_write` 发送。
+ * 返回 VOLC_MBEDTLS_ERR_SSL_WANT_WRITE 时，应在套接字可写后以相同的 offset 重试。
+ *
+ * @param tls TLS 句柄。
+ * @param file_fd 打开的文件描述符。
+ * @param offset 文件内的起始偏移。
+ * @param count 最多发送的字节数。
+ * @return 实际发送的字节数，0 表示已到文件末尾，发生错误时返回负数。
+ */
+__byte_rtc_api__ int64_t volc_tls_sendfile(volc_tls_t tls, int file_fd, int64_t offset, size_t count);
+
+/**
+ * @brief 创建 TLS 共享配置。
+ *
+ * 创建时采集一次系统熵并初始化随机数生成器，证书校验模式与 `volc_tls_create` 相同。
+ *
+ * @param config 用于存储新创建的配置句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_config_create(volc_tls_config_t* config);
+
+/**
+ * @brief 释放调用者对共享配置的引用。
+ *
+ * @param config 配置句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_config_destroy(volc_tls_config_t config);
+
+/**
+ * @brief 向共享配置的 CA 证书链添加证书。
+ *
+ * @param config 配置句柄。
+ * @param data PEM 或 DER 格式的证书数据，PEM 格式时长度需包含结尾的 '\0'。
+ * @param len 证书数据长度。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_config_add_ca_cert(volc_tls_config_t config, const uint8_t* data, size_t len);
+
+/**
+ * @brief 设置本端证书和私钥。
+ *
+ * 配置只引用证书和私钥，调用者需保证它们在配置释放前有效。需在配置被连接或回收池引用前调用。
+ *
+ * @param config 配置句柄。
+ * @param cert 证书，例如由 `volc_certificate_and_key_create` 生成。
+ * @param pkey 与证书匹配的私钥。
+ * @return 操作结果的状态码，0 表示成功；配置已被其他对象引用时返回 VOLC_STATUS_INVALID_OPERATION。
+ */
+__byte_rtc_api__ uint32_t volc_tls_config_set_own_cert(volc_tls_config_t config, volc_cert_t cert, volc_pkey_t pkey);
+
+/**
+ * @brief 设置流式 TLS 连接允许协商的协议版本范围，对 DTLS 连接无效。
+ *
+ * @param config 配置句柄。
+ * @param min_version 最低版本。
+ * @param max_version 最高版本。
+ * @return 操作结果的状态码，0 表示成功；mbedtls 未开启 TLS 1.3 而 max_version 为 1.3 时返回 VOLC_STATUS_NOT_IMPLEMENTED。
+ */
+__byte_rtc_api__ uint32_t volc_tls_config_set_version_range(volc_tls_config_t config, volc_tls_version_e min_version, volc_tls_version_e max_version);
+
+/**
+ * @brief 允许客户端在 TLS 1.3 会话复用时发送 0-RTT 早期数据。
+ *
+ * 早期数据不具备重放保护，只应用于幂等请求（例如信令重连时的 rejoin）。
+ *
+ * @param config 配置句柄。
+ * @param enable 是否启用。
+ * @return 操作结果的状态码，0 表示成功；mbedtls 未开启 MBEDTLS_SSL_EARLY_DATA 时启用返回 VOLC_STATUS_NOT_IMPLEMENTED。
+ */
+__byte_rtc_api__ uint32_t volc_tls_config_enable_early_data(volc_tls_config_t config, bool enable);
+
+/**
+ * @brief 排队待随 ClientHello 发送的 0-RTT 早期数据。
+ *
+ * 需在 `volc_tls_start` 之前调用，可多次调用追加。仅当会话缓存中存在该主机允许早期数据的 TLS 1.3 会话时才会实际发送，
+ * 握手完成后通过 `volc_tls_get_early_data_status` 查询结果。
+ *
+ * @param tls TLS 句柄。
+ * @param data 早期数据。
+ * @param len 早期数据长度。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_queue_early_data(volc_tls_t tls, const uint8_t* data, size_t len);
+
+/**
+ * @brief 查询 0-RTT 早期数据的发送结果，握手完成后调用。
+ *
+ * @param tls TLS 句柄。
+ * @param p_written 可为 NULL，被接受时存储服务端已接受的字节数，其余部分需由调用者通过 `volc_tls_write` 重发。
+ * @return 早期数据的发送结果。
+ */
+__byte_rtc_api__ volc_tls_early_data_status_e volc_tls_get_early_data_status(volc_tls_t tls, size_t* p_written);
+
+/**
+ * @brief 设置客户端请求的最大分片长度（RFC 6066），对流式 TLS 和 DTLS 客户端均有效。
+ *
+ * @param config 配置句柄。
+ * @param max_fragment_length 可选 0（不限制）、512、1024、2048、4096。
+ * @return 操作结果的状态码，0 表示成功；长度不合法时返回 VOLC_STATUS_INVALID_ARG。
+ */
+__byte_rtc_api__ uint32_t volc_tls_config_set_max_fragment_length(volc_tls_config_t config, uint32_t max_fragment_length);
+
+/**
+ * @brief 启用或关闭客户端对服务端证书链的校验。
+ *
+ * 启用后客户端在握手完成时用共享配置的 CA 证书链（`volc_tls_config_add_ca_cert` 一次性加载）校验服务端证书链及主机名，
+ * 校验失败时发送 bad_certificate 告警，`volc_tls_start` 返回 MBEDTLS_ERR_X509_CERT_VERIFY_FAILED，
+ * `volc_tls_handshake_step` 返回 VOLC_STATUS_SSL_REMOTE_CERTIFICATE_VERIFICATION_FAILED，此后 `volc_tls_read`、`volc_tls_write`
+ * 均返回 MBEDTLS_ERR_X509_CERT_VERIFY_FAILED。握手未完成时调用读写会先完成握手和校验。
+ * 校验通过的证书链按“主机名 + 证书链 DER”的 SHA-256 指纹缓存，有效期内重连同一服务器时跳过证书链签名校验，
+ * 仍会检查各证书是否过期。服务端对密钥交换的签名在每次握手中都会被校验。
+ * 需在配置被连接或回收池引用前调用。
+ *
+ * @param config 配置句柄。
+ * @param enable 是否启用。
+ * @param cache_ttl_s 校验结果的缓存时间，单位秒，为 0 时使用默认值 3600 秒。
+ * @return 操作结果的状态码，0 表示成功；配置已被其他对象引用时返回 VOLC_STATUS_INVALID_OPERATION。
+ */
+__byte_rtc_api__ uint32_t volc_tls_config_enable_peer_verification(volc_tls_config_t config, bool enable, uint32_t cache_ttl_s);
+
+/**
+ * @brief 清空证书链校验缓存，例如在怀疑证书被吊销时调用。
+ *
+ * @param config 配置句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_config_clear_verify_cache(volc_tls_config_t config);
+
+/**
+ * @brief 将服务端握手中的私钥运算（签名、RSA 解密）交给工作线程池执行。
+ *
+ * 设置后服务端（包括 DTLS 服务端）握手在需要私钥运算时，`volc_tls_handshake_step` 返回 VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY
+ * 且等待事件为 0，事件循环不再被数毫秒的 RSA/ECDSA 运算阻塞。运算完成后由 `volc_worker_pool_dispatch` 所在线程
+ * 调用连接的 `volc_tls_async_ready_callback`，握手需在同一线程中继续推进。
+ * 工作线程使用私钥的独立副本，同一配置在工作线程中的私钥运算串行执行，不会与调用线程中的签名（如客户端证书签名）
+ * 共享 mbedtls 状态。只对 `volc_tls_config_set_own_cert` 设置的证书生效，无法导出的私钥（如 PSA 不透明密钥）仍在调用线程中运算。
+ * 仅对 TLS 1.2 和 DTLS 1.2 握手生效：mbedtls 3.6 只在 TLS 1.2 中调用异步私钥回调，TLS 1.3（流式连接的默认最高版本）的
+ * CertificateVerify 仍在调用线程中同步签名；需要卸载时可用 `volc_tls_config_set_version_range` 将最高版本限制为 TLS 1.2。
+ * 需在配置被连接或回收池引用前调用，线程池的生命周期必须长于配置。
+ *
+ * @param config 配置句柄。
+ * @param pool 工作线程池，为 NULL 时恢复同步运算。
+ * @return 操作结果的状态码，0 表示成功；配置已被其他对象引用时返回 VOLC_STATUS_INVALID_OPERATION，
+ *         mbedtls 未开启 MBEDTLS_SSL_ASYNC_PRIVATE 时返回 VOLC_STATUS_NOT_IMPLEMENTED。
+ */
+__byte_rtc_api__ uint32_t volc_tls_config_set_async_crypto(volc_tls_config_t config, volc_worker_pool_t pool);
+
+/**
+ * @brief 设置异步私钥运算完成回调。
+ *
+ * 回调在每次 `volc_tls_start`、`volc_tls_start_dtls` 以及上下文归还回收池时被清除，需在启动连接之后设置；
+ * 回调只会在 `volc_worker_pool_dispatch` 所在线程中触发，在同一线程中启动连接后立即设置不会错过完成通知。
+ *
+ * @param tls TLS 句柄。
+ * @param callback 完成回调，可为 NULL。
+ * @param custom_data 用户自定义的数据，将传递给回调函数。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_set_async_ready_callback(volc_tls_t tls, volc_tls_async_ready_callback callback, void* custom_data);
+
+/**
+ * @brief 设置客户端会话缓存的有效期。
+ *
+ * 客户端握手完成后会按主机名缓存会话（Session ID 或 Session Ticket），`volc_tls_start` 连接同一主机时自动尝试复用。
+ *
+ * @param lifetime_s 会话有效期，单位秒，默认 7200 秒。
+ */
+__byte_rtc_api__ void volc_tls_session_cache_set_lifetime(uint32_t lifetime_s);
+
+/**
+ * @brief 清空客户端会话缓存。
+ */
+__byte_rtc_api__ void volc_tls_session_cache_clear(void);
+
+/**
+ * @brief 为本进程内所有服务端 TLS 连接启用 Session Ticket。
+ *
+ * 票据密钥由进程内共享的随机数生成器生成，并每隔 lifetime_s 自动轮换，旧密钥在下一个周期内仍可用于解密。
+ * 需在创建 TLS 共享配置（包括首次调用 `volc_tls_create`）之前调用，之后创建的配置才会使用票据。
+ *
+ * @param lifetime_s 票据及密钥的有效期，单位秒，为 0 时使用默认值 7200 秒。
+ * @return 操作结果的状态码，0 表示成功；mbedtls 未开启 MBEDTLS_SSL_TICKET_C 时返回 VOLC_STATUS_NOT_IMPLEMENTED。
+ */
+__byte_rtc_api__ uint32_t volc_tls_enable_server_session_tickets(uint32_t lifetime_s);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,118 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef __HAL_VOLC_TLS_POOL_H__
+#define __HAL_VOLC_TLS_POOL_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "volc_tls.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_MSC_VER)
+#if defined(__BUILDING_BYTE_RTC_SDK__)
+#define __byte_rtc_api__ __declspec(dllexport)
+#else
+#define __byte_rtc_api__ __declspec(dllimport)
+#endif
+#else
+#define __byte_rtc_api__ __attribute__((visibility("default")))
+#endif
+
+/**
+ * @brief TLS 上下文回收池句柄
+ *
+ * 池中保存已初始化的 TLS 上下文，归还时只做会话重置而不释放，mbedtls 记录缓冲区和共享配置引用得以保留，
+ * 重连风暴时避免反复分配大块内存。接口是线程安全的。
+ */
+typedef void* volc_tls_pool_t;
+
+/**
+ * @brief TLS 上下文回收池配置。
+ */
+typedef struct {
+    /**
+     * @brief 池中上下文的创建选项，config 为 NULL 时使用进程内默认配置。
+     */
+    volc_tls_options_t options;
+    /**
+     * @brief 创建池时预先创建的上下文数量，预创建的上下文已完成 mbedtls_ssl_setup，记录缓冲区已分配。
+     */
+    uint32_t warm_size;
+    /**
+     * @brief 预创建的上下文按服务端（true）还是客户端（false）初始化。
+     *
+     * 与之后 `volc_tls_start` 的 is_server 不一致时上下文仍可使用，只是首次启动会重新执行 mbedtls_ssl_setup。
+     */
+    bool is_server;
+    /**
+     * @brief 池中最多保留的空闲上下文数量，超出时归还的上下文被直接销毁。
+     */
+    uint32_t max_idle;
+} volc_tls_pool_config_t;
+
+/**
+ * @brief 获取默认的回收池配置。
+ *
+ * @param config 用于存储默认配置的结构体指针。
+ */
+__byte_rtc_api__ void volc_tls_pool_get_default_config(volc_tls_pool_config_t* config);
+
+/**
+ * @brief 创建 TLS 上下文回收池。
+ *
+ * @param config 回收池配置，为 NULL 时使用默认配置。
+ * @param p_pool 用于存储新创建的回收池句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_pool_create(const volc_tls_pool_config_t* config, volc_tls_pool_t* p_pool);
+
+/**
+ * @brief 销毁回收池及其中的空闲上下文，已取出的上下文需由调用者通过 `volc_tls_destroy` 释放或在销毁前归还。
+ *
+ * @param pool 回收池句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_pool_destroy(volc_tls_pool_t pool);
+
+/**
+ * @brief 从回收池中取出一个 TLS 上下文，池为空时新建。
+ *
+ * 取出的上下文与 `volc_tls_create_ex` 创建的上下文用法相同。
+ *
+ * @param pool 回收池句柄。
+ * @param p_tls 用于存储取出的 TLS 句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_pool_acquire(volc_tls_pool_t pool, volc_tls_t* p_tls);
+
+/**
+ * @brief 将 TLS 上下文归还回收池。
+ *
+ * 上下文被重置：会话密钥、对端证书、排队的早期数据和写合并缓冲区中的数据被丢弃，尽力发送 close_notify。
+ * 归还后调用者不能再使用该句柄。
+ *
+ * @param pool 回收池句柄。
+ * @param tls 由 `volc_tls_pool_acquire` 取出的 TLS 句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。参数错误时上下文保持不变，重置失败时上下文已被销毁。
+ */
+__byte_rtc_api__ uint32_t volc_tls_pool_release(volc_tls_pool_t pool, volc_tls_t tls);
+
+/**
+ * @brief 获取回收池中空闲上下文的数量。
+ *
+ * @param pool 回收池句柄。
+ * @return 空闲上下文数量。
+ */
+__byte_rtc_api__ uint32_t volc_tls_pool_get_idle_count(volc_tls_pool_t pool);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __HAL_VOLC_TLS_POOL_H__ */
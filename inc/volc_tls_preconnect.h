@@ -0,0 +1,123 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef __HAL_VOLC_TLS_PRECONNECT_H__
+#define __HAL_VOLC_TLS_PRECONNECT_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "volc_tls.h"
+#include "volc_worker_pool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_MSC_VER)
+#if defined(__BUILDING_BYTE_RTC_SDK__)
+#define __byte_rtc_api__ __declspec(dllexport)
+#else
+#define __byte_rtc_api__ __declspec(dllimport)
+#endif
+#else
+#define __byte_rtc_api__ __attribute__((visibility("default")))
+#endif
+
+/**
+ * @brief TLS 预连接池句柄
+ *
+ * 在后台完成 DNS 解析、TCP 连接（Happy Eyeballs）和 TLS 握手，并按“主机名 + 端口”保存已就绪的连接，
+ * 进房等关键路径上直接取用，省去 2~3 个 RTT。
+ * 预连接池不是线程安全的，所有接口都应在调用 volc_worker_pool_dispatch 的线程（通常是事件循环线程）中调用。
+ */
+typedef void* volc_tls_preconnect_pool_t;
+
+/**
+ * @brief TLS 预连接池配置。
+ */
+typedef struct {
+    /**
+     * @brief 预连接使用的 TLS 选项，config 为 NULL 时使用进程内默认配置。
+     */
+    volc_tls_options_t options;
+    /**
+     * @brief 最多保存的就绪连接数量，正在建立的连接不计入；新连接就绪后超出时关闭最早就绪的连接。
+     */
+    uint32_t max_idle;
+    /**
+     * @brief 就绪连接的最长空闲时间，单位毫秒，超时的连接被关闭，避免取到已被服务端关闭的连接。为 0 时使用默认值 30000 毫秒。
+     */
+    uint32_t idle_timeout_ms;
+    /**
+     * @brief 连接和握手的总超时时间，单位毫秒。为 0 时使用默认值 10000 毫秒。
+     */
+    uint32_t handshake_timeout_ms;
+} volc_tls_preconnect_config_t;
+
+/**
+ * @brief 获取默认的预连接池配置。
+ *
+ * @param config 用于存储默认配置的结构体指针。
+ */
+__byte_rtc_api__ void volc_tls_preconnect_get_default_config(volc_tls_preconnect_config_t* config);
+
+/**
+ * @brief 创建 TLS 预连接池。
+ *
+ * @param pool 执行连接和握手的工作线程池，生命周期必须长于预连接池。
+ * @param config 预连接池配置，为 NULL 时使用默认配置。
+ * @param p_preconnect 用于存储新创建的预连接池句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_preconnect_pool_create(volc_worker_pool_t pool, const volc_tls_preconnect_config_t* config, volc_tls_preconnect_pool_t* p_preconnect);
+
+/**
+ * @brief 销毁预连接池，关闭所有就绪的连接，正在建立的连接完成后自动关闭。
+ *
+ * @param preconnect 预连接池句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_preconnect_pool_destroy(volc_tls_preconnect_pool_t preconnect);
+
+/**
+ * @brief 在后台预先建立到指定主机的 TLS 连接。
+ *
+ * 同一主机和端口已有就绪或正在建立的连接时直接返回成功。
+ *
+ * @param preconnect 预连接池句柄。
+ * @param host 主机名，同时用作 SNI 和会话缓存的键。
+ * @param port 端口，主机字节序。
+ * @return 操作结果的状态码，0 表示请求已受理，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_tls_preconnect(volc_tls_preconnect_pool_t preconnect, const char* host, uint16_t port);
+
+/**
+ * @brief 取出已就绪的预连接。
+ *
+ * 取出后连接归调用者所有：TLS 连接通过 `volc_tls_destroy` 释放，套接字通过 `volc_close` 关闭。
+ * TLS 连接已绑定 `volc_tls_socket_send` / `volc_tls_socket_recv`，也可以再调用 `volc_tls_set_transport` 换成调用者自己的回调。
+ *
+ * @param preconnect 预连接池句柄。
+ * @param host 主机名。
+ * @param port 端口，主机字节序。
+ * @param p_tls 用于存储已完成握手的 TLS 句柄。
+ * @param p_sockfd 用于存储已连接的非阻塞套接字。
+ * @return 操作结果的状态码，0 表示成功；没有就绪的连接（包括仍在建立中）时返回 VOLC_STATUS_NOT_FOUND，调用者应正常建立连接。
+ */
+__byte_rtc_api__ uint32_t volc_tls_preconnect_take(volc_tls_preconnect_pool_t preconnect, const char* host, uint16_t port, volc_tls_t* p_tls, int* p_sockfd);
+
+/**
+ * @brief 获取预连接池中就绪连接的数量，同时关闭已过期的连接。
+ *
+ * @param preconnect 预连接池句柄。
+ * @return 就绪连接数量。
+ */
+__byte_rtc_api__ uint32_t volc_tls_preconnect_get_ready_count(volc_tls_preconnect_pool_t preconnect);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __HAL_VOLC_TLS_PRECONNECT_H__ */
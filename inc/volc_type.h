@@ -168,6 +168,7 @@ extern "C" {
 #define VOLC_STATUS_GET_SOCKET_FLAG_FAILED              VOLC_STATUS_NETWORKING_BASE + 0x00000024
 #define VOLC_STATUS_SET_SOCKET_FLAG_FAILED              VOLC_STATUS_NETWORKING_BASE + 0x00000025
 #define VOLC_STATUS_CLOSE_SOCKET_FAILED                 VOLC_STATUS_NETWORKING_BASE + 0x00000026
+#define VOLC_STATUS_SEND_QUEUE_FULL                     VOLC_STATUS_NETWORKING_BASE + 0x00000027
 /*!@} */
 
 /////////////////////////////////////////////////////
@@ -187,6 +188,22 @@ extern "C" {
 #define VOLC_STATUS_SSL_INVALID_CERTIFICATE_BITS               VOLC_STATUS_DTLS_BASE + 0x00000006
 #define VOLC_STATUS_SSL_SET_HOSTNAME_FAILED                    VOLC_STATUS_DTLS_BASE + 0x00000007
 
+/////////////////////////////////////////////////////
+/// SRTP related status codes
+/////////////////////////////////////////////////////
+
+/*! \addtogroup SRTPStatusCodes
+ * WEBRTC SRTP related codes. Values are derived from VOLC_STATUS_SRTP_BASE (0x5b000000)
+ *  @{
+ */
+#define VOLC_STATUS_SRTP_BASE                                  0x5b000000
+#define VOLC_STATUS_SRTP_INVALID_PACKET                        VOLC_STATUS_SRTP_BASE + 0x00000001
+#define VOLC_STATUS_SRTP_AUTHENTICATION_FAILED                 VOLC_STATUS_SRTP_BASE + 0x00000002
+#define VOLC_STATUS_SRTP_REPLAYED_PACKET                       VOLC_STATUS_SRTP_BASE + 0x00000003
+#define VOLC_STATUS_SRTP_TOO_MANY_STREAMS                      VOLC_STATUS_SRTP_BASE + 0x00000004
+#define VOLC_STATUS_SRTP_KEY_EXHAUSTED                         VOLC_STATUS_SRTP_BASE + 0x00000005
+/*!@} */
+
 #define VOLC_VALID_CHAR_SET_FOR_JSON "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
 
 #ifndef VOLC_UNUSED_PARAM
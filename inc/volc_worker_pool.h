@@ -0,0 +1,101 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef __HAL_VOLC_WORKER_POOL_H__
+#define __HAL_VOLC_WORKER_POOL_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_MSC_VER)
+#if defined(__BUILDING_BYTE_RTC_SDK__)
+#define __byte_rtc_api__ __declspec(dllexport)
+#else
+#define __byte_rtc_api__ __declspec(dllimport)
+#endif
+#else
+#define __byte_rtc_api__ __attribute__((visibility("default")))
+#endif
+
+/**
+ * @brief 工作线程池句柄
+ *
+ * 在后台线程中执行阻塞任务（例如 DNS 解析），并将完成回调投递回事件循环线程执行。
+ */
+typedef void* volc_worker_pool_t;
+
+/**
+ * @brief 任务函数，在工作线程中执行。
+ *
+ * @param arg 提交任务时传入的参数。
+ * @return 任务结果的状态码，会传递给完成回调。
+ */
+typedef uint32_t (*volc_worker_task_t)(void* arg);
+
+/**
+ * @brief 任务完成回调，在调用 volc_worker_pool_dispatch 的线程（通常是事件循环线程）中执行。
+ *
+ * @param arg 提交任务时传入的参数。
+ * @param status 任务函数的返回值；任务在执行前被取消时为 VOLC_STATUS_USER_CANCELED。
+ */
+typedef void (*volc_worker_done_t)(void* arg, uint32_t status);
+
+/**
+ * @brief 创建工作线程池。
+ *
+ * @param thread_count 工作线程数量，为 0 时使用 1 个线程。
+ * @param p_pool 用于存储新创建的线程池句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_worker_pool_create(uint32_t thread_count, volc_worker_pool_t* p_pool);
+
+/**
+ * @brief 销毁工作线程池。
+ *
+ * 等待正在执行的任务结束，尚未执行的任务以 VOLC_STATUS_USER_CANCELED 调用完成回调，
+ * 所有未投递的完成回调在当前线程中执行。
+ *
+ * @param pool 要销毁的线程池句柄。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_worker_pool_destroy(volc_worker_pool_t pool);
+
+/**
+ * @brief 提交一个任务。
+ *
+ * @param pool 线程池句柄。
+ * @param task 在工作线程中执行的任务函数。
+ * @param done 完成回调，可以为 NULL。
+ * @param arg 传递给任务函数和完成回调的参数。
+ * @return 操作结果的状态码，0 表示成功，非 0 表示失败。
+ */
+__byte_rtc_api__ uint32_t volc_worker_pool_submit(volc_worker_pool_t pool, volc_worker_task_t task, volc_worker_done_t done, void* arg);
+
+/**
+ * @brief 获取完成通知描述符。
+ *
+ * 有任务完成时该描述符变为可读，事件循环应监听其 VOLC_EVLOOP_POLLIN 事件并调用 volc_worker_pool_dispatch。
+ *
+ * @param pool 线程池句柄。
+ * @return 通知描述符，失败返回 -1。
+ */
+__byte_rtc_api__ int volc_worker_pool_get_notify_fd(volc_worker_pool_t pool);
+
+/**
+ * @brief 在当前线程中执行所有已完成任务的完成回调。
+ *
+ * @param pool 线程池句柄。
+ * @return 执行的完成回调数量。
+ */
+__byte_rtc_api__ uint32_t volc_worker_pool_dispatch(volc_worker_pool_t pool);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __HAL_VOLC_WORKER_POOL_H__ */
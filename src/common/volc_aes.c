@@ -0,0 +1,193 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_crypto_internal.h"
+
+#include <string.h>
+
+#include <mbedtls/platform_util.h>
+
+#if defined(VOLC_CRYPTO_X86_KERNELS)
+#include <immintrin.h>
+#endif
+
+// counter blocks in flight per AES-NI pass, enough to hide the aesenc latency on current cores
+#define VOLC_AES_CTR_INTERLEAVE 8
+
+static inline void _volc_aes_ctr_increment(uint8_t counter[VOLC_AES_BLOCK_LENGTH]) {
+    int32_t i = 0;
+    for (i = VOLC_AES_BLOCK_LENGTH - 1; i >= 0; i--) {
+        if (++counter[i] != 0) {
+            break;
+        }
+    }
+}
+
+#if defined(VOLC_CRYPTO_X86_KERNELS)
+__attribute__((target("aes,sse4.1"))) static inline __m128i _volc_aes_expand_step(__m128i key, __m128i assist) {
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, assist);
+}
+
+// aeskeygenassist wants the round constant as an immediate
+#define VOLC_AES128_EXPAND(i, rcon) rk[i] = _volc_aes_expand_step(rk[(i) - 1], _mm_shuffle_epi32(_mm_aeskeygenassist_si128(rk[(i) - 1], rcon), 0xff))
+#define VOLC_AES256_EXPAND_EVEN(i, rcon) rk[i] = _volc_aes_expand_step(rk[(i) - 2], _mm_shuffle_epi32(_mm_aeskeygenassist_si128(rk[(i) - 1], rcon), 0xff))
+#define VOLC_AES256_EXPAND_ODD(i)        rk[i] = _volc_aes_expand_step(rk[(i) - 2], _mm_shuffle_epi32(_mm_aeskeygenassist_si128(rk[(i) - 1], 0), 0xaa))
+
+// only 128 and 256 bit keys, the caller falls back to mbedtls for anything else
+__attribute__((target("aes,sse4.1"))) void volc_aes_expand_aesni(const uint8_t* key, uint32_t key_bits, uint8_t* round_keys) {
+    __m128i rk[VOLC_AES_MAX_ROUNDS + 1];
+    uint32_t rounds = key_bits == 256 ? 14 : 10;
+    uint32_t i = 0;
+
+    rk[0] = _mm_loadu_si128((const __m128i*)key);
+    if (key_bits == 256) {
+        rk[1] = _mm_loadu_si128((const __m128i*)(key + 16));
+        VOLC_AES256_EXPAND_EVEN(2, 0x01);
+        VOLC_AES256_EXPAND_ODD(3);
+        VOLC_AES256_EXPAND_EVEN(4, 0x02);
+        VOLC_AES256_EXPAND_ODD(5);
+        VOLC_AES256_EXPAND_EVEN(6, 0x04);
+        VOLC_AES256_EXPAND_ODD(7);
+        VOLC_AES256_EXPAND_EVEN(8, 0x08);
+        VOLC_AES256_EXPAND_ODD(9);
+        VOLC_AES256_EXPAND_EVEN(10, 0x10);
+        VOLC_AES256_EXPAND_ODD(11);
+        VOLC_AES256_EXPAND_EVEN(12, 0x20);
+        VOLC_AES256_EXPAND_ODD(13);
+        VOLC_AES256_EXPAND_EVEN(14, 0x40);
+    } else {
+        VOLC_AES128_EXPAND(1, 0x01);
+        VOLC_AES128_EXPAND(2, 0x02);
+        VOLC_AES128_EXPAND(3, 0x04);
+        VOLC_AES128_EXPAND(4, 0x08);
+        VOLC_AES128_EXPAND(5, 0x10);
+        VOLC_AES128_EXPAND(6, 0x20);
+        VOLC_AES128_EXPAND(7, 0x40);
+        VOLC_AES128_EXPAND(8, 0x80);
+        VOLC_AES128_EXPAND(9, 0x1b);
+        VOLC_AES128_EXPAND(10, 0x36);
+    }
+    for (i = 0; i <= rounds; i++) {
+        _mm_storeu_si128((__m128i*)(round_keys + i * VOLC_AES_BLOCK_LENGTH), rk[i]);
+    }
+    mbedtls_platform_zeroize(rk, sizeof(rk));
+}
+
+// encrypts all interleaved counter blocks at once and xors the keystream into their packets
+__attribute__((target("aes,sse4.1"))) static inline void _volc_aes_ctr_flush(const __m128i* rk, uint32_t rounds, __m128i* blocks, const uint8_t* const* src,
+                                                                             uint8_t* const* dst, const size_t* len, size_t pending) {
+    uint8_t keystream[VOLC_AES_BLOCK_LENGTH];
+    uint32_t r = 0;
+    size_t i = 0;
+    size_t j = 0;
+
+    for (i = 0; i < VOLC_AES_CTR_INTERLEAVE; i++) {
+        blocks[i] = _mm_xor_si128(blocks[i], rk[0]);
+    }
+    for (r = 1; r < rounds; r++) {
+        for (i = 0; i < VOLC_AES_CTR_INTERLEAVE; i++) {
+            blocks[i] = _mm_aesenc_si128(blocks[i], rk[r]);
+        }
+    }
+    for (i = 0; i < VOLC_AES_CTR_INTERLEAVE; i++) {
+        blocks[i] = _mm_aesenclast_si128(blocks[i], rk[rounds]);
+    }
+    for (i = 0; i < pending; i++) {
+        if (len[i] == VOLC_AES_BLOCK_LENGTH) {
+            _mm_storeu_si128((__m128i*)dst[i], _mm_xor_si128(_mm_loadu_si128((const __m128i*)src[i]), blocks[i]));
+        } else {
+            _mm_storeu_si128((__m128i*)keystream, blocks[i]);
+            for (j = 0; j < len[i]; j++) {
+                dst[i][j] = src[i][j] ^ keystream[j];
+            }
+        }
+    }
+}
+
+__attribute__((target("aes,sse4.1"))) void volc_aes_ctr_jobs_aesni(const uint8_t* round_keys, uint32_t rounds, volc_aes_ctr_job_t* jobs, size_t count) {
+    __m128i rk[VOLC_AES_MAX_ROUNDS + 1];
+    __m128i blocks[VOLC_AES_CTR_INTERLEAVE];
+    const uint8_t* src[VOLC_AES_CTR_INTERLEAVE];
+    uint8_t* dst[VOLC_AES_CTR_INTERLEAVE];
+    size_t len[VOLC_AES_CTR_INTERLEAVE];
+    uint8_t counter[VOLC_AES_BLOCK_LENGTH];
+    size_t pending = 0;
+    size_t offset = 0;
+    size_t i = 0;
+
+    for (i = 0; i <= rounds; i++) {
+        rk[i] = _mm_loadu_si128((const __m128i*)(round_keys + i * VOLC_AES_BLOCK_LENGTH));
+    }
+    for (i = 0; i < VOLC_AES_CTR_INTERLEAVE; i++) {
+        blocks[i] = _mm_setzero_si128();
+    }
+    // blocks of consecutive jobs share a pass, a batch of small packets runs as densely as one large buffer
+    for (i = 0; i < count; i++) {
+        memcpy(counter, jobs[i].counter, sizeof(counter));
+        for (offset = 0; offset < jobs[i].len; offset += VOLC_AES_BLOCK_LENGTH) {
+            blocks[pending] = _mm_loadu_si128((const __m128i*)counter);
+            src[pending] = jobs[i].input + offset;
+            dst[pending] = jobs[i].output + offset;
+            len[pending] = jobs[i].len - offset < VOLC_AES_BLOCK_LENGTH ? jobs[i].len - offset : VOLC_AES_BLOCK_LENGTH;
+            _volc_aes_ctr_increment(counter);
+            if (++pending == VOLC_AES_CTR_INTERLEAVE) {
+                _volc_aes_ctr_flush(rk, rounds, blocks, src, dst, len, pending);
+                pending = 0;
+            }
+        }
+    }
+    if (pending > 0) {
+        _volc_aes_ctr_flush(rk, rounds, blocks, src, dst, len, pending);
+    }
+    mbedtls_platform_zeroize(rk, sizeof(rk));
+    mbedtls_platform_zeroize(blocks, sizeof(blocks));
+}
+#endif
+
+void volc_aes_ctr_key_init(volc_aes_ctr_key_t* key) {
+    memset(key, 0, sizeof(volc_aes_ctr_key_t));
+    mbedtls_aes_init(&key->aes);
+}
+
+int volc_aes_ctr_key_setkey(volc_aes_ctr_key_t* key, const uint8_t* key_bytes, uint32_t key_bits) {
+    const volc_crypto_dispatch_t* dispatch = volc_crypto_get_dispatch();
+
+    key->rounds = 0;
+    key->ctr_jobs = NULL;
+    if (dispatch->aes_expand != NULL && dispatch->aes_ctr_jobs != NULL && (key_bits == 128 || key_bits == 256)) {
+        dispatch->aes_expand(key_bytes, key_bits, key->round_keys);
+        key->rounds = key_bits == 256 ? 14 : 10;
+        key->ctr_jobs = dispatch->aes_ctr_jobs;
+        return 0;
+    }
+    return mbedtls_aes_setkey_enc(&key->aes, key_bytes, key_bits);
+}
+
+void volc_aes_ctr_key_free(volc_aes_ctr_key_t* key) {
+    mbedtls_aes_free(&key->aes);
+    mbedtls_platform_zeroize(key->round_keys, sizeof(key->round_keys));
+    key->rounds = 0;
+}
+
+void volc_aes_ctr_key_crypt(volc_aes_ctr_key_t* key, volc_aes_ctr_job_t* jobs, size_t count) {
+    uint8_t counter[VOLC_AES_BLOCK_LENGTH];
+    uint8_t stream_block[VOLC_AES_BLOCK_LENGTH];
+    size_t nc_off = 0;
+    size_t i = 0;
+
+    if (key->ctr_jobs != NULL) {
+        key->ctr_jobs(key->round_keys, key->rounds, jobs, count);
+        return;
+    }
+    for (i = 0; i < count; i++) {
+        memcpy(counter, jobs[i].counter, sizeof(counter));
+        nc_off = 0;
+        mbedtls_aes_crypt_ctr(&key->aes, jobs[i].len, &nc_off, counter, stream_block, jobs[i].input, jobs[i].output);
+    }
+    mbedtls_platform_zeroize(stream_block, sizeof(stream_block));
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_crypto_internal.h"
+
+#include <string.h>
+
+#if defined(VOLC_CRYPTO_X86_KERNELS)
+#include <immintrin.h>
+#endif
+
+#include "volc_crc_table.h"
+
+// every function here works on the raw CRC register, the pre and post inversion is done once in volc_crc32/volc_crc32c
+static uint32_t _volc_crc_slice8(const uint32_t table[8][256], uint32_t crc, const uint8_t* data, size_t len) {
+    uint32_t lo = 0;
+    uint32_t hi = 0;
+
+    // bytes are assembled explicitly so the tables hold on any endianness, compilers turn it back into plain loads
+    while (len >= 8) {
+        lo = crc ^ ((uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24));
+        hi = (uint32_t)data[4] | ((uint32_t)data[5] << 8) | ((uint32_t)data[6] << 16) | ((uint32_t)data[7] << 24);
+        crc = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^ table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^ table[3][hi & 0xff] ^
+              table[2][(hi >> 8) & 0xff] ^ table[1][(hi >> 16) & 0xff] ^ table[0][hi >> 24];
+        data += 8;
+        len -= 8;
+    }
+    while (len > 0) {
+        crc = table[0][(crc ^ *data++) & 0xff] ^ (crc >> 8);
+        len--;
+    }
+    return crc;
+}
+
+uint32_t volc_crc32_update_portable(uint32_t crc, const uint8_t* data, size_t len) {
+    return _volc_crc_slice8(g_volc_crc32_table, crc, data, len);
+}
+
+uint32_t volc_crc32c_update_portable(uint32_t crc, const uint8_t* data, size_t len) {
+    return _volc_crc_slice8(g_volc_crc32c_table, crc, data, len);
+}
+
+#if defined(VOLC_CRYPTO_X86_KERNELS)
+// below this the fold setup costs more than slicing-by-8 saves
+#define VOLC_CRC32_FOLD_MIN_LENGTH 64
+
+// folds 16 byte multiples of data into the CRC with carry-less multiplies ("Fast CRC Computation for Generic Polynomials
+// Using PCLMULQDQ", Intel 2009), the constants are x^n mod P for the reflected CRC-32 polynomial and its Barrett constant
+__attribute__((target("pclmul,sse4.1"))) static uint32_t _volc_crc32_fold(uint32_t crc, const uint8_t* data, size_t len) {
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    const __m128i k5k0 = _mm_set_epi64x(0, 0x0163cd6124);
+    const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+    const __m128i mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+    __m128i x1, x2, x3, x4, t1, t2, t3, t4;
+
+    x1 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)data), _mm_cvtsi32_si128((int)crc));
+    x2 = _mm_loadu_si128((const __m128i*)(data + 16));
+    x3 = _mm_loadu_si128((const __m128i*)(data + 32));
+    x4 = _mm_loadu_si128((const __m128i*)(data + 48));
+    data += 64;
+    len -= 64;
+
+    // four independent 128-bit accumulators keep the multiplier busy
+    while (len >= 64) {
+        t1 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        t2 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        t3 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        t4 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+        x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k1k2, 0x11), t1);
+        x2 = _mm_xor_si128(_mm_clmulepi64_si128(x2, k1k2, 0x11), t2);
+        x3 = _mm_xor_si128(_mm_clmulepi64_si128(x3, k1k2, 0x11), t3);
+        x4 = _mm_xor_si128(_mm_clmulepi64_si128(x4, k1k2, 0x11), t4);
+        x1 = _mm_xor_si128(x1, _mm_loadu_si128((const __m128i*)data));
+        x2 = _mm_xor_si128(x2, _mm_loadu_si128((const __m128i*)(data + 16)));
+        x3 = _mm_xor_si128(x3, _mm_loadu_si128((const __m128i*)(data + 32)));
+        x4 = _mm_xor_si128(x4, _mm_loadu_si128((const __m128i*)(data + 48)));
+        data += 64;
+        len -= 64;
+    }
+
+    // fold the accumulators into one, then the remaining 16 byte blocks
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), _mm_clmulepi64_si128(x1, k3k4, 0x00)), x2);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), _mm_clmulepi64_si128(x1, k3k4, 0x00)), x3);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), _mm_clmulepi64_si128(x1, k3k4, 0x00)), x4);
+    while (len >= 16) {
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), _mm_clmulepi64_si128(x1, k3k4, 0x00)),
+                           _mm_loadu_si128((const __m128i*)data));
+        data += 16;
+        len -= 16;
+    }
+
+    // 128 to 64 bits, then Barrett reduction to the 32-bit remainder
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k5k0, 0x00), x2);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), poly, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask32), poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+uint32_t volc_crc32_update_pclmul(uint32_t crc, const uint8_t* data, size_t len) {
+    size_t folded = 0;
+
+    if (len >= VOLC_CRC32_FOLD_MIN_LENGTH) {
+        folded = len & ~(size_t)15;
+        crc = _volc_crc32_fold(crc, data, folded);
+    }
+    return _volc_crc_slice8(g_volc_crc32_table, crc, data + folded, len - folded);
+}
+
+#if defined(__x86_64__)
+// bytes per lane of the three way interleave and x^(8 * n - 33) mod P to shift a lane CRC over n bytes, see _volc_crc32c_shift
+#define VOLC_CRC32C_LONG_LANE     1024
+#define VOLC_CRC32C_LONG_SHIFT1   0x170076fa
+#define VOLC_CRC32C_LONG_SHIFT2   0xa51b6135
+#define VOLC_CRC32C_SHORT_LANE    128
+#define VOLC_CRC32C_SHORT_SHIFT1  0x0d3b6092
+#define VOLC_CRC32C_SHORT_SHIFT2  0xb9e02b86
+
+// crc * x^(8 * n) mod P: the clmul product carries one extra factor x and crc32 of 8 bytes multiplies by x^32, hence x^(8 * n - 33)
+__attribute__((target("sse4.2,pclmul"))) static inline uint32_t _volc_crc32c_shift(uint32_t crc, uint32_t k) {
+    __m128i product = _mm_clmulepi64_si128(_mm_cvtsi32_si128((int)crc), _mm_cvtsi32_si128((int)k), 0x00);
+    return (uint32_t)_mm_crc32_u64(0, (uint64_t)_mm_cvtsi128_si64(product));
+}
+
+// the crc32 instruction has a latency of three cycles, three independent lanes keep one in flight every cycle
+__attribute__((target("sse4.2,pclmul"))) static inline uint32_t _volc_crc32c_lanes(uint32_t crc, const uint8_t** p_data, size_t* p_len, size_t lane,
+                                                                                  uint32_t shift1, uint32_t shift2) {
+    const uint8_t* data = *p_data;
+    size_t len = *p_len;
+    uint64_t c0 = 0;
+    uint64_t c1 = 0;
+    uint64_t c2 = 0;
+    uint64_t v0 = 0;
+    uint64_t v1 = 0;
+    uint64_t v2 = 0;
+    size_t i = 0;
+
+    while (len >= 3 * lane) {
+        c0 = crc;
+        c1 = 0;
+        c2 = 0;
+        for (i = 0; i < lane; i += 8) {
+            memcpy(&v0, data + i, sizeof(v0));
+            memcpy(&v1, data + lane + i, sizeof(v1));
+            memcpy(&v2, data + 2 * lane + i, sizeof(v2));
+            c0 = _mm_crc32_u64(c0, v0);
+            c1 = _mm_crc32_u64(c1, v1);
+            c2 = _mm_crc32_u64(c2, v2);
+        }
+        crc = _volc_crc32c_shift((uint32_t)c0, shift2) ^ _volc_crc32c_shift((uint32_t)c1, shift1) ^ (uint32_t)c2;
+        data += 3 * lane;
+        len -= 3 * lane;
+    }
+    *p_data = data;
+    *p_len = len;
+    return crc;
+}
+
+__attribute__((target("sse4.2,pclmul"))) uint32_t volc_crc32c_update_sse42(uint32_t crc, const uint8_t* data, size_t len) {
+    uint64_t crc64 = 0;
+    uint64_t v = 0;
+
+    crc = _volc_crc32c_lanes(crc, &data, &len, VOLC_CRC32C_LONG_LANE, VOLC_CRC32C_LONG_SHIFT1, VOLC_CRC32C_LONG_SHIFT2);
+    crc = _volc_crc32c_lanes(crc, &data, &len, VOLC_CRC32C_SHORT_LANE, VOLC_CRC32C_SHORT_SHIFT1, VOLC_CRC32C_SHORT_SHIFT2);
+    crc64 = crc;
+    while (len >= 8) {
+        memcpy(&v, data, sizeof(v));
+        crc64 = _mm_crc32_u64(crc64, v);
+        data += 8;
+        len -= 8;
+    }
+    crc = (uint32_t)crc64;
+    while (len > 0) {
+        crc = _mm_crc32_u8(crc, *data++);
+        len--;
+    }
+    return crc;
+}
+#endif
+#endif
+
+uint32_t volc_crc32(uint32_t crc, const unsigned char* data, size_t len) {
+    if (data == NULL || len == 0) {
+        return crc;
+    }
+    return ~volc_crypto_get_dispatch()->crc32(~crc, data, len);
+}
+
+uint32_t volc_crc32c(uint32_t crc, const unsigned char* data, size_t len) {
+    if (data == NULL || len == 0) {
+        return crc;
+    }
+    return ~volc_crypto_get_dispatch()->crc32c(~crc, data, len);
+}
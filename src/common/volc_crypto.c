@@ -4,16 +4,24 @@
 #include <string.h>
 
 #include <mbedtls/ssl.h>
+#include <mbedtls/aes.h>
 #include <mbedtls/entropy.h>
 #include <mbedtls/ctr_drbg.h>
 #include <mbedtls/error.h>
 #include <mbedtls/sha256.h>
 #include <mbedtls/md5.h>
+#include <mbedtls/platform_util.h>
 
+#include "volc_crypto_internal.h"
 #include "volc_memory.h"
 #include "volc_time.h"
 #include "volc_type.h"
 
+// below this many messages the SHA-1 lanes stay mostly idle and hashing one message at a time is faster
+#define VOLC_SHA1_HMAC_BATCH_MIN_LANES 3
+// AES-CTR jobs built on the stack per call of the interleaved kernel
+#define VOLC_AES_CTR_BATCH_JOBS 32
+
 static uint32_t _volc_dtls_fill_pseudo_randwom_bits(uint8_t* p_buf, uint32_t buf_size) {
     uint32_t ret = VOLC_STATUS_SUCCESS;
     uint32_t i = 0;
@@ -151,6 +159,262 @@ void volc_sha1_hmac(const unsigned char* key, size_t keylen, const unsigned char
     *(plen) = mbedtls_md_get_size(mbedtls_md_info_from_type(MBEDTLS_MD_SHA1));
 }
 
+void volc_sha256(const unsigned char* input, size_t ilen, unsigned char output[VOLC_RTC_SHA256_DIGEST_LENGTH]) {
+    volc_sha_state_t sha;
+
+    volc_sha256_state_init(&sha);
+    volc_sha_state_update(&sha, input, ilen);
+    volc_sha_state_finish(&sha, output);
+    mbedtls_platform_zeroize(&sha, sizeof(sha));
+}
+
+// SHA-1 states after absorbing key ^ ipad and key ^ opad, work holds the message in progress
+typedef struct {
+    volc_sha_state_t inner;
+    volc_sha_state_t outer;
+    volc_sha_state_t work;
+} volc_sha1_hmac_impl_t;
+
+uint32_t volc_sha1_hmac_create(const unsigned char* key, size_t keylen, volc_sha1_hmac_t* p_ctx) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_sha1_hmac_impl_t* p_impl = NULL;
+    volc_sha_state_t key_hash;
+    unsigned char block_key[VOLC_SHA_BLOCK_LENGTH];
+    unsigned char pad[VOLC_SHA_BLOCK_LENGTH];
+    uint32_t i = 0;
+
+    memset(block_key, 0, sizeof(block_key));
+    VOLC_CHK((key != NULL || keylen == 0) && p_ctx != NULL, VOLC_STATUS_NULL_ARG);
+    p_impl = (volc_sha1_hmac_impl_t*)volc_malloc(sizeof(volc_sha1_hmac_impl_t));
+    VOLC_CHK(p_impl != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+
+    // RFC 2104: keys longer than a block are hashed first, shorter ones are zero padded
+    if (keylen > VOLC_SHA_BLOCK_LENGTH) {
+        volc_sha1_state_init(&key_hash);
+        volc_sha_state_update(&key_hash, key, keylen);
+        volc_sha_state_finish(&key_hash, block_key);
+        mbedtls_platform_zeroize(&key_hash, sizeof(key_hash));
+    } else if (keylen > 0) {
+        memcpy(block_key, key, keylen);
+    }
+    for (i = 0; i < VOLC_SHA_BLOCK_LENGTH; i++) {
+        pad[i] = block_key[i] ^ 0x36;
+    }
+    volc_sha1_state_init(&p_impl->inner);
+    volc_sha_state_update(&p_impl->inner, pad, sizeof(pad));
+    for (i = 0; i < VOLC_SHA_BLOCK_LENGTH; i++) {
+        pad[i] = block_key[i] ^ 0x5c;
+    }
+    volc_sha1_state_init(&p_impl->outer);
+    volc_sha_state_update(&p_impl->outer, pad, sizeof(pad));
+    p_impl->work = p_impl->inner;
+    *p_ctx = (volc_sha1_hmac_t)p_impl;
+
+err_out_label:
+    mbedtls_platform_zeroize(block_key, sizeof(block_key));
+    mbedtls_platform_zeroize(pad, sizeof(pad));
+    return ret;
+}
+
+uint32_t volc_sha1_hmac_destroy(volc_sha1_hmac_t ctx) {
+    volc_sha1_hmac_impl_t* p_impl = (volc_sha1_hmac_impl_t*)ctx;
+    if (p_impl == NULL) {
+        return VOLC_STATUS_SUCCESS;
+    }
+    mbedtls_platform_zeroize(p_impl, sizeof(volc_sha1_hmac_impl_t));
+    volc_free(p_impl);
+    return VOLC_STATUS_SUCCESS;
+}
+
+uint32_t volc_sha1_hmac_reset(volc_sha1_hmac_t ctx) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_sha1_hmac_impl_t* p_impl = (volc_sha1_hmac_impl_t*)ctx;
+
+    VOLC_CHK(p_impl != NULL, VOLC_STATUS_NULL_ARG);
+    p_impl->work = p_impl->inner;
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_sha1_hmac_update(volc_sha1_hmac_t ctx, const unsigned char* input, size_t ilen) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_sha1_hmac_impl_t* p_impl = (volc_sha1_hmac_impl_t*)ctx;
+
+    VOLC_CHK(p_impl != NULL && (input != NULL || ilen == 0), VOLC_STATUS_NULL_ARG);
+    volc_sha_state_update(&p_impl->work, input, ilen);
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_sha1_hmac_finish(volc_sha1_hmac_t ctx, unsigned char output[VOLC_RTC_SHA1_DIGEST_LENGTH]) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_sha1_hmac_impl_t* p_impl = (volc_sha1_hmac_impl_t*)ctx;
+    unsigned char inner_hash[VOLC_RTC_SHA1_DIGEST_LENGTH];
+
+    VOLC_CHK(p_impl != NULL && output != NULL, VOLC_STATUS_NULL_ARG);
+    volc_sha_state_finish(&p_impl->work, inner_hash);
+    p_impl->work = p_impl->outer;
+    volc_sha_state_update(&p_impl->work, inner_hash, sizeof(inner_hash));
+    volc_sha_state_finish(&p_impl->work, output);
+    p_impl->work = p_impl->inner;
+    mbedtls_platform_zeroize(inner_hash, sizeof(inner_hash));
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_sha1_hmac_compute(volc_sha1_hmac_t ctx, const unsigned char* input, size_t ilen, unsigned char* output, uint32_t* plen) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+
+    VOLC_CHK_STATUS(volc_sha1_hmac_reset(ctx));
+    VOLC_CHK_STATUS(volc_sha1_hmac_update(ctx, input, ilen));
+    VOLC_CHK_STATUS(volc_sha1_hmac_finish(ctx, output));
+    if (plen != NULL) {
+        *plen = VOLC_RTC_SHA1_DIGEST_LENGTH;
+    }
+
+err_out_label:
+    return ret;
+}
+
+// one message of a batch on its way through a SHA-1 lane
+typedef struct {
+    volc_sha1_hmac_buffer_t* buffer;
+    // whole message blocks not yet compressed, then the padded tail
+    const uint8_t* data;
+    size_t data_blocks;
+    uint8_t tail[2 * VOLC_SHA_BLOCK_LENGTH];
+    size_t tail_blocks;
+    size_t tail_next;
+    bool outer;
+} volc_sha1_hmac_lane_t;
+
+static void _volc_sha1_hmac_lane_pad(volc_sha1_hmac_lane_t* lane, const uint8_t* data, size_t len, uint64_t total_len) {
+    uint64_t bits = total_len * 8;
+    size_t end = 0;
+    int32_t i = 0;
+
+    memset(lane->tail, 0, sizeof(lane->tail));
+    memcpy(lane->tail, data, len);
+    lane->tail[len] = 0x80;
+    lane->tail_blocks = len + 9 <= VOLC_SHA_BLOCK_LENGTH ? 1 : 2;
+    lane->tail_next = 0;
+    end = lane->tail_blocks * VOLC_SHA_BLOCK_LENGTH;
+    for (i = 1; i <= 8; i++) {
+        lane->tail[end - i] = (uint8_t)(bits >> (8 * (i - 1)));
+    }
+}
+
+static void _volc_sha1_hmac_lane_load(uint32_t state[VOLC_SHA1_STATE_WORDS][VOLC_SHA1_LANES], uint32_t lane, const volc_sha_state_t* from) {
+    uint32_t w = 0;
+    for (w = 0; w < VOLC_SHA1_STATE_WORDS; w++) {
+        state[w][lane] = from->state[w];
+    }
+}
+
+static void _volc_sha1_hmac_lane_store(uint32_t state[VOLC_SHA1_STATE_WORDS][VOLC_SHA1_LANES], uint32_t lane, uint8_t* digest) {
+    uint32_t w = 0;
+    for (w = 0; w < VOLC_SHA1_STATE_WORDS; w++) {
+        digest[4 * w] = (uint8_t)(state[w][lane] >> 24);
+        digest[4 * w + 1] = (uint8_t)(state[w][lane] >> 16);
+        digest[4 * w + 2] = (uint8_t)(state[w][lane] >> 8);
+        digest[4 * w + 3] = (uint8_t)state[w][lane];
+    }
+}
+
+// every lane hashes its own message, a lane that finishes picks up the next one so short and long messages mix freely
+static void _volc_sha1_hmac_batch_lanes(volc_sha1_hmac_impl_t* p_impl, volc_sha1_lanes_func_t sha1_lanes, volc_sha1_hmac_buffer_t* buffers, uint32_t count) {
+    static const uint8_t idle_block[VOLC_SHA_BLOCK_LENGTH] = {0};
+    uint32_t state[VOLC_SHA1_STATE_WORDS][VOLC_SHA1_LANES];
+    volc_sha1_hmac_lane_t lanes[VOLC_SHA1_LANES];
+    const uint8_t* blocks[VOLC_SHA1_LANES];
+    uint8_t inner_hash[VOLC_RTC_SHA1_DIGEST_LENGTH];
+    volc_sha1_hmac_lane_t* lane = NULL;
+    uint32_t next = 0;
+    uint32_t active = 0;
+    uint32_t l = 0;
+    size_t whole = 0;
+
+    memset(state, 0, sizeof(state));
+    memset(lanes, 0, sizeof(lanes));
+    while (next < count || active > 0) {
+        for (l = 0; l < VOLC_SHA1_LANES && next < count; l++) {
+            lane = &lanes[l];
+            if (lane->buffer != NULL) {
+                continue;
+            }
+            lane->buffer = &buffers[next++];
+            lane->outer = false;
+            whole = lane->buffer->ilen / VOLC_SHA_BLOCK_LENGTH;
+            lane->data = lane->buffer->input;
+            lane->data_blocks = whole;
+            _volc_sha1_hmac_lane_pad(lane, lane->buffer->input + whole * VOLC_SHA_BLOCK_LENGTH, lane->buffer->ilen - whole * VOLC_SHA_BLOCK_LENGTH,
+                                     VOLC_SHA_BLOCK_LENGTH + (uint64_t)lane->buffer->ilen);
+            _volc_sha1_hmac_lane_load(state, l, &p_impl->inner);
+            active++;
+        }
+        for (l = 0; l < VOLC_SHA1_LANES; l++) {
+            lane = &lanes[l];
+            if (lane->buffer == NULL) {
+                blocks[l] = idle_block;
+            } else if (lane->data_blocks > 0) {
+                blocks[l] = lane->data;
+                lane->data += VOLC_SHA_BLOCK_LENGTH;
+                lane->data_blocks--;
+            } else {
+                blocks[l] = lane->tail + VOLC_SHA_BLOCK_LENGTH * lane->tail_next++;
+            }
+        }
+        sha1_lanes(state, blocks);
+        for (l = 0; l < VOLC_SHA1_LANES; l++) {
+            lane = &lanes[l];
+            if (lane->buffer == NULL || lane->data_blocks > 0 || lane->tail_next < lane->tail_blocks) {
+                continue;
+            }
+            if (lane->outer) {
+                _volc_sha1_hmac_lane_store(state, l, lane->buffer->output);
+                lane->buffer = NULL;
+                active--;
+                continue;
+            }
+            // the outer hash is a single block: the opad state followed by the padded inner digest
+            _volc_sha1_hmac_lane_store(state, l, inner_hash);
+            _volc_sha1_hmac_lane_pad(lane, inner_hash, sizeof(inner_hash), VOLC_SHA_BLOCK_LENGTH + sizeof(inner_hash));
+            _volc_sha1_hmac_lane_load(state, l, &p_impl->outer);
+            lane->outer = true;
+        }
+    }
+    mbedtls_platform_zeroize(state, sizeof(state));
+    mbedtls_platform_zeroize(lanes, sizeof(lanes));
+    mbedtls_platform_zeroize(inner_hash, sizeof(inner_hash));
+}
+
+uint32_t volc_sha1_hmac_compute_batch(volc_sha1_hmac_t ctx, volc_sha1_hmac_buffer_t* buffers, uint32_t count) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_sha1_hmac_impl_t* p_impl = (volc_sha1_hmac_impl_t*)ctx;
+    volc_sha1_lanes_func_t sha1_lanes = volc_crypto_get_dispatch()->sha1_lanes;
+    uint32_t i = 0;
+
+    VOLC_CHK(p_impl != NULL && (buffers != NULL || count == 0), VOLC_STATUS_NULL_ARG);
+    for (i = 0; i < count; i++) {
+        VOLC_CHK(buffers[i].input != NULL || buffers[i].ilen == 0, VOLC_STATUS_NULL_ARG);
+    }
+    p_impl->work = p_impl->inner;
+    if (sha1_lanes != NULL && count >= VOLC_SHA1_HMAC_BATCH_MIN_LANES) {
+        _volc_sha1_hmac_batch_lanes(p_impl, sha1_lanes, buffers, count);
+    } else {
+        for (i = 0; i < count; i++) {
+            volc_sha_state_update(&p_impl->work, buffers[i].input, buffers[i].ilen);
+            VOLC_CHK_STATUS(volc_sha1_hmac_finish(ctx, buffers[i].output));
+        }
+    }
+
+err_out_label:
+    return ret;
+}
+
 uint32_t volc_encrypt_or_decrypt(bool encrypt, const char* key, uint64_t iv_number, const unsigned char* input, uint32_t ilen, unsigned char* output, uint32_t* olen) {
     uint32_t ret = VOLC_STATUS_SUCCESS;
     size_t output_size = 0;
@@ -178,6 +442,88 @@ err_out_label:
     return ret;
 }
 
+uint32_t volc_aes_ctr_create(const char* key, volc_aes_ctr_t* p_ctx) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_aes_ctr_key_t* p_key = NULL;
+
+    VOLC_CHK(key != NULL && p_ctx != NULL, VOLC_STATUS_NULL_ARG);
+    p_key = (volc_aes_ctr_key_t*)volc_malloc(sizeof(volc_aes_ctr_key_t));
+    VOLC_CHK(p_key != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    volc_aes_ctr_key_init(p_key);
+    // CTR only ever runs the forward cipher, so one encryption key schedule serves both directions
+    VOLC_CHK(volc_aes_ctr_key_setkey(p_key, (const uint8_t*)key, VOLC_AES128_KEY_LENGTH * 8) == 0, VOLC_STATUS_INVALID_ARG);
+    *p_ctx = (volc_aes_ctr_t)p_key;
+
+err_out_label:
+    if (VOLC_STATUS_FAILED(ret) && p_key != NULL) {
+        volc_aes_ctr_key_free(p_key);
+        volc_free(p_key);
+    }
+    return ret;
+}
+
+uint32_t volc_aes_ctr_destroy(volc_aes_ctr_t ctx) {
+    volc_aes_ctr_key_t* p_key = (volc_aes_ctr_key_t*)ctx;
+    if (p_key == NULL) {
+        return VOLC_STATUS_SUCCESS;
+    }
+    volc_aes_ctr_key_free(p_key);
+    volc_free(p_key);
+    return VOLC_STATUS_SUCCESS;
+}
+
+static void _volc_aes_ctr_job_init(volc_aes_ctr_job_t* job, uint64_t iv_number, const unsigned char* input, uint32_t ilen, unsigned char* output) {
+    // same counter block layout as volc_encrypt_or_decrypt so both produce identical output
+    uint64_t iv[2] = {iv_number, iv_number};
+
+    memcpy(job->counter, iv, sizeof(job->counter));
+    job->input = input;
+    job->output = output;
+    job->len = ilen;
+}
+
+uint32_t volc_aes_ctr_crypt(volc_aes_ctr_t ctx, uint64_t iv_number, const unsigned char* input, uint32_t ilen, unsigned char* output, uint32_t* olen) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_aes_ctr_job_t job;
+
+    VOLC_CHK(ctx != NULL && input != NULL && output != NULL && olen != NULL, VOLC_STATUS_NULL_ARG);
+    _volc_aes_ctr_job_init(&job, iv_number, input, ilen, output);
+    volc_aes_ctr_key_crypt((volc_aes_ctr_key_t*)ctx, &job, 1);
+    output[ilen] = 0;
+    *olen = ilen;
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_aes_ctr_crypt_batch(volc_aes_ctr_t ctx, volc_aes_ctr_buffer_t* buffers, uint32_t count) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_aes_ctr_job_t jobs[VOLC_AES_CTR_BATCH_JOBS];
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t n = 0;
+
+    VOLC_CHK(ctx != NULL && (buffers != NULL || count == 0), VOLC_STATUS_NULL_ARG);
+    for (i = 0; i < count; i++) {
+        VOLC_CHK(buffers[i].input != NULL && buffers[i].output != NULL, VOLC_STATUS_NULL_ARG);
+    }
+    for (i = 0; i < count; i += n) {
+        n = count - i < VOLC_AES_CTR_BATCH_JOBS ? count - i : VOLC_AES_CTR_BATCH_JOBS;
+        for (j = 0; j < n; j++) {
+            _volc_aes_ctr_job_init(&jobs[j], buffers[i + j].iv, buffers[i + j].input, buffers[i + j].ilen, buffers[i + j].output);
+        }
+        volc_aes_ctr_key_crypt((volc_aes_ctr_key_t*)ctx, jobs, n);
+        // terminators only after the whole chunk, an in-place buffer may be directly followed by the next input
+        for (j = 0; j < n; j++) {
+            buffers[i + j].output[buffers[i + j].ilen] = 0;
+            buffers[i + j].olen = buffers[i + j].ilen;
+        }
+    }
+
+err_out_label:
+    return ret;
+}
+
 uint32_t volc_pk_verify(const char* pub_key, size_t pub_key_len, const char* credential, size_t credential_len, const char* signature, size_t signature_len) {
     uint32_t ret = 0;
     unsigned char hash[MBEDTLS_MD_MAX_SIZE] = { 0 };
@@ -0,0 +1,114 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_crypto_internal.h"
+
+#include <string.h>
+
+// pulls in the mbedtls build configuration, the AES and GHASH backends are decided there
+#include <mbedtls/aes.h>
+
+#include "volc_atomic.h"
+#include "volc_device.h"
+#include "volc_type.h"
+
+static volc_crypto_dispatch_t g_volc_crypto_dispatch;
+static volatile size_t g_volc_crypto_dispatch_ready = 0;
+
+// mirrors the runtime checks mbedtls does itself, so it follows the real CPU and not the mask of the caller
+static void _volc_crypto_select_mbedtls_names(volc_crypto_implementations_t* names, uint32_t features) {
+    names->aes = "portable";
+    names->ghash = "table";
+    VOLC_UNUSED_PARAM(features);
+#if defined(MBEDTLS_AES_ALT)
+    names->aes = "hw-alt";
+#elif defined(MBEDTLS_AESNI_C) && defined(MBEDTLS_HAVE_ASM) && (defined(__x86_64__) || defined(__i386__))
+    if (features & VOLC_CPU_FEATURE_AESNI) {
+        names->aes = "aesni";
+    }
+#elif defined(MBEDTLS_AESCE_C) && defined(__aarch64__)
+    if (features & VOLC_CPU_FEATURE_ARM_AES) {
+        names->aes = "armv8-ce";
+    }
+#endif
+#if defined(MBEDTLS_GCM_ALT)
+    names->ghash = "hw-alt";
+#elif defined(MBEDTLS_AESNI_C) && defined(MBEDTLS_HAVE_ASM) && (defined(__x86_64__) || defined(__i386__))
+    if (features & VOLC_CPU_FEATURE_PCLMULQDQ) {
+        names->ghash = "pclmulqdq";
+    }
+#elif defined(MBEDTLS_AESCE_C) && defined(__aarch64__)
+    if (features & VOLC_CPU_FEATURE_ARM_PMULL) {
+        names->ghash = "armv8-pmull";
+    }
+#endif
+}
+
+static void _volc_crypto_dispatch_select(volc_crypto_dispatch_t* dispatch, uint32_t features) {
+    memset(dispatch, 0, sizeof(volc_crypto_dispatch_t));
+    dispatch->sha1_blocks = volc_sha1_blocks_portable;
+    dispatch->names.sha1 = "portable";
+    dispatch->sha256_blocks = volc_sha256_blocks_portable;
+    dispatch->names.sha256 = "portable";
+    dispatch->crc32 = volc_crc32_update_portable;
+    dispatch->names.crc32 = "slice-by-8";
+    dispatch->crc32c = volc_crc32c_update_portable;
+    dispatch->names.crc32c = "slice-by-8";
+#if defined(VOLC_CRYPTO_X86_KERNELS)
+    if ((features & VOLC_CPU_FEATURE_SHA) && (features & VOLC_CPU_FEATURE_SSE41)) {
+        dispatch->sha1_blocks = volc_sha1_blocks_shani;
+        dispatch->names.sha1 = "sha-ni";
+        dispatch->sha256_blocks = volc_sha256_blocks_shani;
+        dispatch->names.sha256 = "sha-ni";
+    }
+    // SHA-NI hashes a single stream faster than eight AVX2 lanes, the lanes pay off on AVX2 cores without it
+    if ((features & VOLC_CPU_FEATURE_AVX2) && dispatch->sha1_blocks == volc_sha1_blocks_portable) {
+        dispatch->sha1_lanes = volc_sha1_lanes_avx2;
+    }
+    if ((features & VOLC_CPU_FEATURE_AESNI) && (features & VOLC_CPU_FEATURE_SSE41)) {
+        dispatch->aes_expand = volc_aes_expand_aesni;
+        dispatch->aes_ctr_jobs = volc_aes_ctr_jobs_aesni;
+    }
+    if ((features & VOLC_CPU_FEATURE_PCLMULQDQ) && (features & VOLC_CPU_FEATURE_SSE41)) {
+        dispatch->crc32 = volc_crc32_update_pclmul;
+        dispatch->names.crc32 = "pclmulqdq";
+    }
+#if defined(__x86_64__)
+    if ((features & VOLC_CPU_FEATURE_SSE42) && (features & VOLC_CPU_FEATURE_PCLMULQDQ)) {
+        dispatch->crc32c = volc_crc32c_update_sse42;
+        dispatch->names.crc32c = "sse4.2";
+    }
+#endif
+#endif
+    _volc_crypto_select_mbedtls_names(&dispatch->names, volc_get_cpu_features());
+    dispatch->names.aes_ctr = dispatch->aes_ctr_jobs != NULL ? "aesni-x8" : dispatch->names.aes;
+    dispatch->names.sha1_batch = dispatch->sha1_lanes != NULL ? "avx2-x8" : dispatch->names.sha1;
+}
+
+const volc_crypto_dispatch_t* volc_crypto_get_dispatch(void) {
+    // racing first callers fill in identical tables, only the ready flag needs ordering
+    if (volc_atomic_load(&g_volc_crypto_dispatch_ready) == 0) {
+        _volc_crypto_dispatch_select(&g_volc_crypto_dispatch, volc_get_cpu_features());
+        volc_atomic_store(&g_volc_crypto_dispatch_ready, 1);
+    }
+    return &g_volc_crypto_dispatch;
+}
+
+uint32_t volc_crypto_get_implementations(volc_crypto_implementations_t* p_impls) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+
+    VOLC_CHK(p_impls != NULL, VOLC_STATUS_NULL_ARG);
+    *p_impls = volc_crypto_get_dispatch()->names;
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_crypto_select_implementations(uint32_t cpu_features) {
+    // features the CPU does not have are dropped, a forced kernel would fault with SIGILL
+    _volc_crypto_dispatch_select(&g_volc_crypto_dispatch, cpu_features & volc_get_cpu_features());
+    volc_atomic_store(&g_volc_crypto_dispatch_ready, 1);
+    return VOLC_STATUS_SUCCESS;
+}
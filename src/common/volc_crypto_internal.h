@@ -0,0 +1,119 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef __HAL_VOLC_CRYPTO_INTERNAL_H__
+#define __HAL_VOLC_CRYPTO_INTERNAL_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <mbedtls/aes.h>
+
+#include "volc_crypto.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VOLC_SHA_BLOCK_LENGTH   64
+#define VOLC_SHA1_STATE_WORDS   5
+#define VOLC_SHA256_STATE_WORDS 8
+#define VOLC_SHA1_LANES         8
+#define VOLC_AES_BLOCK_LENGTH   16
+#define VOLC_AES_MAX_ROUNDS     14
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+// x86 kernels are compiled with per-function target attributes and only called after the CPU probe allowed them
+#define VOLC_CRYPTO_X86_KERNELS
+#endif
+
+// compresses whole 64 byte blocks into a SHA-1 (5 words) or SHA-256 (8 words) chaining state
+typedef void (*volc_sha_blocks_func_t)(uint32_t* state, const uint8_t* data, size_t blocks);
+
+// one SHA-1 block for each of VOLC_SHA1_LANES independent messages, state is transposed to state[word][lane]
+typedef void (*volc_sha1_lanes_func_t)(uint32_t state[VOLC_SHA1_STATE_WORDS][VOLC_SHA1_LANES], const uint8_t* const blocks[VOLC_SHA1_LANES]);
+
+// one AES-CTR run: len bytes of keystream starting at counter, the 128-bit counter increments big endian
+typedef struct {
+    uint8_t counter[VOLC_AES_BLOCK_LENGTH];
+    const uint8_t* input;
+    uint8_t* output;
+    size_t len;
+} volc_aes_ctr_job_t;
+
+typedef void (*volc_aes_expand_func_t)(const uint8_t* key, uint32_t key_bits, uint8_t* round_keys);
+// runs all jobs with their counter blocks interleaved, so short packets still fill the AES pipeline
+typedef void (*volc_aes_ctr_jobs_func_t)(const uint8_t* round_keys, uint32_t rounds, volc_aes_ctr_job_t* jobs, size_t count);
+
+// advances a raw (not inverted) reflected CRC-32 or CRC-32C register over len bytes
+typedef uint32_t (*volc_crc_func_t)(uint32_t crc, const uint8_t* data, size_t len);
+
+// implementations picked for this CPU, see volc_crypto_dispatch.c
+typedef struct {
+    volc_sha_blocks_func_t sha1_blocks;
+    volc_sha_blocks_func_t sha256_blocks;
+    // NULL when batches are better served by sha1_blocks one message at a time
+    volc_sha1_lanes_func_t sha1_lanes;
+    // NULL without AES-NI, the keys then fall back to mbedtls
+    volc_aes_expand_func_t aes_expand;
+    volc_aes_ctr_jobs_func_t aes_ctr_jobs;
+    volc_crc_func_t crc32;
+    volc_crc_func_t crc32c;
+    volc_crypto_implementations_t names;
+} volc_crypto_dispatch_t;
+
+// selects on first use from volc_get_cpu_features, volc_crypto_select_implementations overrides it
+const volc_crypto_dispatch_t* volc_crypto_get_dispatch(void);
+
+void volc_sha1_blocks_portable(uint32_t* state, const uint8_t* data, size_t blocks);
+void volc_sha256_blocks_portable(uint32_t* state, const uint8_t* data, size_t blocks);
+uint32_t volc_crc32_update_portable(uint32_t crc, const uint8_t* data, size_t len);
+uint32_t volc_crc32c_update_portable(uint32_t crc, const uint8_t* data, size_t len);
+#if defined(VOLC_CRYPTO_X86_KERNELS)
+void volc_sha1_blocks_shani(uint32_t* state, const uint8_t* data, size_t blocks);
+void volc_sha256_blocks_shani(uint32_t* state, const uint8_t* data, size_t blocks);
+void volc_sha1_lanes_avx2(uint32_t state[VOLC_SHA1_STATE_WORDS][VOLC_SHA1_LANES], const uint8_t* const blocks[VOLC_SHA1_LANES]);
+void volc_aes_expand_aesni(const uint8_t* key, uint32_t key_bits, uint8_t* round_keys);
+void volc_aes_ctr_jobs_aesni(const uint8_t* round_keys, uint32_t rounds, volc_aes_ctr_job_t* jobs, size_t count);
+uint32_t volc_crc32_update_pclmul(uint32_t crc, const uint8_t* data, size_t len);
+#if defined(__x86_64__)
+// the 64-bit crc32 instruction only exists in long mode
+uint32_t volc_crc32c_update_sse42(uint32_t crc, const uint8_t* data, size_t len);
+#endif
+#endif
+
+// streaming SHA-1/SHA-256, the block function is bound at init so a state can be copied to resume from a prefix
+typedef struct {
+    uint32_t state[VOLC_SHA256_STATE_WORDS];
+    uint64_t length;
+    uint8_t buffer[VOLC_SHA_BLOCK_LENGTH];
+    uint32_t digest_length;
+    volc_sha_blocks_func_t blocks;
+} volc_sha_state_t;
+
+void volc_sha1_state_init(volc_sha_state_t* sha);
+void volc_sha256_state_init(volc_sha_state_t* sha);
+void volc_sha_state_update(volc_sha_state_t* sha, const uint8_t* data, size_t len);
+// writes digest_length bytes, the state has to be initialized again before reuse
+void volc_sha_state_finish(volc_sha_state_t* sha, uint8_t* digest);
+
+// AES encryption key for CTR mode, expanded by the AES-NI kernel when present and by mbedtls otherwise
+typedef struct {
+    mbedtls_aes_context aes;
+    uint8_t round_keys[(VOLC_AES_MAX_ROUNDS + 1) * VOLC_AES_BLOCK_LENGTH];
+    // 0 when the mbedtls context is used
+    uint32_t rounds;
+    volc_aes_ctr_jobs_func_t ctr_jobs;
+} volc_aes_ctr_key_t;
+
+void volc_aes_ctr_key_init(volc_aes_ctr_key_t* key);
+int volc_aes_ctr_key_setkey(volc_aes_ctr_key_t* key, const uint8_t* key_bytes, uint32_t key_bits);
+void volc_aes_ctr_key_free(volc_aes_ctr_key_t* key);
+void volc_aes_ctr_key_crypt(volc_aes_ctr_key_t* key, volc_aes_ctr_job_t* jobs, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __HAL_VOLC_CRYPTO_INTERNAL_H__ */
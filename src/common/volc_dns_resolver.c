@@ -0,0 +1,360 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_dns_resolver.h"
+
+#include <string.h>
+
+#include "volc_memory.h"
+#include "volc_socket.h"
+#include "volc_time.h"
+#include "volc_type.h"
+
+#define VOLC_DNS_RESOLVER_DEFAULT_CACHE_TTL_MS     60000
+#define VOLC_DNS_RESOLVER_DEFAULT_NEGATIVE_TTL_MS  5000
+#define VOLC_DNS_RESOLVER_DEFAULT_PREFETCH_MS      5000
+#define VOLC_DNS_RESOLVER_DEFAULT_MAX_ENTRIES      64
+
+// index 0 queries AAAA and index 1 queries A, so merged results list IPv6 first
+#define VOLC_DNS_QUERY_FAMILY_COUNT 2
+
+struct volc_dns_resolver_impl;
+struct volc_dns_query;
+
+typedef struct volc_dns_waiter {
+    struct volc_dns_waiter* next;
+    uint16_t port;
+    volc_dns_resolve_callback_t callback;
+    uint64_t custom_data;
+} volc_dns_waiter_t;
+
+typedef struct {
+    struct volc_dns_query* query;
+    uint16_t family;
+    volc_ip_addr_t* addrs;
+    int count;
+} volc_dns_query_half_t;
+
+typedef struct volc_dns_query {
+    struct volc_dns_query* next;
+    struct volc_dns_resolver_impl* resolver;
+    char host[VOLC_DNS_MAX_HOST_NAME_LENGTH + 1];
+    volc_dns_waiter_t* waiters;
+    volc_dns_query_half_t halves[VOLC_DNS_QUERY_FAMILY_COUNT];
+    uint32_t remaining;
+    bool canceled;
+} volc_dns_query_t;
+
+typedef struct {
+    char host[VOLC_DNS_MAX_HOST_NAME_LENGTH + 1];
+    volc_ip_addr_t* addrs;
+    uint32_t count;
+    uint32_t status;
+    uint64_t expire_ms;
+    uint64_t last_used_ms;
+    bool used;
+} volc_dns_cache_entry_t;
+
+typedef struct volc_dns_resolver_impl {
+    volc_worker_pool_t pool;
+    volc_dns_resolver_config_t config;
+    volc_dns_cache_entry_t* entries;
+    volc_dns_query_t* queries;
+} volc_dns_resolver_impl_t;
+
+void volc_dns_resolver_get_default_config(volc_dns_resolver_config_t* config) {
+    if (config == NULL) {
+        return;
+    }
+    config->cache_ttl_ms = VOLC_DNS_RESOLVER_DEFAULT_CACHE_TTL_MS;
+    config->negative_ttl_ms = VOLC_DNS_RESOLVER_DEFAULT_NEGATIVE_TTL_MS;
+    config->prefetch_before_ms = VOLC_DNS_RESOLVER_DEFAULT_PREFETCH_MS;
+    config->max_entries = VOLC_DNS_RESOLVER_DEFAULT_MAX_ENTRIES;
+}
+
+static void _volc_dns_notify(volc_dns_waiter_t* waiter, uint32_t status, volc_ip_addr_t* addrs, uint32_t count) {
+    uint32_t i = 0;
+    uint16_t port = volc_htons(waiter->port);
+    for (i = 0; i < count; i++) {
+        addrs[i].port = port;
+    }
+    waiter->callback(status, count > 0 ? addrs : NULL, count, waiter->custom_data);
+}
+
+static volc_dns_cache_entry_t* _volc_dns_cache_find(volc_dns_resolver_impl_t* p_resolver, const char* host) {
+    uint32_t i = 0;
+    for (i = 0; i < p_resolver->config.max_entries; i++) {
+        if (p_resolver->entries[i].used && strcmp(p_resolver->entries[i].host, host) == 0) {
+            return &p_resolver->entries[i];
+        }
+    }
+    return NULL;
+}
+
+static void _volc_dns_cache_store(volc_dns_resolver_impl_t* p_resolver, const char* host, uint32_t status, volc_ip_addr_t* addrs, uint32_t count) {
+    volc_dns_cache_entry_t* entry = _volc_dns_cache_find(p_resolver, host);
+    uint64_t now = volc_get_montionic_time_ms();
+    uint32_t ttl = VOLC_STATUS_SUCCEEDED(status) ? p_resolver->config.cache_ttl_ms : p_resolver->config.negative_ttl_ms;
+    uint32_t i = 0;
+
+    if (ttl == 0) {
+        return;
+    }
+    if (entry == NULL) {
+        // reuse a free slot, otherwise evict the least recently used host
+        entry = &p_resolver->entries[0];
+        for (i = 0; i < p_resolver->config.max_entries && entry->used; i++) {
+            volc_dns_cache_entry_t* candidate = &p_resolver->entries[i];
+            if (!candidate->used || candidate->last_used_ms < entry->last_used_ms) {
+                entry = candidate;
+            }
+        }
+        VOLC_SAFE_MEMFREE(entry->addrs);
+        memset(entry, 0, sizeof(volc_dns_cache_entry_t));
+        strncpy(entry->host, host, VOLC_DNS_MAX_HOST_NAME_LENGTH);
+        entry->used = true;
+        entry->last_used_ms = now;
+    }
+
+    VOLC_SAFE_MEMFREE(entry->addrs);
+    entry->count = 0;
+    if (count > 0) {
+        entry->addrs = (volc_ip_addr_t*)volc_malloc(sizeof(volc_ip_addr_t) * count);
+        if (entry->addrs == NULL) {
+            entry->used = false;
+            return;
+        }
+        memcpy(entry->addrs, addrs, sizeof(volc_ip_addr_t) * count);
+        entry->count = count;
+    }
+    entry->status = status;
+    entry->expire_ms = now + ttl;
+}
+
+static uint32_t _volc_dns_query_task(void* arg) {
+    volc_dns_query_half_t* half = (volc_dns_query_half_t*)arg;
+    if (volc_getaddrinfo_with_family(half->query->host, 0, half->family, &half->addrs, &half->count) != 0) {
+        half->addrs = NULL;
+        half->count = 0;
+        return VOLC_STATUS_RESOLVE_HOSTNAME_FAILED;
+    }
+    return VOLC_STATUS_SUCCESS;
+}
+
+static void _volc_dns_query_finish(volc_dns_query_t* query) {
+    volc_dns_resolver_impl_t* p_resolver = query->resolver;
+    volc_dns_query_t** pp = NULL;
+    volc_dns_waiter_t* waiter = NULL;
+    volc_ip_addr_t* addrs = NULL;
+    uint32_t count = 0;
+    uint32_t status = VOLC_STATUS_SUCCESS;
+    uint32_t i = 0;
+
+    for (i = 0; i < VOLC_DNS_QUERY_FAMILY_COUNT; i++) {
+        count += (uint32_t)query->halves[i].count;
+    }
+    if (count > 0) {
+        addrs = (volc_ip_addr_t*)volc_malloc(sizeof(volc_ip_addr_t) * count);
+    }
+    count = 0;
+    for (i = 0; i < VOLC_DNS_QUERY_FAMILY_COUNT && addrs != NULL; i++) {
+        if (query->halves[i].count > 0) {
+            memcpy(&addrs[count], query->halves[i].addrs, sizeof(volc_ip_addr_t) * query->halves[i].count);
+            count += (uint32_t)query->halves[i].count;
+        }
+    }
+    status = query->canceled ? VOLC_STATUS_USER_CANCELED : (count > 0 ? VOLC_STATUS_SUCCESS : VOLC_STATUS_RESOLVE_HOSTNAME_FAILED);
+
+    if (p_resolver != NULL) {
+        for (pp = &p_resolver->queries; *pp != NULL; pp = &(*pp)->next) {
+            if (*pp == query) {
+                *pp = query->next;
+                break;
+            }
+        }
+        if (!query->canceled) {
+            _volc_dns_cache_store(p_resolver, query->host, status, addrs, count);
+        }
+    }
+
+    while (query->waiters != NULL) {
+        waiter = query->waiters;
+        query->waiters = waiter->next;
+        _volc_dns_notify(waiter, status, addrs, count);
+        volc_free(waiter);
+    }
+
+    VOLC_SAFE_MEMFREE(addrs);
+    for (i = 0; i < VOLC_DNS_QUERY_FAMILY_COUNT; i++) {
+        if (query->halves[i].addrs != NULL) {
+            volc_freeaddrinfo(query->halves[i].addrs);
+        }
+    }
+    volc_free(query);
+}
+
+static void _volc_dns_query_done(void* arg, uint32_t status) {
+    volc_dns_query_half_t* half = (volc_dns_query_half_t*)arg;
+    volc_dns_query_t* query = half->query;
+    if (status == VOLC_STATUS_USER_CANCELED) {
+        query->canceled = true;
+    }
+    if (--query->remaining == 0) {
+        _volc_dns_query_finish(query);
+    }
+}
+
+static uint32_t _volc_dns_query_start(volc_dns_resolver_impl_t* p_resolver, const char* host, volc_dns_query_t** p_query) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_dns_query_t* query = NULL;
+    uint32_t i = 0;
+
+    query = (volc_dns_query_t*)volc_malloc(sizeof(volc_dns_query_t));
+    VOLC_CHK(query != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    memset(query, 0, sizeof(volc_dns_query_t));
+    strncpy(query->host, host, VOLC_DNS_MAX_HOST_NAME_LENGTH);
+    query->resolver = p_resolver;
+    query->halves[0].family = VOLC_IP_FAMILY_TYPE_IPV6;
+    query->halves[1].family = VOLC_IP_FAMILY_TYPE_IPV4;
+    query->next = p_resolver->queries;
+    p_resolver->queries = query;
+
+    for (i = 0; i < VOLC_DNS_QUERY_FAMILY_COUNT; i++) {
+        query->halves[i].query = query;
+        query->remaining++;
+        if (VOLC_STATUS_FAILED(volc_worker_pool_submit(p_resolver->pool, _volc_dns_query_task, _volc_dns_query_done, &query->halves[i]))) {
+            // finish on the loop thread as if this family returned nothing
+            query->remaining--;
+        }
+    }
+    if (query->remaining == 0) {
+        p_resolver->queries = query->next;
+        volc_free(query);
+        query = NULL;
+        VOLC_CHK(0, VOLC_STATUS_INVALID_OPERATION);
+    }
+    *p_query = query;
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_dns_resolver_create(volc_worker_pool_t pool, const volc_dns_resolver_config_t* config, volc_dns_resolver_t* p_resolver) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_dns_resolver_impl_t* p_impl = NULL;
+
+    VOLC_CHK(pool != NULL && p_resolver != NULL, VOLC_STATUS_NULL_ARG);
+    p_impl = (volc_dns_resolver_impl_t*)volc_malloc(sizeof(volc_dns_resolver_impl_t));
+    VOLC_CHK(p_impl != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    memset(p_impl, 0, sizeof(volc_dns_resolver_impl_t));
+    p_impl->pool = pool;
+    if (config != NULL) {
+        p_impl->config = *config;
+    } else {
+        volc_dns_resolver_get_default_config(&p_impl->config);
+    }
+    p_impl->config.max_entries = VOLC_MAX(1, p_impl->config.max_entries);
+    p_impl->entries = (volc_dns_cache_entry_t*)volc_malloc(sizeof(volc_dns_cache_entry_t) * p_impl->config.max_entries);
+    VOLC_CHK(p_impl->entries != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    memset(p_impl->entries, 0, sizeof(volc_dns_cache_entry_t) * p_impl->config.max_entries);
+    *p_resolver = (volc_dns_resolver_t)p_impl;
+
+err_out_label:
+    if (VOLC_STATUS_FAILED(ret) && p_impl != NULL) {
+        VOLC_SAFE_MEMFREE(p_impl->entries);
+        volc_free(p_impl);
+    }
+    return ret;
+}
+
+uint32_t volc_dns_resolver_destroy(volc_dns_resolver_t resolver) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_dns_resolver_impl_t* p_resolver = (volc_dns_resolver_impl_t*)resolver;
+    volc_dns_query_t* query = NULL;
+    volc_dns_waiter_t* waiter = NULL;
+
+    VOLC_CHK(p_resolver != NULL, VOLC_STATUS_NULL_ARG);
+    // in-flight queries are owned by the worker pool until both lookups complete
+    for (query = p_resolver->queries; query != NULL; query = query->next) {
+        query->resolver = NULL;
+        while (query->waiters != NULL) {
+            waiter = query->waiters;
+            query->waiters = waiter->next;
+            waiter->callback(VOLC_STATUS_USER_CANCELED, NULL, 0, waiter->custom_data);
+            volc_free(waiter);
+        }
+    }
+    volc_dns_resolver_clear_cache(resolver);
+    volc_free(p_resolver->entries);
+    volc_free(p_resolver);
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_dns_resolver_resolve(volc_dns_resolver_t resolver, const char* host, uint16_t port, volc_dns_resolve_callback_t callback, uint64_t custom_data) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_dns_resolver_impl_t* p_resolver = (volc_dns_resolver_impl_t*)resolver;
+    volc_dns_cache_entry_t* entry = NULL;
+    volc_dns_query_t* query = NULL;
+    volc_dns_waiter_t* waiter = NULL;
+    volc_dns_waiter_t hit;
+    uint64_t now = volc_get_montionic_time_ms();
+
+    VOLC_CHK(p_resolver != NULL && host != NULL && callback != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK(strlen(host) <= VOLC_DNS_MAX_HOST_NAME_LENGTH, VOLC_STATUS_INVALID_ARG_LEN);
+
+    for (query = p_resolver->queries; query != NULL; query = query->next) {
+        if (strcmp(query->host, host) == 0) {
+            break;
+        }
+    }
+
+    entry = _volc_dns_cache_find(p_resolver, host);
+    if (entry != NULL && now < entry->expire_ms) {
+        entry->last_used_ms = now;
+        if (query == NULL && VOLC_STATUS_SUCCEEDED(entry->status) && p_resolver->config.prefetch_before_ms > 0 &&
+            entry->expire_ms - now <= p_resolver->config.prefetch_before_ms) {
+            // refresh in the background so callers never wait on a popular host
+            _volc_dns_query_start(p_resolver, host, &query);
+        }
+        hit.port = port;
+        hit.callback = callback;
+        hit.custom_data = custom_data;
+        _volc_dns_notify(&hit, entry->status, entry->addrs, entry->count);
+        goto err_out_label;
+    }
+
+    waiter = (volc_dns_waiter_t*)volc_malloc(sizeof(volc_dns_waiter_t));
+    VOLC_CHK(waiter != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    waiter->port = port;
+    waiter->callback = callback;
+    waiter->custom_data = custom_data;
+    if (query == NULL) {
+        ret = _volc_dns_query_start(p_resolver, host, &query);
+        if (VOLC_STATUS_FAILED(ret)) {
+            volc_free(waiter);
+            goto err_out_label;
+        }
+    }
+    waiter->next = query->waiters;
+    query->waiters = waiter;
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_dns_resolver_clear_cache(volc_dns_resolver_t resolver) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_dns_resolver_impl_t* p_resolver = (volc_dns_resolver_impl_t*)resolver;
+    uint32_t i = 0;
+
+    VOLC_CHK(p_resolver != NULL, VOLC_STATUS_NULL_ARG);
+    for (i = 0; i < p_resolver->config.max_entries; i++) {
+        VOLC_SAFE_MEMFREE(p_resolver->entries[i].addrs);
+        p_resolver->entries[i].used = false;
+    }
+err_out_label:
+    return ret;
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_happy_eyeballs.h"
+
+#include <string.h>
+
+#include "volc_memory.h"
+#include "volc_socket.h"
+#include "volc_time.h"
+#include "volc_type.h"
+
+#define VOLC_HAPPY_EYEBALLS_DEFAULT_ATTEMPT_DELAY_MS 250
+#define VOLC_HAPPY_EYEBALLS_MIN_ATTEMPT_DELAY_MS     10
+#define VOLC_HAPPY_EYEBALLS_DEFAULT_TIMEOUT_MS       10000
+
+typedef struct {
+    int sockfd;
+    uint32_t index;
+} volc_happy_eyeballs_attempt_t;
+
+void volc_happy_eyeballs_get_default_config(volc_happy_eyeballs_config_t* config) {
+    if (config == NULL) {
+        return;
+    }
+    config->connection_attempt_delay_ms = VOLC_HAPPY_EYEBALLS_DEFAULT_ATTEMPT_DELAY_MS;
+    config->timeout_ms = VOLC_HAPPY_EYEBALLS_DEFAULT_TIMEOUT_MS;
+    config->max_attempts = VOLC_HAPPY_EYEBALLS_MAX_ATTEMPTS;
+    config->prefer_ipv6 = true;
+}
+
+// RFC 8305 section 4: interleave address families, starting with the preferred one
+static void _volc_happy_eyeballs_sort(const volc_ip_addr_t* addrs, uint32_t count, bool prefer_ipv6, volc_ip_addr_t* sorted) {
+    uint16_t first_family = prefer_ipv6 ? VOLC_IP_FAMILY_TYPE_IPV6 : addrs[0].family;
+    uint32_t first = 0;
+    uint32_t second = 0;
+    uint32_t n = 0;
+    bool take_first = true;
+
+    while (n < count) {
+        while (first < count && addrs[first].family != first_family) {
+            first++;
+        }
+        while (second < count && addrs[second].family == first_family) {
+            second++;
+        }
+        if ((take_first && first < count) || second >= count) {
+            sorted[n++] = addrs[first++];
+        } else {
+            sorted[n++] = addrs[second++];
+        }
+        take_first = !take_first;
+    }
+}
+
+static uint32_t _volc_happy_eyeballs_start(const volc_ip_addr_t* addr, int* p_sockfd) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    int sockfd = volc_socket(addr->family, VOLC_SOCK_STREAM, 0);
+
+    VOLC_CHK(sockfd >= 0, VOLC_STATUS_SOCKET_CONNECT_FAILED);
+    VOLC_CHK(volc_set_nonblocking(sockfd) == 0, VOLC_STATUS_SET_SOCKET_FLAG_FAILED);
+    ret = volc_connect(sockfd, (volc_ip_addr_t*)addr);
+    VOLC_CHK(ret != VOLC_STATUS_EVLOOP_PERFORM_FAILED, VOLC_STATUS_SOCKET_CONNECT_FAILED);
+    *p_sockfd = sockfd;
+err_out_label:
+    if (VOLC_STATUS_FAILED(ret) && ret != VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY && sockfd >= 0) {
+        volc_close(sockfd);
+    }
+    return ret;
+}
+
+uint32_t volc_happy_eyeballs_connect_addrs(const volc_ip_addr_t* addrs, uint32_t count, const volc_happy_eyeballs_config_t* config, int* p_sockfd, volc_ip_addr_t* p_addr) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_happy_eyeballs_config_t cfg;
+    volc_happy_eyeballs_attempt_t attempts[VOLC_HAPPY_EYEBALLS_MAX_ATTEMPTS];
+    struct volc_pollfd pfds[VOLC_HAPPY_EYEBALLS_MAX_ATTEMPTS];
+    volc_ip_addr_t* sorted = NULL;
+    uint32_t active = 0;
+    uint32_t next = 0;
+    uint32_t i = 0;
+    uint32_t status = VOLC_STATUS_SUCCESS;
+    uint64_t now = volc_get_montionic_time_ms();
+    uint64_t deadline = 0;
+    uint64_t next_start = now;
+    uint64_t wait = 0;
+    int winner = -1;
+    uint32_t winner_index = 0;
+
+    VOLC_CHK(addrs != NULL && count > 0 && p_sockfd != NULL, VOLC_STATUS_NULL_ARG);
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        volc_happy_eyeballs_get_default_config(&cfg);
+    }
+    cfg.connection_attempt_delay_ms = VOLC_MAX(cfg.connection_attempt_delay_ms, VOLC_HAPPY_EYEBALLS_MIN_ATTEMPT_DELAY_MS);
+    cfg.max_attempts = VOLC_MAX(1, VOLC_MIN(cfg.max_attempts, VOLC_HAPPY_EYEBALLS_MAX_ATTEMPTS));
+    deadline = now + cfg.timeout_ms;
+
+    sorted = (volc_ip_addr_t*)volc_malloc(sizeof(volc_ip_addr_t) * count);
+    VOLC_CHK(sorted != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    _volc_happy_eyeballs_sort(addrs, count, cfg.prefer_ipv6, sorted);
+
+    while (winner < 0) {
+        now = volc_get_montionic_time_ms();
+        // start the next candidate when the attempt delay expired, or right away if nothing is in flight
+        while (next < count && active < cfg.max_attempts && (active == 0 || now >= next_start)) {
+            int sockfd = -1;
+            status = _volc_happy_eyeballs_start(&sorted[next], &sockfd);
+            if (status == VOLC_STATUS_SUCCESS) {
+                winner = sockfd;
+                winner_index = next;
+                break;
+            }
+            if (status == VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY) {
+                attempts[active].sockfd = sockfd;
+                attempts[active].index = next;
+                active++;
+                next_start = now + cfg.connection_attempt_delay_ms;
+            }
+            next++;
+        }
+        if (winner >= 0) {
+            break;
+        }
+        VOLC_CHK(active > 0, VOLC_STATUS_SOCKET_CONNECT_FAILED);
+        VOLC_CHK(now < deadline, VOLC_STATUS_OPERATION_TIMED_OUT);
+
+        wait = deadline - now;
+        if (next < count && active < cfg.max_attempts) {
+            wait = VOLC_MIN(wait, next_start > now ? next_start - now : 0);
+        }
+        for (i = 0; i < active; i++) {
+            pfds[i].fd = attempts[i].sockfd;
+            pfds[i].events = VOLC_EVLOOP_POLLOUT;
+            pfds[i].revents = 0;
+        }
+        if (volc_poll(pfds, (int)active, (int)wait) <= 0) {
+            continue;
+        }
+
+        for (i = 0; i < active && winner < 0;) {
+            if (pfds[i].revents == 0) {
+                i++;
+                continue;
+            }
+            status = volc_connect_check(attempts[i].sockfd, VOLC_INFINITE_TIME_VALUE);
+            if (status == VOLC_STATUS_SUCCESS) {
+                winner = attempts[i].sockfd;
+                winner_index = attempts[i].index;
+            } else if (status != VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY) {
+                // a failed attempt lets the next candidate start without waiting for the delay
+                volc_close(attempts[i].sockfd);
+                active--;
+                attempts[i] = attempts[active];
+                pfds[i] = pfds[active];
+                next_start = now;
+                continue;
+            }
+            if (winner < 0) {
+                i++;
+            } else {
+                attempts[i] = attempts[--active];
+            }
+        }
+    }
+
+    *p_sockfd = winner;
+    if (p_addr != NULL) {
+        *p_addr = sorted[winner_index];
+    }
+
+err_out_label:
+    for (i = 0; i < active; i++) {
+        volc_close(attempts[i].sockfd);
+    }
+    VOLC_SAFE_MEMFREE(sorted);
+    return ret;
+}
+
+uint32_t volc_happy_eyeballs_connect(const char* host, uint16_t port, const volc_happy_eyeballs_config_t* config, int* p_sockfd, volc_ip_addr_t* p_addr) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_ip_addr_t* addrs = NULL;
+    int count = 0;
+
+    VOLC_CHK(host != NULL && p_sockfd != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK(volc_getaddrinfo(host, port, &addrs, &count) == 0 && count > 0, VOLC_STATUS_RESOLVE_HOSTNAME_FAILED);
+    ret = volc_happy_eyeballs_connect_addrs(addrs, (uint32_t)count, config, p_sockfd, p_addr);
+
+err_out_label:
+    if (addrs != NULL) {
+        volc_freeaddrinfo(addrs);
+    }
+    return ret;
+}
@@ -0,0 +1,395 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_send_scheduler.h"
+
+#include <string.h>
+
+#include "volc_memory.h"
+#include "volc_mutex.h"
+#include "volc_socket.h"
+#include "volc_time.h"
+#include "volc_type.h"
+
+#define VOLC_SEND_SCHEDULER_DEFAULT_WEIGHT 1500
+
+typedef struct volc_send_packet {
+    struct volc_send_packet* next;
+    uint64_t enqueue_time_ms;
+    volc_ip_addr_t addr;
+    bool has_addr;
+    size_t size;
+    size_t offset;
+    uint8_t data[];
+} volc_send_packet_t;
+
+typedef struct {
+    volc_send_packet_t* head;
+    volc_send_packet_t* tail;
+    uint32_t packets;
+    uint32_t bytes;
+    uint32_t deficit;
+} volc_send_queue_t;
+
+typedef struct {
+    int sockfd;
+    volc_mutex_t lock;
+    volc_send_scheduler_config_t config;
+    volc_send_queue_t queues[VOLC_SEND_PRIORITY_COUNT];
+    uint32_t total_packets;
+    uint32_t rr_index;
+    bool rr_credited;
+    volc_send_scheduler_stats_t stats;
+} volc_send_scheduler_ctx_t;
+
+void volc_send_scheduler_get_default_config(volc_send_scheduler_config_t* config) {
+    if (NULL == config) {
+        return;
+    }
+    memset(config, 0, sizeof(volc_send_scheduler_config_t));
+    config->mode = VOLC_SEND_SCHEDULE_STRICT;
+
+    config->queues[VOLC_SEND_PRIORITY_AUDIO].max_packets = 64;
+    config->queues[VOLC_SEND_PRIORITY_AUDIO].max_delay_ms = 200;
+    config->queues[VOLC_SEND_PRIORITY_AUDIO].weight = 4 * VOLC_SEND_SCHEDULER_DEFAULT_WEIGHT;
+    config->queues[VOLC_SEND_PRIORITY_AUDIO].drop_policy = VOLC_SEND_DROP_OLDEST;
+
+    config->queues[VOLC_SEND_PRIORITY_VIDEO].max_packets = 512;
+    config->queues[VOLC_SEND_PRIORITY_VIDEO].max_bytes = 512 * 1024;
+    config->queues[VOLC_SEND_PRIORITY_VIDEO].max_delay_ms = 500;
+    config->queues[VOLC_SEND_PRIORITY_VIDEO].weight = 2 * VOLC_SEND_SCHEDULER_DEFAULT_WEIGHT;
+    config->queues[VOLC_SEND_PRIORITY_VIDEO].drop_policy = VOLC_SEND_DROP_OLDEST;
+
+    config->queues[VOLC_SEND_PRIORITY_DATA].max_packets = 256;
+    config->queues[VOLC_SEND_PRIORITY_DATA].max_bytes = 256 * 1024;
+    config->queues[VOLC_SEND_PRIORITY_DATA].weight = VOLC_SEND_SCHEDULER_DEFAULT_WEIGHT;
+    config->queues[VOLC_SEND_PRIORITY_DATA].drop_policy = VOLC_SEND_DROP_NEWEST;
+}
+
+static void _volc_send_queue_pop(volc_send_scheduler_ctx_t* ctx, uint32_t priority) {
+    volc_send_queue_t* queue = &ctx->queues[priority];
+    volc_send_packet_t* packet = queue->head;
+    if (NULL == packet) {
+        return;
+    }
+    queue->head = packet->next;
+    if (NULL == queue->head) {
+        queue->tail = NULL;
+    }
+    queue->packets--;
+    queue->bytes -= (uint32_t) packet->size;
+    ctx->total_packets--;
+    volc_free(packet);
+}
+
+static void _volc_send_queue_drop_head(volc_send_scheduler_ctx_t* ctx, uint32_t priority) {
+    ctx->stats.dropped_packets[priority]++;
+    _volc_send_queue_pop(ctx, priority);
+}
+
+/* a partially written packet must never be dropped, otherwise a stream socket would be corrupted */
+static bool _volc_send_queue_head_droppable(volc_send_queue_t* queue) {
+    return queue->head != NULL && queue->head->offset == 0;
+}
+
+static void _volc_send_queue_drop_expired(volc_send_scheduler_ctx_t* ctx, uint32_t priority, uint64_t now_ms) {
+    volc_send_queue_t* queue = &ctx->queues[priority];
+    uint32_t max_delay_ms = ctx->config.queues[priority].max_delay_ms;
+    if (0 == max_delay_ms) {
+        return;
+    }
+    while (_volc_send_queue_head_droppable(queue) && queue->head->enqueue_time_ms + max_delay_ms < now_ms) {
+        _volc_send_queue_drop_head(ctx, priority);
+    }
+}
+
+static bool _volc_send_queue_is_full(volc_send_scheduler_ctx_t* ctx, uint32_t priority, size_t size) {
+    volc_send_queue_t* queue = &ctx->queues[priority];
+    volc_send_queue_config_t* config = &ctx->config.queues[priority];
+    if (config->max_packets != 0 && queue->packets + 1 > config->max_packets) {
+        return true;
+    }
+    if (config->max_bytes != 0 && queue->bytes + size > config->max_bytes) {
+        return true;
+    }
+    return false;
+}
+
+static uint32_t _volc_send_queue_push(volc_send_scheduler_ctx_t* ctx, uint32_t priority, const void* data, size_t size, size_t offset,
+                                      const volc_ip_addr_t* addr, uint64_t now_ms) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_send_queue_t* queue = &ctx->queues[priority];
+    volc_send_packet_t* packet = NULL;
+
+    _volc_send_queue_drop_expired(ctx, priority, now_ms);
+    // the remainder of a partially written packet is always kept, dropping it would corrupt a stream socket
+    while (0 == offset && _volc_send_queue_is_full(ctx, priority, size)) {
+        VOLC_CHK(ctx->config.queues[priority].drop_policy == VOLC_SEND_DROP_OLDEST && _volc_send_queue_head_droppable(queue),
+                 VOLC_STATUS_SEND_QUEUE_FULL);
+        _volc_send_queue_drop_head(ctx, priority);
+    }
+
+    packet = (volc_send_packet_t*) volc_malloc(sizeof(volc_send_packet_t) + size);
+    VOLC_CHK(packet != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    packet->next = NULL;
+    packet->enqueue_time_ms = now_ms;
+    packet->has_addr = (addr != NULL);
+    if (addr != NULL) {
+        packet->addr = *addr;
+    }
+    packet->size = size;
+    packet->offset = offset;
+    memcpy(packet->data, data, size);
+
+    if (NULL == queue->tail) {
+        queue->head = packet;
+    } else {
+        queue->tail->next = packet;
+    }
+    queue->tail = packet;
+    queue->packets++;
+    queue->bytes += (uint32_t) size;
+    ctx->total_packets++;
+
+err_out_label:
+    if (VOLC_STATUS_FAILED(ret)) {
+        ctx->stats.dropped_packets[priority]++;
+    }
+    return ret;
+}
+
+static uint32_t _volc_send_scheduler_next_queue(volc_send_scheduler_ctx_t* ctx) {
+    uint32_t i = 0;
+    volc_send_queue_t* queue = NULL;
+    uint32_t weight = 0;
+
+    /* the rest of a partially written packet goes first regardless of priority and deficit, interleaving other
+       bytes into it would corrupt a stream socket; at most one queue can have such a head */
+    for (i = 0; i < VOLC_SEND_PRIORITY_COUNT; i++) {
+        if (ctx->queues[i].head != NULL && ctx->queues[i].head->offset != 0) {
+            return i;
+        }
+    }
+
+    if (ctx->config.mode == VOLC_SEND_SCHEDULE_STRICT) {
+        for (i = 0; i < VOLC_SEND_PRIORITY_COUNT; i++) {
+            if (ctx->queues[i].head != NULL) {
+                return i;
+            }
+        }
+        return VOLC_SEND_PRIORITY_COUNT;
+    }
+
+    /* deficit round robin, every visit credits one quantum until the head packet fits */
+    for (;;) {
+        queue = &ctx->queues[ctx->rr_index];
+        if (NULL == queue->head) {
+            queue->deficit = 0;
+        } else {
+            if (!ctx->rr_credited) {
+                weight = ctx->config.queues[ctx->rr_index].weight;
+                queue->deficit += VOLC_MAX(weight, 1);
+                ctx->rr_credited = true;
+            }
+            if (queue->head->size - queue->head->offset <= queue->deficit) {
+                return ctx->rr_index;
+            }
+        }
+        ctx->rr_index = (ctx->rr_index + 1) % VOLC_SEND_PRIORITY_COUNT;
+        ctx->rr_credited = false;
+    }
+}
+
+static uint32_t _volc_send_scheduler_send_packet(volc_send_scheduler_ctx_t* ctx, uint32_t priority) {
+    volc_send_queue_t* queue = &ctx->queues[priority];
+    volc_send_packet_t* packet = queue->head;
+    uint32_t status = VOLC_STATUS_SUCCESS;
+    size_t remaining = packet->size - packet->offset;
+    ssize_t sent = volc_send_msg(ctx->sockfd, packet->data + packet->offset, remaining, packet->has_addr ? &packet->addr : NULL, &status);
+
+    if (status == VOLC_STATUS_MESSAGE_TOO_BIG && packet->offset == 0) {
+        // the path mtu shrank while the packet was queued, it can never be sent as is
+        _volc_send_queue_drop_head(ctx, priority);
+        return VOLC_STATUS_SUCCESS;
+    }
+    if (VOLC_STATUS_FAILED(status)) {
+        return status;
+    }
+    if (sent > 0 && (size_t) sent < remaining) {
+        packet->offset += (size_t) sent;
+        if (queue->deficit >= (uint32_t) sent) {
+            queue->deficit -= (uint32_t) sent;
+        }
+        return VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY;
+    }
+    if (queue->deficit >= (uint32_t) remaining) {
+        queue->deficit -= (uint32_t) remaining;
+    } else {
+        queue->deficit = 0;
+    }
+    ctx->stats.sent_packets[priority]++;
+    ctx->stats.sent_bytes[priority] += packet->size;
+    _volc_send_queue_pop(ctx, priority);
+    return VOLC_STATUS_SUCCESS;
+}
+
+static uint32_t _volc_send_scheduler_drain_locked(volc_send_scheduler_ctx_t* ctx) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    uint32_t priority = 0;
+    uint64_t now_ms = volc_get_montionic_time_ms();
+
+    for (priority = 0; priority < VOLC_SEND_PRIORITY_COUNT; priority++) {
+        _volc_send_queue_drop_expired(ctx, priority, now_ms);
+    }
+
+    while (ctx->total_packets > 0) {
+        priority = _volc_send_scheduler_next_queue(ctx);
+        if (priority >= VOLC_SEND_PRIORITY_COUNT) {
+            break;
+        }
+        ret = _volc_send_scheduler_send_packet(ctx, priority);
+        if (VOLC_STATUS_FAILED(ret)) {
+            break;
+        }
+    }
+    return ret;
+}
+
+uint32_t volc_send_scheduler_create(int sockfd, const volc_send_scheduler_config_t* config, volc_send_scheduler_t* p_scheduler) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_send_scheduler_ctx_t* ctx = NULL;
+
+    VOLC_CHK(p_scheduler != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK(sockfd >= 0, VOLC_STATUS_INVALID_ARG);
+    ctx = (volc_send_scheduler_ctx_t*) volc_calloc(1, sizeof(volc_send_scheduler_ctx_t));
+    VOLC_CHK(ctx != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    ctx->lock = volc_mutex_create(false);
+    VOLC_CHK(ctx->lock != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    ctx->sockfd = sockfd;
+    if (config != NULL) {
+        ctx->config = *config;
+    } else {
+        volc_send_scheduler_get_default_config(&ctx->config);
+    }
+    *p_scheduler = (volc_send_scheduler_t) ctx;
+    return ret;
+
+err_out_label:
+    if (ctx != NULL) {
+        volc_free(ctx);
+    }
+    return ret;
+}
+
+uint32_t volc_send_scheduler_destroy(volc_send_scheduler_t scheduler) {
+    volc_send_scheduler_ctx_t* ctx = (volc_send_scheduler_ctx_t*) scheduler;
+    uint32_t priority = 0;
+    if (NULL == ctx) {
+        return VOLC_STATUS_SUCCESS;
+    }
+    for (priority = 0; priority < VOLC_SEND_PRIORITY_COUNT; priority++) {
+        while (ctx->queues[priority].head != NULL) {
+            _volc_send_queue_pop(ctx, priority);
+        }
+    }
+    volc_mutex_destroy(ctx->lock);
+    volc_free(ctx);
+    return VOLC_STATUS_SUCCESS;
+}
+
+uint32_t volc_send_scheduler_send(volc_send_scheduler_t scheduler, volc_send_priority_e priority, const void* data, size_t size, const volc_ip_addr_t* addr) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    uint32_t status = VOLC_STATUS_SUCCESS;
+    volc_send_scheduler_ctx_t* ctx = (volc_send_scheduler_ctx_t*) scheduler;
+    ssize_t sent = 0;
+    bool locked = false;
+
+    VOLC_CHK(ctx != NULL && data != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK((uint32_t) priority < VOLC_SEND_PRIORITY_COUNT, VOLC_STATUS_INVALID_ARG);
+    volc_mutex_lock(ctx->lock);
+    locked = true;
+
+    if (0 == ctx->total_packets) {
+        sent = volc_send_msg(ctx->sockfd, (void*) data, size, (volc_ip_addr_t*) addr, &status);
+        if (VOLC_STATUS_SUCCEEDED(status) && sent >= 0 && (size_t) sent >= size) {
+            ctx->stats.sent_packets[priority]++;
+            ctx->stats.sent_bytes[priority] += size;
+            goto err_out_label;
+        }
+        VOLC_CHK(status == VOLC_STATUS_SUCCESS || status == VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY, status);
+        VOLC_CHK_STATUS(_volc_send_queue_push(ctx, priority, data, size, sent > 0 ? (size_t) sent : 0, addr, volc_get_montionic_time_ms()));
+        goto err_out_label;
+    }
+
+    VOLC_CHK_STATUS(_volc_send_queue_push(ctx, priority, data, size, 0, addr, volc_get_montionic_time_ms()));
+    ret = _volc_send_scheduler_drain_locked(ctx);
+    if (ret == VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY) {
+        ret = VOLC_STATUS_SUCCESS;
+    }
+
+err_out_label:
+    if (locked) {
+        volc_mutex_unlock(ctx->lock);
+    }
+    return ret;
+}
+
+uint32_t volc_send_scheduler_drain(volc_send_scheduler_t scheduler) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_send_scheduler_ctx_t* ctx = (volc_send_scheduler_ctx_t*) scheduler;
+
+    VOLC_CHK(ctx != NULL, VOLC_STATUS_NULL_ARG);
+    volc_mutex_lock(ctx->lock);
+    ret = _volc_send_scheduler_drain_locked(ctx);
+    volc_mutex_unlock(ctx->lock);
+
+err_out_label:
+    return ret;
+}
+
+short volc_send_scheduler_get_poll_events(volc_send_scheduler_t scheduler) {
+    volc_send_scheduler_ctx_t* ctx = (volc_send_scheduler_ctx_t*) scheduler;
+    short events = 0;
+    if (NULL == ctx) {
+        return 0;
+    }
+    volc_mutex_lock(ctx->lock);
+    if (ctx->total_packets > 0) {
+        events = VOLC_EVLOOP_POLLOUT;
+    }
+    volc_mutex_unlock(ctx->lock);
+    return events;
+}
+
+uint32_t volc_send_scheduler_on_poll_event(volc_send_scheduler_t scheduler, short revents) {
+    if (NULL == scheduler) {
+        return VOLC_STATUS_NULL_ARG;
+    }
+    if ((revents & (VOLC_EVLOOP_POLLERR | VOLC_EVLOOP_POLLHUP)) != 0) {
+        return VOLC_STATUS_EVLOOP_PERFORM_FAILED;
+    }
+    if ((revents & VOLC_EVLOOP_POLLOUT) == 0) {
+        return VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY;
+    }
+    return volc_send_scheduler_drain(scheduler);
+}
+
+uint32_t volc_send_scheduler_get_stats(volc_send_scheduler_t scheduler, volc_send_scheduler_stats_t* stats) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_send_scheduler_ctx_t* ctx = (volc_send_scheduler_ctx_t*) scheduler;
+    uint32_t priority = 0;
+
+    VOLC_CHK(ctx != NULL && stats != NULL, VOLC_STATUS_NULL_ARG);
+    volc_mutex_lock(ctx->lock);
+    *stats = ctx->stats;
+    for (priority = 0; priority < VOLC_SEND_PRIORITY_COUNT; priority++) {
+        stats->queued_packets[priority] = ctx->queues[priority].packets;
+        stats->queued_bytes[priority] = ctx->queues[priority].bytes;
+    }
+    volc_mutex_unlock(ctx->lock);
+
+err_out_label:
+    return ret;
+}
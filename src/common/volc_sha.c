@@ -0,0 +1,421 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_crypto_internal.h"
+
+#include <string.h>
+
+#if defined(VOLC_CRYPTO_X86_KERNELS)
+#include <immintrin.h>
+#endif
+
+#define VOLC_SHA_ROTL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define VOLC_SHA_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static const uint32_t g_sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be,
+    0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa,
+    0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85,
+    0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f,
+    0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t _volc_sha_get_be32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline void _volc_sha_put_be32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+void volc_sha1_blocks_portable(uint32_t* state, const uint8_t* data, size_t blocks) {
+    uint32_t w[16];
+    uint32_t a, b, c, d, e, f, k, t;
+    uint32_t i = 0;
+
+    while (blocks-- > 0) {
+        for (i = 0; i < 16; i++) {
+            w[i] = _volc_sha_get_be32(data + 4 * i);
+        }
+        a = state[0];
+        b = state[1];
+        c = state[2];
+        d = state[3];
+        e = state[4];
+        for (i = 0; i < 80; i++) {
+            // the message schedule only ever needs the last 16 words
+            if (i >= 16) {
+                t = w[(i + 13) & 15] ^ w[(i + 8) & 15] ^ w[(i + 2) & 15] ^ w[i & 15];
+                w[i & 15] = VOLC_SHA_ROTL(t, 1);
+            }
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5a827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ed9eba1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8f1bbcdc;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xca62c1d6;
+            }
+            t = VOLC_SHA_ROTL(a, 5) + f + e + k + w[i & 15];
+            e = d;
+            d = c;
+            c = VOLC_SHA_ROTL(b, 30);
+            b = a;
+            a = t;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        data += VOLC_SHA_BLOCK_LENGTH;
+    }
+}
+
+void volc_sha256_blocks_portable(uint32_t* state, const uint8_t* data, size_t blocks) {
+    uint32_t w[64];
+    uint32_t a, b, c, d, e, f, g, h, s0, s1, t1, t2;
+    uint32_t i = 0;
+
+    while (blocks-- > 0) {
+        for (i = 0; i < 16; i++) {
+            w[i] = _volc_sha_get_be32(data + 4 * i);
+        }
+        for (i = 16; i < 64; i++) {
+            s0 = VOLC_SHA_ROTR(w[i - 15], 7) ^ VOLC_SHA_ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            s1 = VOLC_SHA_ROTR(w[i - 2], 17) ^ VOLC_SHA_ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        a = state[0];
+        b = state[1];
+        c = state[2];
+        d = state[3];
+        e = state[4];
+        f = state[5];
+        g = state[6];
+        h = state[7];
+        for (i = 0; i < 64; i++) {
+            s1 = VOLC_SHA_ROTR(e, 6) ^ VOLC_SHA_ROTR(e, 11) ^ VOLC_SHA_ROTR(e, 25);
+            t1 = h + s1 + ((e & f) ^ (~e & g)) + g_sha256_k[i] + w[i];
+            s0 = VOLC_SHA_ROTR(a, 2) ^ VOLC_SHA_ROTR(a, 13) ^ VOLC_SHA_ROTR(a, 22);
+            t2 = s0 + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+        data += VOLC_SHA_BLOCK_LENGTH;
+    }
+}
+
+#if defined(VOLC_CRYPTO_X86_KERNELS)
+// four SHA-1 rounds per step, E0/E1 alternate as the round input and the saved ABCD. From step 3 on every step also
+// advances the message schedule, the compiler drops the schedule updates the last steps no longer read
+#define VOLC_SHA1_SHANI_STEP(e_in, e_out, m0, m1, m2, m3, func)                                                                                       \
+    do {                                                                                                                                              \
+        e_in = _mm_sha1nexte_epu32(e_in, m0);                                                                                                         \
+        e_out = abcd;                                                                                                                                 \
+        m1 = _mm_sha1msg2_epu32(m1, m0);                                                                                                              \
+        abcd = _mm_sha1rnds4_epu32(abcd, e_in, func);                                                                                                 \
+        m3 = _mm_sha1msg1_epu32(m3, m0);                                                                                                              \
+        m2 = _mm_xor_si128(m2, m0);                                                                                                                   \
+    } while (0)
+
+__attribute__((target("sha,sse4.1"))) void volc_sha1_blocks_shani(uint32_t* state, const uint8_t* data, size_t blocks) {
+    const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    __m128i abcd, abcd_save, e0, e0_save, e1;
+    __m128i msg0, msg1, msg2, msg3;
+
+    abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)state), 0x1b);
+    e0 = _mm_set_epi32((int)state[4], 0, 0, 0);
+
+    while (blocks-- > 0) {
+        abcd_save = abcd;
+        e0_save = e0;
+
+        msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 0)), mask);
+        e0 = _mm_add_epi32(e0, msg0);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+        msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 16)), mask);
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+
+        msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 32)), mask);
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+
+        msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 48)), mask);
+        VOLC_SHA1_SHANI_STEP(e1, e0, msg3, msg0, msg1, msg2, 0);
+        VOLC_SHA1_SHANI_STEP(e0, e1, msg0, msg1, msg2, msg3, 0);
+        VOLC_SHA1_SHANI_STEP(e1, e0, msg1, msg2, msg3, msg0, 1);
+        VOLC_SHA1_SHANI_STEP(e0, e1, msg2, msg3, msg0, msg1, 1);
+        VOLC_SHA1_SHANI_STEP(e1, e0, msg3, msg0, msg1, msg2, 1);
+        VOLC_SHA1_SHANI_STEP(e0, e1, msg0, msg1, msg2, msg3, 1);
+        VOLC_SHA1_SHANI_STEP(e1, e0, msg1, msg2, msg3, msg0, 1);
+        VOLC_SHA1_SHANI_STEP(e0, e1, msg2, msg3, msg0, msg1, 2);
+        VOLC_SHA1_SHANI_STEP(e1, e0, msg3, msg0, msg1, msg2, 2);
+        VOLC_SHA1_SHANI_STEP(e0, e1, msg0, msg1, msg2, msg3, 2);
+        VOLC_SHA1_SHANI_STEP(e1, e0, msg1, msg2, msg3, msg0, 2);
+        VOLC_SHA1_SHANI_STEP(e0, e1, msg2, msg3, msg0, msg1, 2);
+        VOLC_SHA1_SHANI_STEP(e1, e0, msg3, msg0, msg1, msg2, 3);
+        VOLC_SHA1_SHANI_STEP(e0, e1, msg0, msg1, msg2, msg3, 3);
+        VOLC_SHA1_SHANI_STEP(e1, e0, msg1, msg2, msg3, msg0, 3);
+        VOLC_SHA1_SHANI_STEP(e0, e1, msg2, msg3, msg0, msg1, 3);
+        VOLC_SHA1_SHANI_STEP(e1, e0, msg3, msg0, msg1, msg2, 3);
+
+        e0 = _mm_sha1nexte_epu32(e0, e0_save);
+        abcd = _mm_add_epi32(abcd, abcd_save);
+        data += VOLC_SHA_BLOCK_LENGTH;
+    }
+
+    _mm_storeu_si128((__m128i*)state, _mm_shuffle_epi32(abcd, 0x1b));
+    state[4] = (uint32_t)_mm_extract_epi32(e0, 3);
+}
+
+// four SHA-256 rounds per step on the ABEF/CDGH split state, with the message schedule advanced like the SHA-1 steps
+#define VOLC_SHA256_SHANI_STEP(k_index, m_cur, m_next, m_prev)                                                                                         \
+    do {                                                                                                                                              \
+        msg = _mm_add_epi32(m_cur, _mm_loadu_si128((const __m128i*)&g_sha256_k[k_index]));                                                           \
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);                                                                                          \
+        m_next = _mm_add_epi32(m_next, _mm_alignr_epi8(m_cur, m_prev, 4));                                                                            \
+        m_next = _mm_sha256msg2_epu32(m_next, m_cur);                                                                                                 \
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));                                                                \
+        m_prev = _mm_sha256msg1_epu32(m_prev, m_cur);                                                                                                 \
+    } while (0)
+
+__attribute__((target("sha,sse4.1"))) void volc_sha256_blocks_shani(uint32_t* state, const uint8_t* data, size_t blocks) {
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, abef_save, cdgh_save, msg, tmp;
+    __m128i msg0, msg1, msg2, msg3;
+
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[0]), 0xb1);
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[4]), 0x1b);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+    while (blocks-- > 0) {
+        abef_save = state0;
+        cdgh_save = state1;
+
+        msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 0)), mask);
+        msg = _mm_add_epi32(msg0, _mm_loadu_si128((const __m128i*)&g_sha256_k[0]));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+
+        msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 16)), mask);
+        msg = _mm_add_epi32(msg1, _mm_loadu_si128((const __m128i*)&g_sha256_k[4]));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+        msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 32)), mask);
+        msg = _mm_add_epi32(msg2, _mm_loadu_si128((const __m128i*)&g_sha256_k[8]));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+        msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 48)), mask);
+        VOLC_SHA256_SHANI_STEP(12, msg3, msg0, msg2);
+        VOLC_SHA256_SHANI_STEP(16, msg0, msg1, msg3);
+        VOLC_SHA256_SHANI_STEP(20, msg1, msg2, msg0);
+        VOLC_SHA256_SHANI_STEP(24, msg2, msg3, msg1);
+        VOLC_SHA256_SHANI_STEP(28, msg3, msg0, msg2);
+        VOLC_SHA256_SHANI_STEP(32, msg0, msg1, msg3);
+        VOLC_SHA256_SHANI_STEP(36, msg1, msg2, msg0);
+        VOLC_SHA256_SHANI_STEP(40, msg2, msg3, msg1);
+        VOLC_SHA256_SHANI_STEP(44, msg3, msg0, msg2);
+        VOLC_SHA256_SHANI_STEP(48, msg0, msg1, msg3);
+        VOLC_SHA256_SHANI_STEP(52, msg1, msg2, msg0);
+        VOLC_SHA256_SHANI_STEP(56, msg2, msg3, msg1);
+        VOLC_SHA256_SHANI_STEP(60, msg3, msg0, msg2);
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+        data += VOLC_SHA_BLOCK_LENGTH;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    _mm_storeu_si128((__m128i*)&state[0], _mm_blend_epi16(tmp, state1, 0xf0));
+    _mm_storeu_si128((__m128i*)&state[4], _mm_alignr_epi8(state1, tmp, 8));
+}
+
+#define VOLC_SHA1_AVX2_ROTL(x, n) _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+
+// eight 32-byte rows, one per lane, become eight vectors holding the same word of every lane
+__attribute__((target("avx2"))) static inline void _volc_sha1_avx2_transpose(__m256i* w, const uint8_t* const blocks[VOLC_SHA1_LANES], size_t offset) {
+    const __m256i bswap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m256i r[VOLC_SHA1_LANES], t[VOLC_SHA1_LANES], u[VOLC_SHA1_LANES];
+    uint32_t i = 0;
+
+    for (i = 0; i < VOLC_SHA1_LANES; i++) {
+        r[i] = _mm256_loadu_si256((const __m256i*)(blocks[i] + offset));
+    }
+    for (i = 0; i < VOLC_SHA1_LANES; i += 2) {
+        t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+    }
+    u[0] = _mm256_unpacklo_epi64(t[0], t[2]);
+    u[1] = _mm256_unpackhi_epi64(t[0], t[2]);
+    u[2] = _mm256_unpacklo_epi64(t[1], t[3]);
+    u[3] = _mm256_unpackhi_epi64(t[1], t[3]);
+    u[4] = _mm256_unpacklo_epi64(t[4], t[6]);
+    u[5] = _mm256_unpackhi_epi64(t[4], t[6]);
+    u[6] = _mm256_unpacklo_epi64(t[5], t[7]);
+    u[7] = _mm256_unpackhi_epi64(t[5], t[7]);
+    for (i = 0; i < 4; i++) {
+        w[i] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u[i], u[i + 4], 0x20), bswap);
+        w[i + 4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u[i], u[i + 4], 0x31), bswap);
+    }
+}
+
+// plain SHA-1 rounds on eight lanes at once, each 32-bit element of a vector belongs to a different message
+__attribute__((target("avx2"))) void volc_sha1_lanes_avx2(uint32_t state[VOLC_SHA1_STATE_WORDS][VOLC_SHA1_LANES], const uint8_t* const blocks[VOLC_SHA1_LANES]) {
+    __m256i w[16];
+    __m256i a, b, c, d, e, f, k, t;
+    __m256i a0, b0, c0, d0, e0;
+    uint32_t i = 0;
+
+    _volc_sha1_avx2_transpose(&w[0], blocks, 0);
+    _volc_sha1_avx2_transpose(&w[8], blocks, 32);
+    a = a0 = _mm256_loadu_si256((const __m256i*)state[0]);
+    b = b0 = _mm256_loadu_si256((const __m256i*)state[1]);
+    c = c0 = _mm256_loadu_si256((const __m256i*)state[2]);
+    d = d0 = _mm256_loadu_si256((const __m256i*)state[3]);
+    e = e0 = _mm256_loadu_si256((const __m256i*)state[4]);
+
+    for (i = 0; i < 80; i++) {
+        if (i >= 16) {
+            t = _mm256_xor_si256(_mm256_xor_si256(w[(i + 13) & 15], w[(i + 8) & 15]), _mm256_xor_si256(w[(i + 2) & 15], w[i & 15]));
+            w[i & 15] = VOLC_SHA1_AVX2_ROTL(t, 1);
+        }
+        if (i < 20) {
+            f = _mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d)));
+            k = _mm256_set1_epi32(0x5a827999);
+        } else if (i < 40) {
+            f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+            k = _mm256_set1_epi32(0x6ed9eba1);
+        } else if (i < 60) {
+            f = _mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c)));
+            k = _mm256_set1_epi32((int)0x8f1bbcdc);
+        } else {
+            f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+            k = _mm256_set1_epi32((int)0xca62c1d6);
+        }
+        t = _mm256_add_epi32(_mm256_add_epi32(VOLC_SHA1_AVX2_ROTL(a, 5), f), _mm256_add_epi32(_mm256_add_epi32(e, k), w[i & 15]));
+        e = d;
+        d = c;
+        c = VOLC_SHA1_AVX2_ROTL(b, 30);
+        b = a;
+        a = t;
+    }
+
+    _mm256_storeu_si256((__m256i*)state[0], _mm256_add_epi32(a, a0));
+    _mm256_storeu_si256((__m256i*)state[1], _mm256_add_epi32(b, b0));
+    _mm256_storeu_si256((__m256i*)state[2], _mm256_add_epi32(c, c0));
+    _mm256_storeu_si256((__m256i*)state[3], _mm256_add_epi32(d, d0));
+    _mm256_storeu_si256((__m256i*)state[4], _mm256_add_epi32(e, e0));
+}
+#endif
+
+void volc_sha1_state_init(volc_sha_state_t* sha) {
+    memset(sha, 0, sizeof(volc_sha_state_t));
+    sha->state[0] = 0x67452301;
+    sha->state[1] = 0xefcdab89;
+    sha->state[2] = 0x98badcfe;
+    sha->state[3] = 0x10325476;
+    sha->state[4] = 0xc3d2e1f0;
+    sha->digest_length = VOLC_RTC_SHA1_DIGEST_LENGTH;
+    sha->blocks = volc_crypto_get_dispatch()->sha1_blocks;
+}
+
+void volc_sha256_state_init(volc_sha_state_t* sha) {
+    memset(sha, 0, sizeof(volc_sha_state_t));
+    sha->state[0] = 0x6a09e667;
+    sha->state[1] = 0xbb67ae85;
+    sha->state[2] = 0x3c6ef372;
+    sha->state[3] = 0xa54ff53a;
+    sha->state[4] = 0x510e527f;
+    sha->state[5] = 0x9b05688c;
+    sha->state[6] = 0x1f83d9ab;
+    sha->state[7] = 0x5be0cd19;
+    sha->digest_length = VOLC_RTC_SHA256_DIGEST_LENGTH;
+    sha->blocks = volc_crypto_get_dispatch()->sha256_blocks;
+}
+
+void volc_sha_state_update(volc_sha_state_t* sha, const uint8_t* data, size_t len) {
+    size_t used = (size_t)(sha->length % VOLC_SHA_BLOCK_LENGTH);
+    size_t fill = 0;
+
+    sha->length += len;
+    if (used > 0) {
+        fill = VOLC_SHA_BLOCK_LENGTH - used;
+        if (len < fill) {
+            memcpy(sha->buffer + used, data, len);
+            return;
+        }
+        memcpy(sha->buffer + used, data, fill);
+        sha->blocks(sha->state, sha->buffer, 1);
+        data += fill;
+        len -= fill;
+    }
+    // whole blocks go straight from the caller's buffer so the kernels see long runs
+    if (len >= VOLC_SHA_BLOCK_LENGTH) {
+        sha->blocks(sha->state, data, len / VOLC_SHA_BLOCK_LENGTH);
+        data += len - len % VOLC_SHA_BLOCK_LENGTH;
+        len %= VOLC_SHA_BLOCK_LENGTH;
+    }
+    if (len > 0) {
+        memcpy(sha->buffer, data, len);
+    }
+}
+
+void volc_sha_state_finish(volc_sha_state_t* sha, uint8_t* digest) {
+    size_t used = (size_t)(sha->length % VOLC_SHA_BLOCK_LENGTH);
+    uint64_t bits = sha->length * 8;
+    uint32_t i = 0;
+
+    sha->buffer[used++] = 0x80;
+    if (used > VOLC_SHA_BLOCK_LENGTH - 8) {
+        memset(sha->buffer + used, 0, VOLC_SHA_BLOCK_LENGTH - used);
+        sha->blocks(sha->state, sha->buffer, 1);
+        used = 0;
+    }
+    memset(sha->buffer + used, 0, VOLC_SHA_BLOCK_LENGTH - 8 - used);
+    _volc_sha_put_be32(sha->buffer + VOLC_SHA_BLOCK_LENGTH - 8, (uint32_t)(bits >> 32));
+    _volc_sha_put_be32(sha->buffer + VOLC_SHA_BLOCK_LENGTH - 4, (uint32_t)bits);
+    sha->blocks(sha->state, sha->buffer, 1);
+    for (i = 0; i < sha->digest_length / 4; i++) {
+        _volc_sha_put_be32(digest + 4 * i, sha->state[i]);
+    }
+}
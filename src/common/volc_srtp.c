@@ -0,0 +1,805 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_srtp.h"
+
+#include <string.h>
+
+#include <mbedtls/aes.h>
+#include <mbedtls/gcm.h>
+#include <mbedtls/platform_util.h>
+
+#include "volc_crypto_internal.h"
+#include "volc_memory.h"
+#include "volc_type.h"
+
+#define VOLC_SRTP_RTP_HEADER_LENGTH   12
+#define VOLC_SRTP_RTCP_HEADER_LENGTH  8
+#define VOLC_SRTP_RTCP_INDEX_LENGTH   4
+#define VOLC_SRTP_RTCP_E_FLAG         0x80000000u
+#define VOLC_SRTP_RTCP_MAX_INDEX      0x7fffffffu
+#define VOLC_SRTP_AUTH_KEY_LENGTH     20
+#define VOLC_SRTP_SESSION_SALT_LENGTH 14
+#define VOLC_SRTP_REPLAY_WINDOW       64
+#define VOLC_SRTP_GCM_IV_LENGTH       12
+#define VOLC_SRTP_GCM_TAG_LENGTH      16
+#define VOLC_SRTP_ROC_LENGTH          4
+// packets a batch call works on at once, bounds the per packet bookkeeping kept on the stack
+#define VOLC_SRTP_BATCH_CHUNK         16
+
+// RFC 3711 section 4.3.1 key derivation labels
+#define VOLC_SRTP_LABEL_RTP_ENCRYPTION  0x00
+#define VOLC_SRTP_LABEL_RTP_AUTH        0x01
+#define VOLC_SRTP_LABEL_RTP_SALT        0x02
+#define VOLC_SRTP_LABEL_RTCP_ENCRYPTION 0x03
+#define VOLC_SRTP_LABEL_RTCP_AUTH       0x04
+#define VOLC_SRTP_LABEL_RTCP_SALT       0x05
+
+typedef struct {
+    volc_srtp_profile_t profile;
+    uint32_t key_length;
+    uint32_t salt_length;
+    uint32_t rtp_tag_length;
+    uint32_t rtcp_tag_length;
+    // AEAD profiles encrypt and authenticate in one GCM pass and have no auth key
+    bool aead;
+} volc_srtp_profile_info_t;
+
+static const volc_srtp_profile_info_t g_srtp_profiles[] = {
+    {VOLC_SRTP_PROFILE_AES128_CM_HMAC_SHA1_80, VOLC_AES128_KEY_LENGTH, VOLC_SRTP_CM_MASTER_SALT_LENGTH, 10, 10, false},
+    // the short tag only applies to RTP, SRTCP keeps 80 bits (RFC 5764 section 4.1.2)
+    {VOLC_SRTP_PROFILE_AES128_CM_HMAC_SHA1_32, VOLC_AES128_KEY_LENGTH, VOLC_SRTP_CM_MASTER_SALT_LENGTH, 4, 10, false},
+    {VOLC_SRTP_PROFILE_AEAD_AES_128_GCM, VOLC_AES128_KEY_LENGTH, VOLC_SRTP_GCM_MASTER_SALT_LENGTH, VOLC_SRTP_GCM_TAG_LENGTH, VOLC_SRTP_GCM_TAG_LENGTH, true},
+    {VOLC_SRTP_PROFILE_AEAD_AES_256_GCM, VOLC_SRTP_MAX_MASTER_KEY_LENGTH, VOLC_SRTP_GCM_MASTER_SALT_LENGTH, VOLC_SRTP_GCM_TAG_LENGTH, VOLC_SRTP_GCM_TAG_LENGTH,
+     true},
+};
+
+// keys of one of the SRTP and SRTCP halves, expanded once per session
+typedef struct {
+    volc_aes_ctr_key_t ctr;
+    volc_sha1_hmac_t hmac;
+    // used instead of ctr and hmac by the AEAD profiles, mbedtls picks AES-NI and PCLMULQDQ at runtime when the CPU has them
+    mbedtls_gcm_context gcm;
+    uint8_t salt[VOLC_SRTP_SESSION_SALT_LENGTH];
+    uint32_t tag_length;
+} volc_srtp_keys_t;
+
+typedef struct {
+    uint32_t ssrc;
+    bool used;
+    // highest SRTP index seen or sent is roc << 16 | seq, bit n of the window marks highest - n as received
+    bool rtp_valid;
+    uint32_t roc;
+    uint16_t seq;
+    uint64_t rtp_window;
+    // next SRTCP index to send, or highest received
+    bool rtcp_valid;
+    uint32_t rtcp_index;
+    uint64_t rtcp_window;
+} volc_srtp_stream_t;
+
+typedef struct {
+    const volc_srtp_profile_info_t* info;
+    volc_srtp_keys_t rtp;
+    volc_srtp_keys_t rtcp;
+    volc_srtp_stream_t* streams;
+    uint32_t max_streams;
+} volc_srtp_session_impl_t;
+
+static inline uint16_t _volc_srtp_get_be16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static inline uint32_t _volc_srtp_get_be32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline void _volc_srtp_put_be32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static const volc_srtp_profile_info_t* _volc_srtp_profile_info(volc_srtp_profile_t profile) {
+    uint32_t i = 0;
+    for (i = 0; i < VOLC_ARRAY_SIZE(g_srtp_profiles); i++) {
+        if (g_srtp_profiles[i].profile == profile) {
+            return &g_srtp_profiles[i];
+        }
+    }
+    return NULL;
+}
+
+// AES-CM PRF with key_derivation_rate 0: keystream under the master key, IV = (master_salt XOR label << 48) << 16.
+// The 96-bit GCM master salt is zero padded to 112 bits (RFC 7714 section 11)
+static int _volc_srtp_kdf(mbedtls_aes_context* master, const uint8_t* master_salt, uint32_t salt_length, uint8_t label, uint8_t* out, size_t len) {
+    uint8_t iv[16];
+    uint8_t stream_block[16];
+    size_t nc_off = 0;
+    int ret = 0;
+
+    memset(iv, 0, sizeof(iv));
+    memcpy(iv, master_salt, salt_length);
+    iv[7] ^= label;
+    memset(out, 0, len);
+    ret = mbedtls_aes_crypt_ctr(master, len, &nc_off, iv, stream_block, out, out);
+    mbedtls_platform_zeroize(stream_block, sizeof(stream_block));
+    return ret;
+}
+
+static uint32_t _volc_srtp_keys_init(volc_srtp_keys_t* keys, mbedtls_aes_context* master, const uint8_t* master_salt, const volc_srtp_profile_info_t* info,
+                                     uint8_t label_base, uint32_t tag_length) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    uint32_t key_length = info->key_length;
+    uint8_t enc_key[VOLC_SRTP_MAX_MASTER_KEY_LENGTH];
+    uint8_t auth_key[VOLC_SRTP_AUTH_KEY_LENGTH];
+
+    memset(auth_key, 0, sizeof(auth_key));
+    keys->tag_length = tag_length;
+    VOLC_CHK(_volc_srtp_kdf(master, master_salt, info->salt_length, label_base + VOLC_SRTP_LABEL_RTP_ENCRYPTION, enc_key, key_length) == 0,
+             VOLC_STATUS_INTERNAL_ERROR);
+    VOLC_CHK(_volc_srtp_kdf(master, master_salt, info->salt_length, label_base + VOLC_SRTP_LABEL_RTP_SALT, keys->salt, info->salt_length) == 0,
+             VOLC_STATUS_INTERNAL_ERROR);
+    if (info->aead) {
+        VOLC_CHK(mbedtls_gcm_setkey(&keys->gcm, MBEDTLS_CIPHER_ID_AES, enc_key, key_length * 8) == 0, VOLC_STATUS_INTERNAL_ERROR);
+    } else {
+        VOLC_CHK(_volc_srtp_kdf(master, master_salt, info->salt_length, label_base + VOLC_SRTP_LABEL_RTP_AUTH, auth_key, sizeof(auth_key)) == 0,
+                 VOLC_STATUS_INTERNAL_ERROR);
+        VOLC_CHK(volc_aes_ctr_key_setkey(&keys->ctr, enc_key, key_length * 8) == 0, VOLC_STATUS_INTERNAL_ERROR);
+        // the ipad and opad blocks are absorbed once here, every packet then only hashes its own bytes
+        VOLC_CHK_STATUS(volc_sha1_hmac_create(auth_key, sizeof(auth_key), &keys->hmac));
+    }
+
+err_out_label:
+    mbedtls_platform_zeroize(enc_key, sizeof(enc_key));
+    mbedtls_platform_zeroize(auth_key, sizeof(auth_key));
+    return ret;
+}
+
+static void _volc_srtp_keys_free(volc_srtp_keys_t* keys) {
+    volc_aes_ctr_key_free(&keys->ctr);
+    volc_sha1_hmac_destroy(keys->hmac);
+    keys->hmac = NULL;
+    mbedtls_gcm_free(&keys->gcm);
+    mbedtls_platform_zeroize(keys->salt, sizeof(keys->salt));
+}
+
+// IV = (salt << 16) XOR (ssrc << 64) XOR (index << 16), RFC 3711 section 4.1.1
+static void _volc_srtp_ctr_job(volc_srtp_keys_t* keys, uint32_t ssrc, uint64_t index, uint8_t* data, size_t len, volc_aes_ctr_job_t* job) {
+    uint32_t i = 0;
+
+    memcpy(job->counter, keys->salt, VOLC_SRTP_SESSION_SALT_LENGTH);
+    job->counter[14] = 0;
+    job->counter[15] = 0;
+    for (i = 0; i < 4; i++) {
+        job->counter[4 + i] ^= (uint8_t)(ssrc >> (24 - 8 * i));
+    }
+    for (i = 0; i < 6; i++) {
+        job->counter[8 + i] ^= (uint8_t)(index >> (40 - 8 * i));
+    }
+    job->input = data;
+    job->output = data;
+    job->len = len;
+}
+
+static void _volc_srtp_crypt(volc_srtp_keys_t* keys, uint32_t ssrc, uint64_t index, uint8_t* data, size_t len) {
+    volc_aes_ctr_job_t job;
+
+    _volc_srtp_ctr_job(keys, ssrc, index, data, len, &job);
+    volc_aes_ctr_key_crypt(&keys->ctr, &job, 1);
+}
+
+static void _volc_srtp_auth(volc_srtp_keys_t* keys, const uint8_t* data, size_t len, const uint8_t* suffix, size_t suffix_len, uint8_t* tag) {
+    volc_sha1_hmac_update(keys->hmac, data, len);
+    if (suffix_len > 0) {
+        volc_sha1_hmac_update(keys->hmac, suffix, suffix_len);
+    }
+    volc_sha1_hmac_finish(keys->hmac, tag);
+}
+
+static bool _volc_srtp_tag_equal(const uint8_t* a, const uint8_t* b, uint32_t len) {
+    uint8_t diff = 0;
+    uint32_t i = 0;
+    for (i = 0; i < len; i++) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+// IV = salt XOR (ssrc << 48 | index), RFC 7714 section 8.1. The AAD is passed in up to two parts so SRTCP can cover the
+// header and the trailing E|index word without moving data. Decryption checks the tag itself before returning success.
+static uint32_t _volc_srtp_gcm(volc_srtp_keys_t* keys, int mode, uint32_t ssrc, uint64_t index, const uint8_t* aad, size_t aad_len, const uint8_t* aad_suffix,
+                               size_t aad_suffix_len, uint8_t* data, size_t len, uint8_t* tag) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    uint8_t iv[VOLC_SRTP_GCM_IV_LENGTH];
+    uint8_t computed[VOLC_SRTP_GCM_TAG_LENGTH];
+    size_t olen = 0;
+    uint32_t i = 0;
+
+    memcpy(iv, keys->salt, VOLC_SRTP_GCM_IV_LENGTH);
+    for (i = 0; i < 4; i++) {
+        iv[2 + i] ^= (uint8_t)(ssrc >> (24 - 8 * i));
+    }
+    for (i = 0; i < 6; i++) {
+        iv[6 + i] ^= (uint8_t)(index >> (40 - 8 * i));
+    }
+    VOLC_CHK(mbedtls_gcm_starts(&keys->gcm, mode, iv, sizeof(iv)) == 0, VOLC_STATUS_INTERNAL_ERROR);
+    VOLC_CHK(mbedtls_gcm_update_ad(&keys->gcm, aad, aad_len) == 0, VOLC_STATUS_INTERNAL_ERROR);
+    if (aad_suffix_len > 0) {
+        VOLC_CHK(mbedtls_gcm_update_ad(&keys->gcm, aad_suffix, aad_suffix_len) == 0, VOLC_STATUS_INTERNAL_ERROR);
+    }
+    if (len > 0) {
+        VOLC_CHK(mbedtls_gcm_update(&keys->gcm, data, len, data, len, &olen) == 0 && olen == len, VOLC_STATUS_INTERNAL_ERROR);
+    }
+    VOLC_CHK(mbedtls_gcm_finish(&keys->gcm, NULL, 0, &olen, computed, sizeof(computed)) == 0, VOLC_STATUS_INTERNAL_ERROR);
+    if (mode == MBEDTLS_GCM_ENCRYPT) {
+        memcpy(tag, computed, keys->tag_length);
+    } else {
+        VOLC_CHK(_volc_srtp_tag_equal(computed, tag, keys->tag_length), VOLC_STATUS_SRTP_AUTHENTICATION_FAILED);
+    }
+
+err_out_label:
+    if (VOLC_STATUS_FAILED(ret) && mode == MBEDTLS_GCM_DECRYPT && len > 0) {
+        // the payload was decrypted in place before the tag could be checked, unauthenticated plaintext must not reach the caller
+        mbedtls_platform_zeroize(data, len);
+    }
+    mbedtls_platform_zeroize(computed, sizeof(computed));
+    return ret;
+}
+
+static volc_srtp_stream_t* _volc_srtp_stream_find(volc_srtp_session_impl_t* p_session, uint32_t ssrc) {
+    uint32_t i = 0;
+    for (i = 0; i < p_session->max_streams; i++) {
+        if (p_session->streams[i].used && p_session->streams[i].ssrc == ssrc) {
+            return &p_session->streams[i];
+        }
+    }
+    return NULL;
+}
+
+static volc_srtp_stream_t* _volc_srtp_stream_add(volc_srtp_session_impl_t* p_session, uint32_t ssrc) {
+    uint32_t i = 0;
+    for (i = 0; i < p_session->max_streams; i++) {
+        if (!p_session->streams[i].used) {
+            memset(&p_session->streams[i], 0, sizeof(volc_srtp_stream_t));
+            p_session->streams[i].ssrc = ssrc;
+            p_session->streams[i].used = true;
+            return &p_session->streams[i];
+        }
+    }
+    return NULL;
+}
+
+static uint32_t _volc_srtp_rtp_header_length(const uint8_t* packet, uint32_t len, uint32_t* p_header_len) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    uint32_t header_len = VOLC_SRTP_RTP_HEADER_LENGTH;
+
+    VOLC_CHK(len >= VOLC_SRTP_RTP_HEADER_LENGTH && (packet[0] >> 6) == 2, VOLC_STATUS_SRTP_INVALID_PACKET);
+    header_len += 4 * (packet[0] & 0x0f);
+    if (packet[0] & 0x10) {
+        VOLC_CHK(len >= header_len + 4, VOLC_STATUS_SRTP_INVALID_PACKET);
+        header_len += 4 + 4 * (uint32_t)_volc_srtp_get_be16(packet + header_len + 2);
+    }
+    VOLC_CHK(len >= header_len, VOLC_STATUS_SRTP_INVALID_PACKET);
+    *p_header_len = header_len;
+
+err_out_label:
+    return ret;
+}
+
+// RFC 3711 appendix A: pick the ROC that puts seq closest to the highest sequence number seen so far
+static uint32_t _volc_srtp_guess_roc(const volc_srtp_stream_t* stream, uint16_t seq) {
+    if (!stream->rtp_valid) {
+        return 0;
+    }
+    if (stream->seq < 32768) {
+        return ((int32_t)seq - (int32_t)stream->seq > 32768 && stream->roc > 0) ? stream->roc - 1 : stream->roc;
+    }
+    return ((uint32_t)stream->seq - 32768 > seq) ? stream->roc + 1 : stream->roc;
+}
+
+// delta of index against the highest index seen, fails when the window says it was already received or is too old
+static uint32_t _volc_srtp_replay_check(bool valid, uint64_t highest, uint64_t window, uint64_t index, int64_t* p_delta) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    int64_t delta = valid ? (int64_t)(index - highest) : 1;
+
+    if (delta <= 0) {
+        VOLC_CHK(-delta < VOLC_SRTP_REPLAY_WINDOW, VOLC_STATUS_SRTP_REPLAYED_PACKET);
+        VOLC_CHK((window & ((uint64_t)1 << -delta)) == 0, VOLC_STATUS_SRTP_REPLAYED_PACKET);
+    }
+    *p_delta = delta;
+
+err_out_label:
+    return ret;
+}
+
+static uint64_t _volc_srtp_replay_update(bool valid, uint64_t window, int64_t delta) {
+    if (!valid) {
+        return 1;
+    }
+    if (delta > 0) {
+        return delta >= VOLC_SRTP_REPLAY_WINDOW ? 1 : (window << delta) | 1;
+    }
+    return window | ((uint64_t)1 << -delta);
+}
+
+uint32_t volc_srtp_session_create(const volc_srtp_policy_t* policy, volc_srtp_session_t* p_session) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_srtp_session_impl_t* p_impl = NULL;
+    const volc_srtp_profile_info_t* info = NULL;
+    mbedtls_aes_context master;
+
+    mbedtls_aes_init(&master);
+    VOLC_CHK(policy != NULL && p_session != NULL && policy->master_key != NULL && policy->master_salt != NULL, VOLC_STATUS_NULL_ARG);
+    info = _volc_srtp_profile_info(policy->profile);
+    VOLC_CHK(info != NULL, VOLC_STATUS_SSL_UNKNOWN_SRTP_PROFILE);
+    VOLC_CHK(policy->master_key_length == info->key_length && policy->master_salt_length == info->salt_length, VOLC_STATUS_INVALID_ARG_LEN);
+
+    p_impl = (volc_srtp_session_impl_t*)volc_malloc(sizeof(volc_srtp_session_impl_t));
+    VOLC_CHK(p_impl != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    memset(p_impl, 0, sizeof(volc_srtp_session_impl_t));
+    p_impl->info = info;
+    volc_aes_ctr_key_init(&p_impl->rtp.ctr);
+    volc_aes_ctr_key_init(&p_impl->rtcp.ctr);
+    mbedtls_gcm_init(&p_impl->rtp.gcm);
+    mbedtls_gcm_init(&p_impl->rtcp.gcm);
+    p_impl->max_streams = policy->max_streams > 0 ? policy->max_streams : VOLC_SRTP_DEFAULT_MAX_STREAMS;
+    p_impl->streams = (volc_srtp_stream_t*)volc_malloc(sizeof(volc_srtp_stream_t) * p_impl->max_streams);
+    VOLC_CHK(p_impl->streams != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    memset(p_impl->streams, 0, sizeof(volc_srtp_stream_t) * p_impl->max_streams);
+
+    VOLC_CHK(mbedtls_aes_setkey_enc(&master, policy->master_key, policy->master_key_length * 8) == 0, VOLC_STATUS_INVALID_ARG);
+    VOLC_CHK_STATUS(_volc_srtp_keys_init(&p_impl->rtp, &master, policy->master_salt, info, VOLC_SRTP_LABEL_RTP_ENCRYPTION, info->rtp_tag_length));
+    VOLC_CHK_STATUS(_volc_srtp_keys_init(&p_impl->rtcp, &master, policy->master_salt, info, VOLC_SRTP_LABEL_RTCP_ENCRYPTION, info->rtcp_tag_length));
+    *p_session = (volc_srtp_session_t)p_impl;
+
+err_out_label:
+    mbedtls_aes_free(&master);
+    if (VOLC_STATUS_FAILED(ret) && p_impl != NULL) {
+        volc_srtp_session_destroy((volc_srtp_session_t)p_impl);
+    }
+    return ret;
+}
+
+uint32_t volc_srtp_session_create_from_keying_material(const volc_srtp_keying_material_t* material, bool outbound, volc_srtp_session_t* p_session) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_srtp_policy_t policy;
+
+    VOLC_CHK(material != NULL, VOLC_STATUS_NULL_ARG);
+    memset(&policy, 0, sizeof(policy));
+    policy.profile = material->profile;
+    policy.master_key = outbound ? material->local_master_key : material->remote_master_key;
+    policy.master_key_length = material->master_key_length;
+    policy.master_salt = outbound ? material->local_master_salt : material->remote_master_salt;
+    policy.master_salt_length = material->master_salt_length;
+    ret = volc_srtp_session_create(&policy, p_session);
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_srtp_session_destroy(volc_srtp_session_t session) {
+    volc_srtp_session_impl_t* p_impl = (volc_srtp_session_impl_t*)session;
+    if (p_impl == NULL) {
+        return VOLC_STATUS_SUCCESS;
+    }
+    _volc_srtp_keys_free(&p_impl->rtp);
+    _volc_srtp_keys_free(&p_impl->rtcp);
+    VOLC_SAFE_MEMFREE(p_impl->streams);
+    volc_free(p_impl);
+    return VOLC_STATUS_SUCCESS;
+}
+
+// RTP packet fields protect and unprotect need before touching the payload, len excludes the tag
+typedef struct {
+    uint32_t len;
+    uint32_t header_len;
+    uint32_t ssrc;
+    uint16_t seq;
+    uint32_t roc;
+} volc_srtp_rtp_info_t;
+
+// checks the packet and advances the sender state of its stream, the packet index is then info->roc << 16 | info->seq
+static uint32_t _volc_srtp_protect_prepare(volc_srtp_session_impl_t* p_impl, const uint8_t* packet, uint32_t len, uint32_t capacity, volc_srtp_rtp_info_t* info) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_srtp_stream_t* stream = NULL;
+
+    info->len = len;
+    VOLC_CHK_STATUS(_volc_srtp_rtp_header_length(packet, len, &info->header_len));
+    VOLC_CHK(capacity >= len && capacity - len >= p_impl->rtp.tag_length, VOLC_STATUS_BUFFER_TOO_SMALL);
+    info->seq = _volc_srtp_get_be16(packet + 2);
+    info->ssrc = _volc_srtp_get_be32(packet + 8);
+    stream = _volc_srtp_stream_find(p_impl, info->ssrc);
+    if (stream == NULL) {
+        stream = _volc_srtp_stream_add(p_impl, info->ssrc);
+        VOLC_CHK(stream != NULL, VOLC_STATUS_SRTP_TOO_MANY_STREAMS);
+    }
+
+    // the sender uses the same estimate as the receiver so retransmissions keep their original index
+    info->roc = _volc_srtp_guess_roc(stream, info->seq);
+    if (!stream->rtp_valid || (((uint64_t)info->roc << 16) | info->seq) > (((uint64_t)stream->roc << 16) | stream->seq)) {
+        stream->rtp_valid = true;
+        stream->roc = info->roc;
+        stream->seq = info->seq;
+    }
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_srtp_protect(volc_srtp_session_t session, uint8_t* packet, uint32_t* p_len, uint32_t capacity) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_srtp_session_impl_t* p_impl = (volc_srtp_session_impl_t*)session;
+    volc_srtp_rtp_info_t info;
+    uint64_t index = 0;
+    uint8_t roc_be[VOLC_SRTP_ROC_LENGTH];
+    uint8_t tag[VOLC_RTC_SHA1_DIGEST_LENGTH];
+
+    VOLC_CHK(p_impl != NULL && packet != NULL && p_len != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK_STATUS(_volc_srtp_protect_prepare(p_impl, packet, *p_len, capacity, &info));
+    index = ((uint64_t)info.roc << 16) | info.seq;
+    if (p_impl->info->aead) {
+        // RFC 7714 section 9: the header is the AAD, the tag directly follows the ciphertext
+        VOLC_CHK_STATUS(_volc_srtp_gcm(&p_impl->rtp, MBEDTLS_GCM_ENCRYPT, info.ssrc, index, packet, info.header_len, NULL, 0, packet + info.header_len,
+                                       info.len - info.header_len, packet + info.len));
+    } else {
+        _volc_srtp_crypt(&p_impl->rtp, info.ssrc, index, packet + info.header_len, info.len - info.header_len);
+        _volc_srtp_put_be32(roc_be, info.roc);
+        _volc_srtp_auth(&p_impl->rtp, packet, info.len, roc_be, sizeof(roc_be), tag);
+        memcpy(packet + info.len, tag, p_impl->rtp.tag_length);
+    }
+    *p_len = info.len + p_impl->rtp.tag_length;
+
+err_out_label:
+    return ret;
+}
+
+static uint32_t _volc_srtp_unprotect_parse(volc_srtp_session_impl_t* p_impl, const uint8_t* packet, uint32_t srtp_len, volc_srtp_rtp_info_t* info) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+
+    VOLC_CHK(srtp_len >= p_impl->rtp.tag_length, VOLC_STATUS_SRTP_INVALID_PACKET);
+    info->len = srtp_len - p_impl->rtp.tag_length;
+    VOLC_CHK_STATUS(_volc_srtp_rtp_header_length(packet, info->len, &info->header_len));
+    info->seq = _volc_srtp_get_be16(packet + 2);
+    info->ssrc = _volc_srtp_get_be32(packet + 8);
+
+err_out_label:
+    return ret;
+}
+
+// estimates the ROC and checks the replay window, a stream not seen yet is checked as if it were blank
+static uint32_t _volc_srtp_unprotect_check(volc_srtp_session_impl_t* p_impl, volc_srtp_rtp_info_t* info, int64_t* p_delta) {
+    volc_srtp_stream_t* stream = NULL;
+    volc_srtp_stream_t candidate;
+
+    stream = _volc_srtp_stream_find(p_impl, info->ssrc);
+    if (stream == NULL) {
+        // forged packets must not be able to fill the stream table, a slot is taken only once authentication passed
+        memset(&candidate, 0, sizeof(candidate));
+        candidate.ssrc = info->ssrc;
+        stream = &candidate;
+    }
+    info->roc = _volc_srtp_guess_roc(stream, info->seq);
+    return _volc_srtp_replay_check(stream->rtp_valid, ((uint64_t)stream->roc << 16) | stream->seq, stream->rtp_window,
+                                   ((uint64_t)info->roc << 16) | info->seq, p_delta);
+}
+
+// records an authenticated packet in its stream
+static uint32_t _volc_srtp_unprotect_accept(volc_srtp_session_impl_t* p_impl, const volc_srtp_rtp_info_t* info, int64_t delta) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_srtp_stream_t* stream = NULL;
+
+    stream = _volc_srtp_stream_find(p_impl, info->ssrc);
+    if (stream == NULL) {
+        stream = _volc_srtp_stream_add(p_impl, info->ssrc);
+        VOLC_CHK(stream != NULL, VOLC_STATUS_SRTP_TOO_MANY_STREAMS);
+    }
+    stream->rtp_window = _volc_srtp_replay_update(stream->rtp_valid, stream->rtp_window, delta);
+    if (delta > 0) {
+        stream->roc = info->roc;
+        stream->seq = info->seq;
+    }
+    stream->rtp_valid = true;
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_srtp_unprotect(volc_srtp_session_t session, uint8_t* packet, uint32_t* p_len) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_srtp_session_impl_t* p_impl = (volc_srtp_session_impl_t*)session;
+    volc_srtp_rtp_info_t info;
+    uint64_t index = 0;
+    int64_t delta = 0;
+    uint8_t roc_be[VOLC_SRTP_ROC_LENGTH];
+    uint8_t tag[VOLC_RTC_SHA1_DIGEST_LENGTH];
+
+    VOLC_CHK(p_impl != NULL && packet != NULL && p_len != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK_STATUS(_volc_srtp_unprotect_parse(p_impl, packet, *p_len, &info));
+    VOLC_CHK_STATUS(_volc_srtp_unprotect_check(p_impl, &info, &delta));
+    index = ((uint64_t)info.roc << 16) | info.seq;
+    if (p_impl->info->aead) {
+        // decryption and authentication are a single pass, the payload is only trusted once the tag matched
+        VOLC_CHK_STATUS(_volc_srtp_gcm(&p_impl->rtp, MBEDTLS_GCM_DECRYPT, info.ssrc, index, packet, info.header_len, NULL, 0, packet + info.header_len,
+                                       info.len - info.header_len, packet + info.len));
+    } else {
+        _volc_srtp_put_be32(roc_be, info.roc);
+        _volc_srtp_auth(&p_impl->rtp, packet, info.len, roc_be, sizeof(roc_be), tag);
+        VOLC_CHK(_volc_srtp_tag_equal(tag, packet + info.len, p_impl->rtp.tag_length), VOLC_STATUS_SRTP_AUTHENTICATION_FAILED);
+    }
+
+    VOLC_CHK_STATUS(_volc_srtp_unprotect_accept(p_impl, &info, delta));
+    if (!p_impl->info->aead) {
+        _volc_srtp_crypt(&p_impl->rtp, info.ssrc, index, packet + info.header_len, info.len - info.header_len);
+    }
+    *p_len = info.len;
+
+err_out_label:
+    return ret;
+}
+
+// stream state advances packet by packet in order, only the AES-CTR and HMAC work of the chunk is handed to the batch kernels
+static uint32_t _volc_srtp_protect_chunk(volc_srtp_session_impl_t* p_impl, volc_srtp_packet_t* packets, uint32_t count) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_srtp_rtp_info_t info;
+    volc_aes_ctr_job_t jobs[VOLC_SRTP_BATCH_CHUNK];
+    volc_sha1_hmac_buffer_t macs[VOLC_SRTP_BATCH_CHUNK];
+    volc_srtp_packet_t* pending[VOLC_SRTP_BATCH_CHUNK];
+    volc_srtp_packet_t* p = NULL;
+    uint32_t pending_count = 0;
+    uint32_t i = 0;
+
+    for (i = 0; i < count; i++) {
+        p = &packets[i];
+        p->status = _volc_srtp_protect_prepare(p_impl, p->packet, p->len, p->capacity, &info);
+        if (VOLC_STATUS_FAILED(p->status)) {
+            continue;
+        }
+        _volc_srtp_ctr_job(&p_impl->rtp, info.ssrc, ((uint64_t)info.roc << 16) | info.seq, p->packet + info.header_len, info.len - info.header_len,
+                           &jobs[pending_count]);
+        // the authenticated ROC goes where the tag will be, every CM tag is at least as long as the ROC
+        _volc_srtp_put_be32(p->packet + info.len, info.roc);
+        macs[pending_count].input = p->packet;
+        macs[pending_count].ilen = info.len + VOLC_SRTP_ROC_LENGTH;
+        pending[pending_count++] = p;
+    }
+    volc_aes_ctr_key_crypt(&p_impl->rtp.ctr, jobs, pending_count);
+    VOLC_CHK_STATUS(volc_sha1_hmac_compute_batch(p_impl->rtp.hmac, macs, pending_count));
+    for (i = 0; i < pending_count; i++) {
+        memcpy(pending[i]->packet + pending[i]->len, macs[i].output, p_impl->rtp.tag_length);
+        pending[i]->len += p_impl->rtp.tag_length;
+    }
+
+err_out_label:
+    return ret;
+}
+
+static uint32_t _volc_srtp_unprotect_chunk(volc_srtp_session_impl_t* p_impl, volc_srtp_packet_t* packets, uint32_t count) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_srtp_rtp_info_t infos[VOLC_SRTP_BATCH_CHUNK];
+    volc_aes_ctr_job_t jobs[VOLC_SRTP_BATCH_CHUNK];
+    volc_sha1_hmac_buffer_t macs[VOLC_SRTP_BATCH_CHUNK];
+    volc_srtp_packet_t* pending[VOLC_SRTP_BATCH_CHUNK];
+    uint8_t saved[VOLC_SRTP_BATCH_CHUNK][VOLC_SRTP_ROC_LENGTH];
+    volc_srtp_rtp_info_t* info = NULL;
+    volc_srtp_packet_t* p = NULL;
+    uint32_t pending_count = 0;
+    uint32_t job_count = 0;
+    uint32_t guessed_roc = 0;
+    int64_t delta = 0;
+    uint32_t i = 0;
+
+    // the tags of the whole chunk are computed up front, with the ROC estimated from the state before the chunk
+    for (i = 0; i < count; i++) {
+        p = &packets[i];
+        info = &infos[pending_count];
+        p->status = _volc_srtp_unprotect_parse(p_impl, p->packet, p->len, info);
+        if (VOLC_STATUS_FAILED(p->status)) {
+            continue;
+        }
+        _volc_srtp_unprotect_check(p_impl, info, &delta);
+        memcpy(saved[pending_count], p->packet + info->len, VOLC_SRTP_ROC_LENGTH);
+        _volc_srtp_put_be32(p->packet + info->len, info->roc);
+        macs[pending_count].input = p->packet;
+        macs[pending_count].ilen = info->len + VOLC_SRTP_ROC_LENGTH;
+        pending[pending_count++] = p;
+    }
+    VOLC_CHK_STATUS(volc_sha1_hmac_compute_batch(p_impl->rtp.hmac, macs, pending_count));
+    for (i = 0; i < pending_count; i++) {
+        memcpy(pending[i]->packet + infos[i].len, saved[i], VOLC_SRTP_ROC_LENGTH);
+    }
+
+    // replay checks and stream updates then see the packets in order, exactly like one unprotect call after another
+    for (i = 0; i < pending_count; i++) {
+        p = pending[i];
+        info = &infos[i];
+        guessed_roc = info->roc;
+        p->status = _volc_srtp_unprotect_check(p_impl, info, &delta);
+        if (info->roc != guessed_roc) {
+            // an earlier packet of the chunk moved the ROC estimate, the tag was computed for another index
+            p->status = volc_srtp_unprotect((volc_srtp_session_t)p_impl, p->packet, &p->len);
+            continue;
+        }
+        if (VOLC_STATUS_FAILED(p->status)) {
+            continue;
+        }
+        if (!_volc_srtp_tag_equal(macs[i].output, p->packet + info->len, p_impl->rtp.tag_length)) {
+            p->status = VOLC_STATUS_SRTP_AUTHENTICATION_FAILED;
+            continue;
+        }
+        p->status = _volc_srtp_unprotect_accept(p_impl, info, delta);
+        if (VOLC_STATUS_FAILED(p->status)) {
+            continue;
+        }
+        _volc_srtp_ctr_job(&p_impl->rtp, info->ssrc, ((uint64_t)info->roc << 16) | info->seq, p->packet + info->header_len, info->len - info->header_len,
+                           &jobs[job_count++]);
+        p->len = info->len;
+    }
+    volc_aes_ctr_key_crypt(&p_impl->rtp.ctr, jobs, job_count);
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_srtp_protect_batch(volc_srtp_session_t session, volc_srtp_packet_t* packets, uint32_t count) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_srtp_session_impl_t* p_impl = (volc_srtp_session_impl_t*)session;
+    uint32_t i = 0;
+    uint32_t n = 0;
+
+    VOLC_CHK(p_impl != NULL && (packets != NULL || count == 0), VOLC_STATUS_NULL_ARG);
+    for (i = 0; i < count; i++) {
+        VOLC_CHK(packets[i].packet != NULL, VOLC_STATUS_NULL_ARG);
+    }
+    for (i = 0; i < count; i += n) {
+        n = count - i < VOLC_SRTP_BATCH_CHUNK ? count - i : VOLC_SRTP_BATCH_CHUNK;
+        if (p_impl->info->aead) {
+            // mbedtls runs GCM one message at a time, there is nothing to interleave
+            packets[i].status = volc_srtp_protect(session, packets[i].packet, &packets[i].len, packets[i].capacity);
+            n = 1;
+        } else {
+            VOLC_CHK_STATUS(_volc_srtp_protect_chunk(p_impl, packets + i, n));
+        }
+    }
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_srtp_unprotect_batch(volc_srtp_session_t session, volc_srtp_packet_t* packets, uint32_t count) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_srtp_session_impl_t* p_impl = (volc_srtp_session_impl_t*)session;
+    uint32_t i = 0;
+    uint32_t n = 0;
+
+    VOLC_CHK(p_impl != NULL && (packets != NULL || count == 0), VOLC_STATUS_NULL_ARG);
+    for (i = 0; i < count; i++) {
+        VOLC_CHK(packets[i].packet != NULL, VOLC_STATUS_NULL_ARG);
+    }
+    for (i = 0; i < count; i += n) {
+        n = count - i < VOLC_SRTP_BATCH_CHUNK ? count - i : VOLC_SRTP_BATCH_CHUNK;
+        if (p_impl->info->aead) {
+            packets[i].status = volc_srtp_unprotect(session, packets[i].packet, &packets[i].len);
+            n = 1;
+        } else {
+            VOLC_CHK_STATUS(_volc_srtp_unprotect_chunk(p_impl, packets + i, n));
+        }
+    }
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_srtp_protect_rtcp(volc_srtp_session_t session, uint8_t* packet, uint32_t* p_len, uint32_t capacity) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_srtp_session_impl_t* p_impl = (volc_srtp_session_impl_t*)session;
+    volc_srtp_stream_t* stream = NULL;
+    uint32_t len = 0;
+    uint32_t ssrc = 0;
+    uint32_t index = 0;
+    uint8_t e_index_be[VOLC_SRTP_RTCP_INDEX_LENGTH];
+    uint8_t tag[VOLC_RTC_SHA1_DIGEST_LENGTH];
+
+    VOLC_CHK(p_impl != NULL && packet != NULL && p_len != NULL, VOLC_STATUS_NULL_ARG);
+    len = *p_len;
+    VOLC_CHK(len >= VOLC_SRTP_RTCP_HEADER_LENGTH && (packet[0] >> 6) == 2, VOLC_STATUS_SRTP_INVALID_PACKET);
+    VOLC_CHK(capacity >= len && capacity - len >= VOLC_SRTP_RTCP_INDEX_LENGTH + p_impl->rtcp.tag_length, VOLC_STATUS_BUFFER_TOO_SMALL);
+    ssrc = _volc_srtp_get_be32(packet + 4);
+    stream = _volc_srtp_stream_find(p_impl, ssrc);
+    if (stream == NULL) {
+        stream = _volc_srtp_stream_add(p_impl, ssrc);
+        VOLC_CHK(stream != NULL, VOLC_STATUS_SRTP_TOO_MANY_STREAMS);
+    }
+    VOLC_CHK(stream->rtcp_index <= VOLC_SRTP_RTCP_MAX_INDEX, VOLC_STATUS_SRTP_KEY_EXHAUSTED);
+    index = stream->rtcp_index++;
+
+    if (p_impl->info->aead) {
+        // RFC 7714 section 9.2: header | ciphertext | tag | E|index, the AAD is the header followed by E|index
+        _volc_srtp_put_be32(e_index_be, VOLC_SRTP_RTCP_E_FLAG | index);
+        VOLC_CHK_STATUS(_volc_srtp_gcm(&p_impl->rtcp, MBEDTLS_GCM_ENCRYPT, ssrc, index, packet, VOLC_SRTP_RTCP_HEADER_LENGTH, e_index_be, sizeof(e_index_be),
+                                       packet + VOLC_SRTP_RTCP_HEADER_LENGTH, len - VOLC_SRTP_RTCP_HEADER_LENGTH, packet + len));
+        memcpy(packet + len + p_impl->rtcp.tag_length, e_index_be, sizeof(e_index_be));
+        *p_len = len + p_impl->rtcp.tag_length + VOLC_SRTP_RTCP_INDEX_LENGTH;
+    } else {
+        _volc_srtp_crypt(&p_impl->rtcp, ssrc, index, packet + VOLC_SRTP_RTCP_HEADER_LENGTH, len - VOLC_SRTP_RTCP_HEADER_LENGTH);
+        _volc_srtp_put_be32(packet + len, VOLC_SRTP_RTCP_E_FLAG | index);
+        len += VOLC_SRTP_RTCP_INDEX_LENGTH;
+        _volc_srtp_auth(&p_impl->rtcp, packet, len, NULL, 0, tag);
+        memcpy(packet + len, tag, p_impl->rtcp.tag_length);
+        *p_len = len + p_impl->rtcp.tag_length;
+    }
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_srtp_unprotect_rtcp(volc_srtp_session_t session, uint8_t* packet, uint32_t* p_len) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_srtp_session_impl_t* p_impl = (volc_srtp_session_impl_t*)session;
+    volc_srtp_stream_t* stream = NULL;
+    volc_srtp_stream_t candidate;
+    uint32_t len = 0;
+    uint32_t ssrc = 0;
+    uint32_t e_index = 0;
+    uint32_t index = 0;
+    int64_t delta = 0;
+    uint8_t tag[VOLC_RTC_SHA1_DIGEST_LENGTH];
+
+    VOLC_CHK(p_impl != NULL && packet != NULL && p_len != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK(*p_len >= VOLC_SRTP_RTCP_HEADER_LENGTH + VOLC_SRTP_RTCP_INDEX_LENGTH + p_impl->rtcp.tag_length && (packet[0] >> 6) == 2,
+             VOLC_STATUS_SRTP_INVALID_PACKET);
+    ssrc = _volc_srtp_get_be32(packet + 4);
+    if (p_impl->info->aead) {
+        // the AEAD trailer puts the tag before E|index, len then covers header | ciphertext | tag
+        len = *p_len - VOLC_SRTP_RTCP_INDEX_LENGTH;
+        e_index = _volc_srtp_get_be32(packet + len);
+    } else {
+        len = *p_len - p_impl->rtcp.tag_length;
+        e_index = _volc_srtp_get_be32(packet + len - VOLC_SRTP_RTCP_INDEX_LENGTH);
+    }
+    index = e_index & VOLC_SRTP_RTCP_MAX_INDEX;
+    stream = _volc_srtp_stream_find(p_impl, ssrc);
+    if (stream == NULL) {
+        memset(&candidate, 0, sizeof(candidate));
+        candidate.ssrc = ssrc;
+        stream = &candidate;
+    }
+
+    VOLC_CHK_STATUS(_volc_srtp_replay_check(stream->rtcp_valid, stream->rtcp_index, stream->rtcp_window, index, &delta));
+    if (p_impl->info->aead) {
+        len -= p_impl->rtcp.tag_length;
+        if (e_index & VOLC_SRTP_RTCP_E_FLAG) {
+            VOLC_CHK_STATUS(_volc_srtp_gcm(&p_impl->rtcp, MBEDTLS_GCM_DECRYPT, ssrc, index, packet, VOLC_SRTP_RTCP_HEADER_LENGTH,
+                                           packet + *p_len - VOLC_SRTP_RTCP_INDEX_LENGTH, VOLC_SRTP_RTCP_INDEX_LENGTH, packet + VOLC_SRTP_RTCP_HEADER_LENGTH,
+                                           len - VOLC_SRTP_RTCP_HEADER_LENGTH, packet + len));
+        } else {
+            // unencrypted SRTCP authenticates the whole compound packet as AAD with an empty plaintext
+            VOLC_CHK_STATUS(_volc_srtp_gcm(&p_impl->rtcp, MBEDTLS_GCM_DECRYPT, ssrc, index, packet, len, packet + *p_len - VOLC_SRTP_RTCP_INDEX_LENGTH,
+                                           VOLC_SRTP_RTCP_INDEX_LENGTH, NULL, 0, packet + len));
+        }
+    } else {
+        _volc_srtp_auth(&p_impl->rtcp, packet, len, NULL, 0, tag);
+        VOLC_CHK(_volc_srtp_tag_equal(tag, packet + len, p_impl->rtcp.tag_length), VOLC_STATUS_SRTP_AUTHENTICATION_FAILED);
+        len -= VOLC_SRTP_RTCP_INDEX_LENGTH;
+    }
+
+    if (stream == &candidate) {
+        stream = _volc_srtp_stream_add(p_impl, ssrc);
+        VOLC_CHK(stream != NULL, VOLC_STATUS_SRTP_TOO_MANY_STREAMS);
+    }
+    if (!p_impl->info->aead && (e_index & VOLC_SRTP_RTCP_E_FLAG)) {
+        _volc_srtp_crypt(&p_impl->rtcp, ssrc, index, packet + VOLC_SRTP_RTCP_HEADER_LENGTH, len - VOLC_SRTP_RTCP_HEADER_LENGTH);
+    }
+    stream->rtcp_window = _volc_srtp_replay_update(stream->rtcp_valid, stream->rtcp_window, delta);
+    if (delta > 0) {
+        stream->rtcp_index = index;
+    }
+    stream->rtcp_valid = true;
+    *p_len = len;
+
+err_out_label:
+    return ret;
+}
@@ -1,63 +1,304 @@
 #include "volc_tls.h"
+#include "volc_tls_internal.h"
+
+#include <string.h>
 
 #include <mbedtls/ssl.h>
-#include <mbedtls/entropy.h>
-#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/ssl_ciphersuites.h>
 #include <mbedtls/error.h>
+#include <mbedtls/platform_util.h>
 
+#include "volc_fileio.h"
 #include "volc_memory.h"
+#include "volc_socket.h"
+#include "volc_time.h"
 #include "volc_type.h"
 
+#define VOLC_TLS_MASTER_SECRET_LENGTH 48
+#define VOLC_TLS_RANDOM_LENGTH        32
+#define VOLC_TLS_GCM_SALT_LENGTH      4
+#define VOLC_TLS_SENDFILE_CHUNK_SIZE  16384
+// dynamic record sizing: records fit in one TCP segment until the connection has carried enough data to be past slow start
+#define VOLC_TLS_SMALL_RECORD_PAYLOAD 1300
+#define VOLC_TLS_RECORD_RAMP_BYTES    (1024 * 1024)
+#define VOLC_TLS_RECORD_IDLE_RESET_MS 1000
+
 typedef struct {
     mbedtls_ssl_context ssl_ctx;
-    mbedtls_ssl_config ssl_ctx_config;
-    mbedtls_entropy_context entropy;
-    mbedtls_ctr_drbg_context ctr_drbg;
-    mbedtls_x509_crt cacert;
+    volc_tls_config_impl_t* config;
+    // the shared config ssl_ctx was set up with, NULL before the first volc_tls_start
+    const mbedtls_ssl_config* setup_conf;
+    char host[VOLC_TLS_MAX_HOST_NAME_LENGTH + 1];
+    bool is_server;
+    bool is_dtls;
+    bool session_saved;
+    bool peer_verified;
+    volc_tls_async_ready_callback async_ready_callback;
+    void* async_ready_custom_data;
+    // DTLS retransmission timer, see mbedtls_ssl_set_timer_cb
+    uint64_t timer_start_ms;
+    uint32_t timer_int_ms;
+    uint32_t timer_fin_ms;
+    // TLS 1.2 master secret kept for RFC 5705 keying material export
+    bool has_master_secret;
+    uint8_t master_secret[VOLC_TLS_MASTER_SECRET_LENGTH];
+    uint8_t randbytes[2 * VOLC_TLS_RANDOM_LENGTH];
+    mbedtls_tls_prf_types prf_type;
+    // client 0-RTT data queued before volc_tls_start
+    uint8_t* early_data;
+    size_t early_data_len;
+    size_t early_data_written;
+    bool early_data_pending;
+    // kernel TLS offload, records are encrypted by the socket once enabled
+    bool app_data_seen;
+    bool ktls_enabled;
+    int ktls_fd;
+    // write coalescing, data in [coalesce_off, coalesce_len) has not been handed to mbedtls yet
+    uint8_t* coalesce_buf;
+    uint32_t coalesce_cap;
+    uint32_t coalesce_off;
+    uint32_t coalesce_len;
+    uint32_t coalesce_max_delay_ms;
+    uint64_t coalesce_deadline_ms;
+    // dynamic record sizing
+    bool dynamic_record_sizing;
+    uint64_t ramp_bytes;
+    uint64_t last_write_ms;
+    // length of the record mbedtls_ssl_write returned WANT_WRITE for, it must be retried with the same length
+    size_t inflight_len;
 } volc_tls_mbedtls_ctx_t;
 
-uint32_t volc_tls_create(volc_tls_t* tls)
+static void _volc_tls_set_timer(void* p_ctx, uint32_t int_ms, uint32_t fin_ms) {
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)p_ctx;
+    ctx->timer_start_ms = volc_get_montionic_time_ms();
+    ctx->timer_int_ms = int_ms;
+    ctx->timer_fin_ms = fin_ms;
+}
+
+static int _volc_tls_get_timer(void* p_ctx) {
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)p_ctx;
+    uint64_t elapsed = 0;
+    if (ctx->timer_fin_ms == 0) {
+        return -1;
+    }
+    elapsed = volc_get_montionic_time_ms() - ctx->timer_start_ms;
+    if (elapsed >= ctx->timer_fin_ms) {
+        return 2;
+    }
+    if (elapsed >= ctx->timer_int_ms) {
+        return 1;
+    }
+    return 0;
+}
+
+static void _volc_tls_export_keys(void* p_ctx, mbedtls_ssl_key_export_type type, const unsigned char* secret, size_t secret_len,
+                                  const unsigned char client_random[32], const unsigned char server_random[32], mbedtls_tls_prf_types tls_prf_type) {
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)p_ctx;
+    if (type != MBEDTLS_SSL_KEY_EXPORT_TLS12_MASTER_SECRET || secret_len != VOLC_TLS_MASTER_SECRET_LENGTH) {
+        return;
+    }
+    memcpy(ctx->master_secret, secret, VOLC_TLS_MASTER_SECRET_LENGTH);
+    memcpy(ctx->randbytes, client_random, VOLC_TLS_RANDOM_LENGTH);
+    memcpy(ctx->randbytes + VOLC_TLS_RANDOM_LENGTH, server_random, VOLC_TLS_RANDOM_LENGTH);
+    ctx->prf_type = tls_prf_type;
+    ctx->has_master_secret = true;
+}
+
+// clients remember the session once the handshake finished so the next connection to the same host can resume it
+static void _volc_tls_save_session(volc_tls_mbedtls_ctx_t* ctx) {
+    if (ctx->is_server || ctx->is_dtls || ctx->session_saved) {
+        return;
+    }
+#if MBEDTLS_VERSION_NUMBER >= 0x03060000
+    if (!mbedtls_ssl_is_handshake_over(&ctx->ssl_ctx)) {
+        return;
+    }
+#else
+    if (ctx->ssl_ctx.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+        return;
+    }
+#endif
+    ctx->session_saved = true;
+    volc_tls_session_cache_save(&ctx->ssl_ctx, ctx->host);
+}
+
+static void _volc_tls_free_early_data(volc_tls_mbedtls_ctx_t* ctx) {
+    VOLC_SAFE_MEMFREE(ctx->early_data);
+    ctx->early_data = NULL;
+    ctx->early_data_len = 0;
+    ctx->early_data_pending = false;
+}
+
+uint32_t volc_tls_create_with_config(volc_tls_config_t config, volc_tls_t* tls)
 {
     uint32_t ret = VOLC_STATUS_SUCCESS;
     volc_tls_mbedtls_ctx_t* ctx = NULL;
 
-    VOLC_CHK(tls != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK(tls != NULL && config != NULL, VOLC_STATUS_NULL_ARG);
     ctx = (volc_tls_mbedtls_ctx_t*) volc_malloc(sizeof(volc_tls_mbedtls_ctx_t));
     VOLC_CHK(ctx != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    memset(ctx, 0, sizeof(volc_tls_mbedtls_ctx_t));
+    mbedtls_ssl_init(&ctx->ssl_ctx);
+    ctx->config = (volc_tls_config_impl_t*)config;
+    volc_tls_config_retain(ctx->config);
     *tls = (volc_tls_t)ctx;
 
-    mbedtls_ssl_init(&ctx->ssl_ctx);
-    mbedtls_ssl_config_init(&ctx->ssl_ctx_config);
-    mbedtls_x509_crt_init(&ctx->cacert);
-    mbedtls_ctr_drbg_init(&ctx->ctr_drbg);
-    mbedtls_entropy_init(&ctx->entropy);
-    VOLC_CHK(mbedtls_ctr_drbg_seed(&ctx->ctr_drbg, mbedtls_entropy_func, &ctx->entropy, NULL, 0) == 0, VOLC_STATUS_CREATE_SSL_FAILED);
+err_out_label:
     return ret;
+}
+
+void volc_tls_get_default_options(volc_tls_options_t* options)
+{
+    if (NULL == options) {
+        return;
+    }
+    memset(options, 0, sizeof(volc_tls_options_t));
+}
+
+uint32_t volc_tls_create_ex(const volc_tls_options_t* options, volc_tls_t* tls)
+{
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_config_impl_t* config = NULL;
+    volc_tls_t created = NULL;
+
+    VOLC_CHK(options != NULL && tls != NULL, VOLC_STATUS_NULL_ARG);
+    if (options->config != NULL) {
+        config = (volc_tls_config_impl_t*)options->config;
+        // a shared config carries its own fragment length
+        VOLC_CHK(options->max_fragment_length == 0 || options->max_fragment_length == config->max_fragment_length, VOLC_STATUS_INVALID_ARG);
+    } else {
+        config = volc_tls_config_get_default(options->max_fragment_length);
+        VOLC_CHK(config != NULL, VOLC_STATUS_INVALID_ARG);
+    }
+    VOLC_CHK_STATUS(volc_tls_create_with_config((volc_tls_config_t)config, &created));
+    VOLC_CHK_STATUS(volc_tls_set_write_coalescing(created, options->write_coalescing_size, options->write_coalescing_delay_ms));
+    VOLC_CHK_STATUS(volc_tls_set_dynamic_record_sizing(created, options->dynamic_record_sizing));
+    *tls = created;
+
 err_out_label:
-    if (ctx) {
-        volc_free(ctx);
+    if (VOLC_STATUS_FAILED(ret) && created != NULL) {
+        volc_tls_destroy(created);
     }
     return ret;
 }
 
+uint32_t volc_tls_create(volc_tls_t* tls)
+{
+    volc_tls_config_impl_t* config = volc_tls_config_get_default(0);
+    if (NULL == config) {
+        return VOLC_STATUS_CREATE_SSL_FAILED;
+    }
+    return volc_tls_create_with_config((volc_tls_config_t)config, tls);
+}
+
 uint32_t volc_tls_destroy(volc_tls_t tls)
 {
     volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*) tls;
     if (NULL == tls) {
         return VOLC_STATUS_SUCCESS;
     }
-    while (mbedtls_ssl_close_notify(&ctx->ssl_ctx) == MBEDTLS_ERR_SSL_WANT_WRITE) {
-        // keep flushing outgoing buffer until nothing left
+    if (ctx->setup_conf != NULL && !ctx->ktls_enabled) {
+        while (mbedtls_ssl_close_notify(&ctx->ssl_ctx) == MBEDTLS_ERR_SSL_WANT_WRITE) {
+            // keep flushing outgoing buffer until nothing left
+        }
     }
     mbedtls_ssl_free(&ctx->ssl_ctx);
-    mbedtls_ssl_config_free(&ctx->ssl_ctx_config);
-    mbedtls_x509_crt_free(&ctx->cacert);
-    mbedtls_ctr_drbg_free(&ctx->ctr_drbg);
-    mbedtls_entropy_free(&ctx->entropy);
+    mbedtls_platform_zeroize(ctx->master_secret, sizeof(ctx->master_secret));
+    _volc_tls_free_early_data(ctx);
+    VOLC_SAFE_MEMFREE(ctx->coalesce_buf);
+    volc_tls_config_release(ctx->config);
     volc_free(ctx);
     return VOLC_STATUS_SUCCESS;
 }
 
+static bool _volc_tls_needs_peer_verification(volc_tls_mbedtls_ctx_t* ctx) {
+    return !ctx->is_server && !ctx->is_dtls && ctx->config->verify_peer && !ctx->peer_verified;
+}
+
+// sends queued early data along with the ClientHello, then continues with the regular handshake
+static int _volc_tls_handshake(volc_tls_mbedtls_ctx_t* ctx) {
+    int ret = 0;
+#if defined(MBEDTLS_SSL_EARLY_DATA) && defined(MBEDTLS_SSL_CLI_C)
+    while (ctx->early_data_pending) {
+        ret = mbedtls_ssl_write_early_data(&ctx->ssl_ctx, ctx->early_data + ctx->early_data_written, ctx->early_data_len - ctx->early_data_written);
+        if (ret > 0) {
+            ctx->early_data_written += (size_t)ret;
+            ctx->early_data_pending = ctx->early_data_written < ctx->early_data_len;
+        } else if (ret == MBEDTLS_ERR_SSL_CANNOT_WRITE_EARLY_DATA) {
+            // no resumable session, or the server's early data budget is used up
+            ctx->early_data_pending = false;
+        } else {
+            return ret;
+        }
+    }
+#endif
+    ret = mbedtls_ssl_handshake(&ctx->ssl_ctx);
+    if (ret == 0 && _volc_tls_needs_peer_verification(ctx)) {
+        ret = volc_tls_verify_peer(ctx->config, mbedtls_ssl_get_peer_cert(&ctx->ssl_ctx), ctx->host);
+        if (ret != 0) {
+            mbedtls_ssl_send_alert_message(&ctx->ssl_ctx, MBEDTLS_SSL_ALERT_LEVEL_FATAL, MBEDTLS_SSL_ALERT_MSG_BAD_CERT);
+            volc_tls_session_cache_remove(ctx->host);
+            return ret;
+        }
+        ctx->peer_verified = true;
+    }
+    if (ret == 0) {
+        _volc_tls_save_session(ctx);
+        // early_data_written is kept for volc_tls_get_early_data_status
+        _volc_tls_free_early_data(ctx);
+    }
+    return ret;
+}
+
+// application data only flows once the peer chain is verified; mbedtls_ssl_read/write would otherwise finish the
+// handshake on their own and skip the check, and after a failed check the connection stays unusable
+static int _volc_tls_check_peer(volc_tls_mbedtls_ctx_t* ctx) {
+    if (!_volc_tls_needs_peer_verification(ctx)) {
+        return 0;
+    }
+    if (!volc_tls_is_handshake_over((volc_tls_t)ctx)) {
+        return _volc_tls_handshake(ctx);
+    }
+    return MBEDTLS_ERR_X509_CERT_VERIFY_FAILED;
+}
+
+static int _volc_tls_setup(volc_tls_mbedtls_ctx_t* ctx, const mbedtls_ssl_config* conf, volc_tls_send_callback send_callback, volc_tls_recv_callback recv_callback, void* custom_data)
+{
+    int ret = 0;
+    if (ctx->setup_conf == conf) {
+        // restarting on the same endpoint keeps the record buffers allocated by mbedtls_ssl_setup
+        ret = mbedtls_ssl_session_reset(&ctx->ssl_ctx);
+    } else {
+        if (ctx->setup_conf != NULL) {
+            mbedtls_ssl_free(&ctx->ssl_ctx);
+            mbedtls_ssl_init(&ctx->ssl_ctx);
+            ctx->setup_conf = NULL;
+        }
+        ret = mbedtls_ssl_setup(&ctx->ssl_ctx, conf);
+    }
+    if (ret != 0) {
+        return ret;
+    }
+    ctx->setup_conf = conf;
+    ctx->session_saved = false;
+    ctx->peer_verified = false;
+    ctx->has_master_secret = false;
+    ctx->early_data_written = 0;
+    ctx->timer_fin_ms = 0;
+    ctx->app_data_seen = false;
+    ctx->ktls_enabled = false;
+    ctx->coalesce_off = 0;
+    ctx->coalesce_len = 0;
+    ctx->ramp_bytes = 0;
+    ctx->inflight_len = 0;
+    ctx->async_ready_callback = NULL;
+    ctx->async_ready_custom_data = NULL;
+    mbedtls_ssl_set_export_keys_cb(&ctx->ssl_ctx, _volc_tls_export_keys, ctx);
+    mbedtls_ssl_set_user_data_p(&ctx->ssl_ctx, ctx);
+    mbedtls_ssl_set_bio(&ctx->ssl_ctx, custom_data, send_callback, recv_callback, NULL);
+    return 0;
+}
+
 int volc_tls_start(volc_tls_t tls, bool is_server, const char* host, volc_tls_send_callback send_callback, volc_tls_recv_callback recv_callback, void* custom_data)
 {
     int ret = 0;
@@ -66,35 +307,357 @@ int volc_tls_start(volc_tls_t tls, bool is_server, const char* host, volc_tls_se
         return -1;
     }
 
-    mbedtls_ssl_config_defaults(&(ctx->ssl_ctx_config), is_server ? MBEDTLS_SSL_IS_SERVER : MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT);
-    mbedtls_ssl_conf_ca_chain(&ctx->ssl_ctx_config, &(ctx->cacert), NULL);
-    mbedtls_ssl_conf_authmode(&ctx->ssl_ctx_config, MBEDTLS_SSL_VERIFY_NONE);
-    mbedtls_ssl_conf_rng(&ctx->ssl_ctx_config, mbedtls_ctr_drbg_random, &ctx->ctr_drbg);
-    mbedtls_ssl_setup(&ctx->ssl_ctx, &ctx->ssl_ctx_config);
-
+    ret = _volc_tls_setup(ctx, is_server ? &ctx->config->server_conf : &ctx->config->client_conf, send_callback, recv_callback, custom_data);
+    if (ret != 0) {
+        return ret;
+    }
     mbedtls_ssl_set_hostname( &ctx->ssl_ctx, host);
-    mbedtls_ssl_set_bio(&ctx->ssl_ctx, custom_data, send_callback, recv_callback, NULL);
+    ctx->is_server = is_server;
+    ctx->is_dtls = false;
+    strncpy(ctx->host, host, VOLC_TLS_MAX_HOST_NAME_LENGTH);
+    ctx->host[VOLC_TLS_MAX_HOST_NAME_LENGTH] = '\0';
+    if (!is_server) {
+        volc_tls_session_cache_load(&ctx->ssl_ctx, host);
+    }
+    ctx->early_data_pending = !is_server && ctx->early_data_len > 0;
     /* init and send handshake */
-    ret = mbedtls_ssl_handshake(&ctx->ssl_ctx);
+    return _volc_tls_handshake(ctx);
+}
+
+int volc_tls_start_dtls(volc_tls_t tls, bool is_server, uint16_t mtu, volc_tls_send_callback send_callback, volc_tls_recv_callback recv_callback, void* custom_data)
+{
+    int ret = 0;
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+    if (NULL == tls || NULL == send_callback || NULL == recv_callback) {
+        return -1;
+    }
+
+    ret = _volc_tls_setup(ctx, is_server ? &ctx->config->dtls_server_conf : &ctx->config->dtls_client_conf, send_callback, recv_callback, custom_data);
+    if (ret != 0) {
+        return ret;
+    }
+    ctx->is_server = is_server;
+    ctx->is_dtls = true;
+    ctx->host[0] = '\0';
+    mbedtls_ssl_set_timer_cb(&ctx->ssl_ctx, ctx, _volc_tls_set_timer, _volc_tls_get_timer);
+    if (mtu > 0) {
+        // handshake flights are fragmented so that no datagram exceeds the path MTU
+        mbedtls_ssl_set_mtu(&ctx->ssl_ctx, mtu);
+    }
+    return mbedtls_ssl_handshake(&ctx->ssl_ctx);
+}
+
+uint64_t volc_tls_get_timeout_ms(volc_tls_t tls)
+{
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+    uint64_t elapsed = 0;
+    if (NULL == tls || !ctx->is_dtls || ctx->timer_fin_ms == 0) {
+        return VOLC_INFINITE_TIME_VALUE;
+    }
+    elapsed = volc_get_montionic_time_ms() - ctx->timer_start_ms;
+    return elapsed >= ctx->timer_fin_ms ? 0 : ctx->timer_fin_ms - elapsed;
+}
+
+uint32_t volc_tls_export_srtp_keying_material(volc_tls_t tls, volc_srtp_keying_material_t* p_material)
+{
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+    uint8_t key_block[2 * (VOLC_SRTP_MAX_MASTER_KEY_LENGTH + VOLC_SRTP_MAX_MASTER_SALT_LENGTH)];
+    uint32_t key_len = 0;
+    uint32_t salt_len = 0;
+    const uint8_t* client_key = NULL;
+    const uint8_t* server_key = NULL;
+    const uint8_t* client_salt = NULL;
+    const uint8_t* server_salt = NULL;
+#if defined(MBEDTLS_SSL_DTLS_SRTP)
+    mbedtls_dtls_srtp_info srtp_info;
+#endif
+
+    VOLC_CHK(ctx != NULL && p_material != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK(ctx->is_dtls && ctx->has_master_secret && volc_tls_is_handshake_over(tls), VOLC_STATUS_SSL_PACKET_BEFORE_DTLS_READY);
+#if defined(MBEDTLS_SSL_DTLS_SRTP)
+    mbedtls_ssl_get_dtls_srtp_negotiation_result(&ctx->ssl_ctx, &srtp_info);
+    switch (srtp_info.MBEDTLS_PRIVATE(chosen_dtls_srtp_profile)) {
+        case MBEDTLS_TLS_SRTP_AES128_CM_HMAC_SHA1_80:
+            p_material->profile = VOLC_SRTP_PROFILE_AES128_CM_HMAC_SHA1_80;
+            break;
+        case MBEDTLS_TLS_SRTP_AES128_CM_HMAC_SHA1_32:
+            p_material->profile = VOLC_SRTP_PROFILE_AES128_CM_HMAC_SHA1_32;
+            break;
+        default:
+            VOLC_CHK(0, VOLC_STATUS_SSL_UNKNOWN_SRTP_PROFILE);
+    }
+#else
+    VOLC_CHK(0, VOLC_STATUS_SSL_UNKNOWN_SRTP_PROFILE);
+#endif
+    key_len = VOLC_AES128_KEY_LENGTH;
+    salt_len = VOLC_SRTP_CM_MASTER_SALT_LENGTH;
+
+    // RFC 5764 section 4.2: client key | server key | client salt | server salt
+    VOLC_CHK(mbedtls_ssl_tls_prf(ctx->prf_type, ctx->master_secret, sizeof(ctx->master_secret), VOLC_KEYING_EXTRACTOR_LABEL, ctx->randbytes,
+                                 sizeof(ctx->randbytes), key_block, 2 * (key_len + salt_len)) == 0,
+             VOLC_STATUS_INTERNAL_ERROR);
+    client_key = key_block;
+    server_key = client_key + key_len;
+    client_salt = server_key + key_len;
+    server_salt = client_salt + salt_len;
+
+    memcpy(p_material->local_master_key, ctx->is_server ? server_key : client_key, key_len);
+    memcpy(p_material->remote_master_key, ctx->is_server ? client_key : server_key, key_len);
+    memcpy(p_material->local_master_salt, ctx->is_server ? server_salt : client_salt, salt_len);
+    memcpy(p_material->remote_master_salt, ctx->is_server ? client_salt : server_salt, salt_len);
+    p_material->master_key_length = key_len;
+    p_material->master_salt_length = salt_len;
 
 err_out_label:
+    mbedtls_platform_zeroize(key_block, sizeof(key_block));
     return ret;
 }
 
+uint32_t volc_tls_get_peer_certificate(volc_tls_t tls, const uint8_t** p_der, size_t* p_len)
+{
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+    const mbedtls_x509_crt* peer = NULL;
+
+    VOLC_CHK(ctx != NULL && p_der != NULL && p_len != NULL, VOLC_STATUS_NULL_ARG);
+    peer = mbedtls_ssl_get_peer_cert(&ctx->ssl_ctx);
+    VOLC_CHK(peer != NULL, VOLC_STATUS_NOT_FOUND);
+    *p_der = peer->raw.p;
+    *p_len = peer->raw.len;
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_tls_handshake_step(volc_tls_t tls, short* p_events)
+{
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+    int r = 0;
+
+    VOLC_CHK(ctx != NULL && p_events != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK(ctx->setup_conf != NULL, VOLC_STATUS_INVALID_OPERATION);
+    *p_events = 0;
+    // mbedtls_ssl_handshake runs as many steps as the bio allows and stops at the first WANT_*
+    r = _volc_tls_handshake(ctx);
+    switch (r) {
+        case 0:
+            break;
+        case MBEDTLS_ERR_SSL_WANT_READ:
+            *p_events = VOLC_EVLOOP_POLLIN;
+            ret = VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY;
+            break;
+        case MBEDTLS_ERR_SSL_WANT_WRITE:
+            *p_events = VOLC_EVLOOP_POLLOUT;
+            ret = VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY;
+            break;
+#if defined(MBEDTLS_ERR_SSL_ASYNC_IN_PROGRESS)
+        case MBEDTLS_ERR_SSL_ASYNC_IN_PROGRESS:
+#endif
+#if defined(MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS)
+        case MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS:
+#endif
+            // no socket I/O needed, the caller retries once the pending operation completes
+            ret = VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY;
+            break;
+        case MBEDTLS_ERR_X509_CERT_VERIFY_FAILED:
+            ret = VOLC_STATUS_SSL_REMOTE_CERTIFICATE_VERIFICATION_FAILED;
+            break;
+        default:
+            if (!ctx->is_server) {
+                // do not keep offering a session the server just refused
+                volc_tls_session_cache_remove(ctx->host);
+            }
+            ret = VOLC_STATUS_SSL_CONNECTION_FAILED;
+            break;
+    }
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_tls_set_transport(volc_tls_t tls, volc_tls_send_callback send_callback, volc_tls_recv_callback recv_callback, void* custom_data)
+{
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+
+    VOLC_CHK(ctx != NULL && send_callback != NULL && recv_callback != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK(ctx->setup_conf != NULL, VOLC_STATUS_INVALID_OPERATION);
+    mbedtls_ssl_set_bio(&ctx->ssl_ctx, custom_data, send_callback, recv_callback, NULL);
+
+err_out_label:
+    return ret;
+}
+
+int32_t volc_tls_socket_send(void* custom_data, const unsigned char* buf, unsigned long len)
+{
+    uint32_t status = VOLC_STATUS_SUCCESS;
+    ssize_t r = volc_send_msg((int)(intptr_t)custom_data, (void*)buf, len, NULL, &status);
+    if (r >= 0) {
+        return (int32_t)r;
+    }
+    return status == VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY ? MBEDTLS_ERR_SSL_WANT_WRITE : MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+}
+
+int32_t volc_tls_socket_recv(void* custom_data, unsigned char* buf, unsigned long len)
+{
+    uint32_t status = VOLC_STATUS_SUCCESS;
+    ssize_t r = volc_recv_msg((int)(intptr_t)custom_data, buf, len, NULL, &status);
+    if (r > 0) {
+        return (int32_t)r;
+    }
+    if (r == 0) {
+        return MBEDTLS_ERR_SSL_CONN_EOF;
+    }
+    return status == VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY ? MBEDTLS_ERR_SSL_WANT_READ : MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+}
+
+static int _volc_tls_ktls_read(volc_tls_mbedtls_ctx_t* ctx, unsigned char* buf, size_t len) {
+    uint32_t status = VOLC_STATUS_SUCCESS;
+    ssize_t r = volc_ktls_recv(ctx->ktls_fd, buf, len, &status);
+    if (r > 0) {
+        return (int)r;
+    }
+    switch (status) {
+        case VOLC_STATUS_SUCCESS:
+            return MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY;
+        case VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY:
+            return MBEDTLS_ERR_SSL_WANT_READ;
+        case VOLC_STATUS_SSL_CONNECTION_FAILED:
+            return MBEDTLS_ERR_SSL_FATAL_ALERT_MESSAGE;
+        default:
+            return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+    }
+}
+
+static int _volc_tls_ktls_write(volc_tls_mbedtls_ctx_t* ctx, const unsigned char* buf, size_t len) {
+    uint32_t status = VOLC_STATUS_SUCCESS;
+    ssize_t r = volc_ktls_send(ctx->ktls_fd, buf, len, &status);
+    if (r >= 0) {
+        return (int)r;
+    }
+    return status == VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY ? MBEDTLS_ERR_SSL_WANT_WRITE : MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+}
+
 int volc_tls_read(volc_tls_t tls, unsigned char* buf, size_t len) {
+    int ret = 0;
     volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
     if (NULL == tls) {
         return -1;
     }
-    return mbedtls_ssl_read(&ctx->ssl_ctx, buf, len);
+    ret = _volc_tls_check_peer(ctx);
+    if (ret != 0) {
+        return ret;
+    }
+    if (ctx->ktls_enabled) {
+        return _volc_tls_ktls_read(ctx, buf, len);
+    }
+    ctx->app_data_seen = true;
+    ret = mbedtls_ssl_read(&ctx->ssl_ctx, buf, len);
+#if defined(MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET)
+    while (ret == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET) {
+        // TLS 1.3 tickets arrive after the handshake, refresh the cached session with the newest one
+        ctx->session_saved = false;
+        _volc_tls_save_session(ctx);
+        ret = mbedtls_ssl_read(&ctx->ssl_ctx, buf, len);
+    }
+#endif
+    _volc_tls_save_session(ctx);
+    return ret;
+}
+
+// writes at most one record
+static int _volc_tls_write_record(volc_tls_mbedtls_ctx_t* ctx, const unsigned char* buf, size_t len) {
+    int ret = 0;
+    uint64_t now = 0;
+    ret = _volc_tls_check_peer(ctx);
+    if (ret != 0) {
+        return ret;
+    }
+    if (ctx->ktls_enabled) {
+        return _volc_tls_ktls_write(ctx, buf, len);
+    }
+    ctx->app_data_seen = true;
+    if (ctx->inflight_len > 0 && ctx->inflight_len <= len) {
+        len = ctx->inflight_len;
+    } else if (ctx->dynamic_record_sizing) {
+        now = volc_get_montionic_time_ms();
+        // an idle connection is back in slow start
+        if (now - ctx->last_write_ms >= VOLC_TLS_RECORD_IDLE_RESET_MS) {
+            ctx->ramp_bytes = 0;
+        }
+        if (ctx->ramp_bytes < VOLC_TLS_RECORD_RAMP_BYTES) {
+            len = VOLC_MIN(len, VOLC_TLS_SMALL_RECORD_PAYLOAD);
+        }
+    }
+    ret = mbedtls_ssl_write(&ctx->ssl_ctx, buf, len);
+    ctx->inflight_len = ret == MBEDTLS_ERR_SSL_WANT_WRITE ? len : 0;
+    if (ret > 0 && ctx->dynamic_record_sizing) {
+        ctx->ramp_bytes += (uint64_t)ret;
+        ctx->last_write_ms = volc_get_montionic_time_ms();
+    }
+    _volc_tls_save_session(ctx);
+    return ret;
+}
+
+static int _volc_tls_flush(volc_tls_mbedtls_ctx_t* ctx) {
+    int ret = 0;
+    while (ctx->coalesce_off < ctx->coalesce_len) {
+        ret = _volc_tls_write_record(ctx, ctx->coalesce_buf + ctx->coalesce_off, ctx->coalesce_len - ctx->coalesce_off);
+        if (ret <= 0) {
+            return ret;
+        }
+        ctx->coalesce_off += (uint32_t)ret;
+    }
+    ctx->coalesce_off = 0;
+    ctx->coalesce_len = 0;
+    return 0;
 }
 
 int volc_tls_write(volc_tls_t tls, const unsigned char* buf, size_t len) {
+    int ret = 0;
     volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+    uint64_t now = 0;
     if (NULL == tls) {
         return -1;
     }
-    return mbedtls_ssl_write(&ctx->ssl_ctx, buf, len);
+    // checked before the data is accepted into the coalescing buffer
+    ret = _volc_tls_check_peer(ctx);
+    if (ret != 0) {
+        return ret;
+    }
+    if (NULL == ctx->coalesce_buf) {
+        return _volc_tls_write_record(ctx, buf, len);
+    }
+    now = volc_get_montionic_time_ms();
+    if (ctx->coalesce_len > 0 && (ctx->coalesce_len + len > ctx->coalesce_cap || now >= ctx->coalesce_deadline_ms)) {
+        ret = _volc_tls_flush(ctx);
+        if (ret != 0 && ctx->coalesce_len - ctx->coalesce_off + len > ctx->coalesce_cap) {
+            return ret;
+        }
+    }
+    if (ctx->coalesce_len == 0 && len >= ctx->coalesce_cap) {
+        return _volc_tls_write_record(ctx, buf, len);
+    }
+    if (ctx->coalesce_off > 0) {
+        memmove(ctx->coalesce_buf, ctx->coalesce_buf + ctx->coalesce_off, ctx->coalesce_len - ctx->coalesce_off);
+        ctx->coalesce_len -= ctx->coalesce_off;
+        ctx->coalesce_off = 0;
+    }
+    if (ctx->coalesce_len == 0) {
+        ctx->coalesce_deadline_ms = now + ctx->coalesce_max_delay_ms;
+    }
+    memcpy(ctx->coalesce_buf + ctx->coalesce_len, buf, len);
+    ctx->coalesce_len += (uint32_t)len;
+    if (ctx->coalesce_max_delay_ms == 0) {
+        // on WANT_WRITE the data stays buffered for the next write or flush, any other error is fatal for the connection
+        ret = _volc_tls_flush(ctx);
+        if (ret != 0 && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+            return ret;
+        }
+    }
+    return (int)len;
 }
 
 bool volc_tls_is_handshake_over(volc_tls_t tls) {
@@ -113,8 +676,343 @@ bool volc_tls_is_handshake_over(volc_tls_t tls) {
 
 size_t volc_tls_get_bytes_avail(volc_tls_t tls) {
     volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
-    if (NULL == tls) {
+    if (NULL == tls || ctx->ktls_enabled) {
         return 0;
     }
     return mbedtls_ssl_get_bytes_avail(&ctx->ssl_ctx);
 }
+
+uint32_t volc_tls_queue_early_data(volc_tls_t tls, const uint8_t* data, size_t len)
+{
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+    uint8_t* buf = NULL;
+
+    VOLC_CHK(ctx != NULL && data != NULL, VOLC_STATUS_NULL_ARG);
+#if defined(MBEDTLS_SSL_EARLY_DATA) && defined(MBEDTLS_SSL_CLI_C)
+    VOLC_CHK(len > 0, VOLC_STATUS_INVALID_ARG_LEN);
+    buf = (uint8_t*)volc_malloc(ctx->early_data_len + len);
+    VOLC_CHK(buf != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    if (ctx->early_data_len > 0) {
+        memcpy(buf, ctx->early_data, ctx->early_data_len);
+    }
+    memcpy(buf + ctx->early_data_len, data, len);
+    VOLC_SAFE_MEMFREE(ctx->early_data);
+    ctx->early_data = buf;
+    ctx->early_data_len += len;
+#else
+    VOLC_UNUSED_PARAM(buf);
+    VOLC_CHK(0, VOLC_STATUS_NOT_IMPLEMENTED);
+#endif
+
+err_out_label:
+    return ret;
+}
+
+volc_tls_early_data_status_e volc_tls_get_early_data_status(volc_tls_t tls, size_t* p_written)
+{
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+    volc_tls_early_data_status_e status = VOLC_TLS_EARLY_DATA_NOT_SENT;
+
+    if (p_written != NULL) {
+        *p_written = 0;
+    }
+    if (NULL == tls || ctx->is_server || ctx->early_data_written == 0 || !volc_tls_is_handshake_over(tls)) {
+        return status;
+    }
+#if defined(MBEDTLS_SSL_EARLY_DATA) && defined(MBEDTLS_SSL_CLI_C)
+    switch (mbedtls_ssl_get_early_data_status(&ctx->ssl_ctx)) {
+        case MBEDTLS_SSL_EARLY_DATA_STATUS_ACCEPTED:
+            status = VOLC_TLS_EARLY_DATA_ACCEPTED;
+            if (p_written != NULL) {
+                *p_written = ctx->early_data_written;
+            }
+            break;
+        case MBEDTLS_SSL_EARLY_DATA_STATUS_REJECTED:
+            status = VOLC_TLS_EARLY_DATA_REJECTED;
+            break;
+        default:
+            break;
+    }
+#endif
+    return status;
+}
+
+static volc_ktls_cipher_e _volc_tls_ktls_cipher(int ciphersuite_id) {
+    switch (ciphersuite_id) {
+        case MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256:
+        case MBEDTLS_TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256:
+        case MBEDTLS_TLS_DHE_RSA_WITH_AES_128_GCM_SHA256:
+        case MBEDTLS_TLS_RSA_WITH_AES_128_GCM_SHA256:
+            return VOLC_KTLS_CIPHER_AES_128_GCM;
+        case MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384:
+        case MBEDTLS_TLS_ECDHE_RSA_WITH_AES_256_GCM_SHA384:
+        case MBEDTLS_TLS_DHE_RSA_WITH_AES_256_GCM_SHA384:
+        case MBEDTLS_TLS_RSA_WITH_AES_256_GCM_SHA384:
+            return VOLC_KTLS_CIPHER_AES_256_GCM;
+        default:
+            return (volc_ktls_cipher_e)0;
+    }
+}
+
+uint32_t volc_tls_enable_ktls(volc_tls_t tls, int sockfd)
+{
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+    volc_ktls_crypto_info_t client_info;
+    volc_ktls_crypto_info_t server_info;
+    volc_ktls_cipher_e cipher = (volc_ktls_cipher_e)0;
+    uint8_t seed[2 * VOLC_TLS_RANDOM_LENGTH];
+    uint8_t key_block[2 * 32 + 2 * VOLC_TLS_GCM_SALT_LENGTH];
+    size_t key_len = 0;
+
+    memset(&client_info, 0, sizeof(client_info));
+    memset(&server_info, 0, sizeof(server_info));
+    memset(key_block, 0, sizeof(key_block));
+    VOLC_CHK(ctx != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK(!ctx->ktls_enabled, VOLC_STATUS_SUCCESS);
+    VOLC_CHK(!ctx->is_dtls && volc_tls_is_handshake_over(tls), VOLC_STATUS_INVALID_OPERATION);
+    VOLC_CHK(!_volc_tls_needs_peer_verification(ctx), VOLC_STATUS_SSL_REMOTE_CERTIFICATE_VERIFICATION_FAILED);
+    // the kernel starts from a known record sequence number, so the switch must happen before any application record
+    // and without anything buffered in mbedtls
+    VOLC_CHK(!ctx->app_data_seen && mbedtls_ssl_get_bytes_avail(&ctx->ssl_ctx) == 0 && !mbedtls_ssl_check_pending(&ctx->ssl_ctx),
+             VOLC_STATUS_INVALID_OPERATION);
+    // only TLS 1.2 exports the master secret; TLS 1.3 connections stay in user space because post-handshake messages
+    // (NewSessionTicket, KeyUpdate) arrive on the same record stream and need mbedtls
+    VOLC_CHK(ctx->has_master_secret, VOLC_STATUS_NOT_IMPLEMENTED);
+    cipher = _volc_tls_ktls_cipher(mbedtls_ssl_get_ciphersuite_id_from_ssl(&ctx->ssl_ctx));
+    VOLC_CHK(cipher != 0, VOLC_STATUS_NOT_IMPLEMENTED);
+    key_len = cipher == VOLC_KTLS_CIPHER_AES_256_GCM ? 32 : 16;
+
+    // RFC 5246 6.3, AEAD suites have no MAC keys: client_write_key, server_write_key, client_write_IV, server_write_IV
+    memcpy(seed, ctx->randbytes + VOLC_TLS_RANDOM_LENGTH, VOLC_TLS_RANDOM_LENGTH);
+    memcpy(seed + VOLC_TLS_RANDOM_LENGTH, ctx->randbytes, VOLC_TLS_RANDOM_LENGTH);
+    VOLC_CHK(mbedtls_ssl_tls_prf(ctx->prf_type, ctx->master_secret, VOLC_TLS_MASTER_SECRET_LENGTH, "key expansion", seed, sizeof(seed), key_block,
+                                 2 * key_len + 2 * VOLC_TLS_GCM_SALT_LENGTH) == 0,
+             VOLC_STATUS_INTERNAL_ERROR);
+    client_info.cipher = cipher;
+    server_info.cipher = cipher;
+    memcpy(client_info.key, key_block, key_len);
+    memcpy(server_info.key, key_block + key_len, key_len);
+    memcpy(client_info.salt, key_block + 2 * key_len, VOLC_TLS_GCM_SALT_LENGTH);
+    memcpy(server_info.salt, key_block + 2 * key_len + VOLC_TLS_GCM_SALT_LENGTH, VOLC_TLS_GCM_SALT_LENGTH);
+    // Finished was record 0 under the new keys in both directions; mbedtls uses the sequence number as explicit nonce
+    client_info.rec_seq[7] = 1;
+    client_info.iv[7] = 1;
+    server_info.rec_seq[7] = 1;
+    server_info.iv[7] = 1;
+
+    ret = ctx->is_server ? volc_sockopt_set_ktls(sockfd, &server_info, &client_info) : volc_sockopt_set_ktls(sockfd, &client_info, &server_info);
+    VOLC_CHK_STATUS(ret);
+    ctx->ktls_enabled = true;
+    ctx->ktls_fd = sockfd;
+
+err_out_label:
+    mbedtls_platform_zeroize(key_block, sizeof(key_block));
+    mbedtls_platform_zeroize(&client_info, sizeof(client_info));
+    mbedtls_platform_zeroize(&server_info, sizeof(server_info));
+    return ret;
+}
+
+bool volc_tls_is_ktls_enabled(volc_tls_t tls)
+{
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+    return ctx != NULL && ctx->ktls_enabled;
+}
+
+int64_t volc_tls_sendfile(volc_tls_t tls, int file_fd, int64_t offset, size_t count)
+{
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+    uint32_t status = VOLC_STATUS_SUCCESS;
+    uint8_t* buf = NULL;
+    ssize_t r = 0;
+    int ret = 0;
+
+    if (NULL == tls || file_fd < 0) {
+        return -1;
+    }
+    if (ctx->ktls_enabled) {
+        r = volc_sendfile(ctx->ktls_fd, file_fd, offset, count, &status);
+        if (r >= 0) {
+            return r;
+        }
+        if (status == VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY) {
+            return MBEDTLS_ERR_SSL_WANT_WRITE;
+        }
+        if (status != VOLC_STATUS_NOT_IMPLEMENTED) {
+            return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+        }
+    }
+    // user space path: the same offset is re-read after WANT_WRITE, which is what mbedtls_ssl_write expects
+    count = VOLC_MIN(count, VOLC_TLS_SENDFILE_CHUNK_SIZE);
+    buf = (uint8_t*)volc_malloc(count > 0 ? count : 1);
+    if (NULL == buf) {
+        return MBEDTLS_ERR_SSL_ALLOC_FAILED;
+    }
+    r = volc_file_pread(file_fd, buf, count, offset, &status);
+    if (r <= 0) {
+        ret = r == 0 ? 0 : MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+    } else {
+        ret = volc_tls_write(tls, buf, (size_t)r);
+    }
+    volc_free(buf);
+    return ret;
+}
+
+uint32_t volc_tls_set_write_coalescing(volc_tls_t tls, uint32_t buffer_size, uint32_t max_delay_ms)
+{
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+    uint8_t* buf = NULL;
+
+    VOLC_CHK(ctx != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK(ctx->coalesce_len == 0, VOLC_STATUS_INVALID_OPERATION);
+    VOLC_CHK(!ctx->is_dtls, VOLC_STATUS_INVALID_OPERATION);
+    if (buffer_size > 0) {
+        buf = (uint8_t*)volc_malloc(buffer_size);
+        VOLC_CHK(buf != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    }
+    VOLC_SAFE_MEMFREE(ctx->coalesce_buf);
+    ctx->coalesce_buf = buf;
+    ctx->coalesce_cap = buffer_size;
+    ctx->coalesce_max_delay_ms = max_delay_ms;
+
+err_out_label:
+    return ret;
+}
+
+int volc_tls_flush(volc_tls_t tls)
+{
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+    if (NULL == tls) {
+        return -1;
+    }
+    return _volc_tls_flush(ctx);
+}
+
+uint64_t volc_tls_get_flush_timeout_ms(volc_tls_t tls)
+{
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+    uint64_t now = 0;
+    if (NULL == tls || ctx->coalesce_off >= ctx->coalesce_len) {
+        return VOLC_INFINITE_TIME_VALUE;
+    }
+    now = volc_get_montionic_time_ms();
+    return now >= ctx->coalesce_deadline_ms ? 0 : ctx->coalesce_deadline_ms - now;
+}
+
+uint32_t volc_tls_set_dynamic_record_sizing(volc_tls_t tls, bool enable)
+{
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+
+    VOLC_CHK(ctx != NULL, VOLC_STATUS_NULL_ARG);
+    ctx->dynamic_record_sizing = enable;
+    ctx->ramp_bytes = 0;
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_tls_get_memory_report(volc_tls_t tls, volc_tls_memory_report_t* p_report)
+{
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+
+    VOLC_CHK(ctx != NULL && p_report != NULL, VOLC_STATUS_NULL_ARG);
+    memset(p_report, 0, sizeof(volc_tls_memory_report_t));
+    p_report->context_size = sizeof(volc_tls_mbedtls_ctx_t);
+    if (ctx->setup_conf != NULL) {
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+        p_report->in_buffer_size = ctx->ssl_ctx.MBEDTLS_PRIVATE(in_buf_len);
+        p_report->out_buffer_size = ctx->ssl_ctx.MBEDTLS_PRIVATE(out_buf_len);
+#else
+        // fixed buffers, record header and expansion are not included
+        p_report->in_buffer_size = MBEDTLS_SSL_IN_CONTENT_LEN;
+        p_report->out_buffer_size = MBEDTLS_SSL_OUT_CONTENT_LEN;
+#endif
+        p_report->handshake_in_progress = !volc_tls_is_handshake_over(tls);
+    }
+    p_report->coalesce_buffer_size = ctx->coalesce_cap;
+    p_report->early_data_size = ctx->early_data_len;
+    p_report->total_size = p_report->context_size + p_report->in_buffer_size + p_report->out_buffer_size + p_report->coalesce_buffer_size +
+        p_report->early_data_size;
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_tls_recycle(volc_tls_t tls)
+{
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+
+    VOLC_CHK(ctx != NULL, VOLC_STATUS_NULL_ARG);
+    if (ctx->setup_conf != NULL) {
+        if (!ctx->ktls_enabled && volc_tls_is_handshake_over(tls)) {
+            // best effort, the transport is usually gone by now
+            mbedtls_ssl_close_notify(&ctx->ssl_ctx);
+        }
+        // drops session keys and peer certificate but keeps the buffers allocated by mbedtls_ssl_setup
+        VOLC_CHK(mbedtls_ssl_session_reset(&ctx->ssl_ctx) == 0, VOLC_STATUS_INTERNAL_ERROR);
+        mbedtls_ssl_set_bio(&ctx->ssl_ctx, NULL, NULL, NULL, NULL);
+    }
+    mbedtls_platform_zeroize(ctx->master_secret, sizeof(ctx->master_secret));
+    ctx->has_master_secret = false;
+    _volc_tls_free_early_data(ctx);
+    ctx->early_data_written = 0;
+    ctx->host[0] = '\0';
+    ctx->session_saved = false;
+    ctx->peer_verified = false;
+    ctx->timer_fin_ms = 0;
+    ctx->app_data_seen = false;
+    ctx->ktls_enabled = false;
+    ctx->coalesce_off = 0;
+    ctx->coalesce_len = 0;
+    ctx->ramp_bytes = 0;
+    ctx->inflight_len = 0;
+    ctx->async_ready_callback = NULL;
+    ctx->async_ready_custom_data = NULL;
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_tls_warm_up(volc_tls_t tls, bool is_server)
+{
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+    const mbedtls_ssl_config* conf = NULL;
+
+    VOLC_CHK(ctx != NULL, VOLC_STATUS_NULL_ARG);
+    if (NULL == ctx->setup_conf) {
+        // volc_tls_start on the same endpoint then only needs mbedtls_ssl_session_reset
+        conf = is_server ? &ctx->config->server_conf : &ctx->config->client_conf;
+        VOLC_CHK(mbedtls_ssl_setup(&ctx->ssl_ctx, conf) == 0, VOLC_STATUS_CREATE_SSL_FAILED);
+        ctx->setup_conf = conf;
+    }
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_tls_set_async_ready_callback(volc_tls_t tls, volc_tls_async_ready_callback callback, void* custom_data)
+{
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)tls;
+
+    VOLC_CHK(ctx != NULL, VOLC_STATUS_NULL_ARG);
+    ctx->async_ready_callback = callback;
+    ctx->async_ready_custom_data = custom_data;
+
+err_out_label:
+    return ret;
+}
+
+void volc_tls_async_ready(mbedtls_ssl_context* ssl)
+{
+    volc_tls_mbedtls_ctx_t* ctx = (volc_tls_mbedtls_ctx_t*)mbedtls_ssl_get_user_data_p(ssl);
+    if (ctx != NULL && ctx->async_ready_callback != NULL) {
+        ctx->async_ready_callback(ctx->async_ready_custom_data);
+    }
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_tls.h"
+#include "volc_tls_internal.h"
+
+#include <string.h>
+
+#include <mbedtls/pk.h>
+#include <mbedtls/platform_util.h>
+#include <mbedtls/ssl.h>
+
+#include "volc_memory.h"
+#include "volc_mutex.h"
+#include "volc_type.h"
+
+// large enough for an RSA-4096 signature or decrypted premaster secret
+#define VOLC_TLS_ASYNC_OUTPUT_SIZE 512
+#define VOLC_TLS_ASYNC_INPUT_SIZE  512
+// DER of an RSA-4096 private key is about 2.4 KB, larger keys are not offloaded
+#define VOLC_TLS_ASYNC_KEY_DER_SIZE 4096
+
+typedef enum {
+    VOLC_TLS_ASYNC_SIGN = 0,
+    VOLC_TLS_ASYNC_DECRYPT = 1,
+} volc_tls_async_op_type_e;
+
+// owned jointly by mbedtls (until resume or cancel) and the worker pool (until the done callback);
+// both run on the dispatching thread, whichever comes last frees it
+typedef struct {
+    volc_tls_async_op_type_e type;
+    volc_tls_config_impl_t* config;
+    mbedtls_ssl_context* ssl;
+    mbedtls_md_type_t md_alg;
+    uint8_t input[VOLC_TLS_ASYNC_INPUT_SIZE];
+    size_t input_len;
+    uint8_t output[VOLC_TLS_ASYNC_OUTPUT_SIZE];
+    size_t output_len;
+    int result;
+    bool finished;
+    bool abandoned;
+} volc_tls_async_op_t;
+
+#if defined(MBEDTLS_SSL_ASYNC_PRIVATE)
+static uint32_t _volc_tls_async_task(void* arg) {
+    volc_tls_async_op_t* op = (volc_tls_async_op_t*)arg;
+    volc_tls_config_impl_t* config = op->config;
+
+    // neither RSA blinding nor lazily built ECP tables are safe to share across threads
+    volc_mutex_lock(config->key_lock);
+    if (op->type == VOLC_TLS_ASYNC_SIGN) {
+        op->result = mbedtls_pk_sign(config->async_pkey, op->md_alg, op->input, op->input_len, op->output, sizeof(op->output), &op->output_len,
+                                     volc_tls_config_rng, config);
+    } else {
+        op->result = mbedtls_pk_decrypt(config->async_pkey, op->input, op->input_len, op->output, &op->output_len, sizeof(op->output),
+                                        volc_tls_config_rng, config);
+    }
+    volc_mutex_unlock(config->key_lock);
+    return op->result == 0 ? VOLC_STATUS_SUCCESS : VOLC_STATUS_INTERNAL_ERROR;
+}
+
+static void _volc_tls_async_done(void* arg, uint32_t status) {
+    volc_tls_async_op_t* op = (volc_tls_async_op_t*)arg;
+
+    if (VOLC_STATUS_FAILED(status) && op->result == 0) {
+        // cancelled before it ran, e.g. the pool is being destroyed
+        op->result = MBEDTLS_ERR_SSL_HW_ACCEL_FAILED;
+    }
+    if (op->abandoned) {
+        mbedtls_platform_zeroize(op->output, sizeof(op->output));
+        volc_free(op);
+        return;
+    }
+    op->finished = true;
+    volc_tls_async_ready(op->ssl);
+}
+
+static int _volc_tls_async_start(mbedtls_ssl_context* ssl, mbedtls_x509_crt* cert, volc_tls_async_op_type_e type, mbedtls_md_type_t md_alg,
+                                 const unsigned char* input, size_t input_len) {
+    volc_tls_config_impl_t* config = (volc_tls_config_impl_t*)mbedtls_ssl_conf_get_async_config_data(mbedtls_ssl_context_get_config(ssl));
+    volc_tls_async_op_t* op = NULL;
+
+    // anything we cannot handle is done synchronously by mbedtls
+    if (config == NULL || config->async_pool == NULL || cert != config->own_cert || config->async_pkey == NULL || input_len > VOLC_TLS_ASYNC_INPUT_SIZE) {
+        return MBEDTLS_ERR_SSL_HW_ACCEL_FALLTHROUGH;
+    }
+    op = (volc_tls_async_op_t*)volc_malloc(sizeof(volc_tls_async_op_t));
+    if (op == NULL) {
+        return MBEDTLS_ERR_SSL_ALLOC_FAILED;
+    }
+    memset(op, 0, sizeof(volc_tls_async_op_t));
+    op->type = type;
+    op->config = config;
+    op->ssl = ssl;
+    op->md_alg = md_alg;
+    memcpy(op->input, input, input_len);
+    op->input_len = input_len;
+    if (VOLC_STATUS_FAILED(volc_worker_pool_submit(config->async_pool, _volc_tls_async_task, _volc_tls_async_done, op))) {
+        volc_free(op);
+        return MBEDTLS_ERR_SSL_HW_ACCEL_FALLTHROUGH;
+    }
+    mbedtls_ssl_set_async_operation_data(ssl, op);
+    return MBEDTLS_ERR_SSL_ASYNC_IN_PROGRESS;
+}
+
+static int _volc_tls_async_sign_start(mbedtls_ssl_context* ssl, mbedtls_x509_crt* cert, mbedtls_md_type_t md_alg, const unsigned char* hash, size_t hash_len) {
+    return _volc_tls_async_start(ssl, cert, VOLC_TLS_ASYNC_SIGN, md_alg, hash, hash_len);
+}
+
+static int _volc_tls_async_decrypt_start(mbedtls_ssl_context* ssl, mbedtls_x509_crt* cert, const unsigned char* input, size_t input_len) {
+    return _volc_tls_async_start(ssl, cert, VOLC_TLS_ASYNC_DECRYPT, MBEDTLS_MD_NONE, input, input_len);
+}
+
+static int _volc_tls_async_resume(mbedtls_ssl_context* ssl, unsigned char* output, size_t* output_len, size_t output_size) {
+    volc_tls_async_op_t* op = (volc_tls_async_op_t*)mbedtls_ssl_get_async_operation_data(ssl);
+    int ret = 0;
+
+    if (!op->finished) {
+        return MBEDTLS_ERR_SSL_ASYNC_IN_PROGRESS;
+    }
+    ret = op->result;
+    if (ret == 0 && op->output_len > output_size) {
+        ret = MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL;
+    }
+    if (ret == 0) {
+        memcpy(output, op->output, op->output_len);
+        *output_len = op->output_len;
+    }
+    mbedtls_ssl_set_async_operation_data(ssl, NULL);
+    mbedtls_platform_zeroize(op->output, sizeof(op->output));
+    volc_free(op);
+    return ret;
+}
+
+static void _volc_tls_async_cancel(mbedtls_ssl_context* ssl) {
+    volc_tls_async_op_t* op = (volc_tls_async_op_t*)mbedtls_ssl_get_async_operation_data(ssl);
+
+    mbedtls_ssl_set_async_operation_data(ssl, NULL);
+    if (op == NULL) {
+        return;
+    }
+    if (op->finished) {
+        mbedtls_platform_zeroize(op->output, sizeof(op->output));
+        volc_free(op);
+    } else {
+        // the worker still owns it, the done callback frees it without touching the connection
+        op->abandoned = true;
+    }
+}
+#endif
+
+uint32_t volc_tls_async_update_key(volc_tls_config_impl_t* config) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    uint8_t* der = NULL;
+    int len = 0;
+
+    if (config->async_pkey != NULL) {
+        mbedtls_pk_free(config->async_pkey);
+        VOLC_SAFE_MEMFREE(config->async_pkey);
+    }
+    VOLC_CHK(config->async_pool != NULL && config->own_pkey != NULL, VOLC_STATUS_SUCCESS);
+    der = (uint8_t*)volc_malloc(VOLC_TLS_ASYNC_KEY_DER_SIZE);
+    VOLC_CHK(der != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    config->async_pkey = (mbedtls_pk_context*)volc_malloc(sizeof(mbedtls_pk_context));
+    VOLC_CHK(config->async_pkey != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    mbedtls_pk_init(config->async_pkey);
+    // keys that cannot be exported, e.g. opaque PSA keys, are not offloaded and keep signing on the calling thread
+    len = mbedtls_pk_write_key_der(config->own_pkey, der, VOLC_TLS_ASYNC_KEY_DER_SIZE);
+    if (len <= 0 || mbedtls_pk_parse_key(config->async_pkey, der + VOLC_TLS_ASYNC_KEY_DER_SIZE - len, (size_t)len, NULL, 0, volc_tls_config_rng,
+                                         config) != 0) {
+        mbedtls_pk_free(config->async_pkey);
+        VOLC_SAFE_MEMFREE(config->async_pkey);
+    }
+
+err_out_label:
+    if (der != NULL) {
+        mbedtls_platform_zeroize(der, VOLC_TLS_ASYNC_KEY_DER_SIZE);
+        volc_free(der);
+    }
+    return ret;
+}
+
+// mbedtls 3.6 only consults the async hooks in TLS 1.2; TLS 1.3 CertificateVerify calls mbedtls_pk_sign_ext directly and cannot be
+// redirected without a custom pk_info, which is internal to mbedtls
+uint32_t volc_tls_config_set_async_crypto(volc_tls_config_t config, volc_worker_pool_t pool) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_config_impl_t* p_config = (volc_tls_config_impl_t*)config;
+
+    VOLC_CHK(p_config != NULL, VOLC_STATUS_NULL_ARG);
+    // workers may still be signing with the key copy this replaces once connections hold the config
+    VOLC_CHK(p_config->ref_count == 1, VOLC_STATUS_INVALID_OPERATION);
+#if defined(MBEDTLS_SSL_ASYNC_PRIVATE) && defined(MBEDTLS_SSL_SRV_C)
+    if (pool != NULL && p_config->key_lock == NULL) {
+        p_config->key_lock = volc_mutex_create(false);
+        VOLC_CHK(p_config->key_lock != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    }
+    p_config->async_pool = pool;
+    VOLC_CHK_STATUS(volc_tls_async_update_key(p_config));
+    if (pool != NULL) {
+        mbedtls_ssl_conf_async_private_cb(&p_config->server_conf, _volc_tls_async_sign_start, _volc_tls_async_decrypt_start, _volc_tls_async_resume,
+                                          _volc_tls_async_cancel, p_config);
+        mbedtls_ssl_conf_async_private_cb(&p_config->dtls_server_conf, _volc_tls_async_sign_start, _volc_tls_async_decrypt_start,
+                                          _volc_tls_async_resume, _volc_tls_async_cancel, p_config);
+    } else {
+        mbedtls_ssl_conf_async_private_cb(&p_config->server_conf, NULL, NULL, NULL, NULL, NULL);
+        mbedtls_ssl_conf_async_private_cb(&p_config->dtls_server_conf, NULL, NULL, NULL, NULL, NULL);
+    }
+#else
+    VOLC_CHK(pool == NULL, VOLC_STATUS_NOT_IMPLEMENTED);
+#endif
+
+err_out_label:
+    return ret;
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_tls.h"
+#include "volc_tls_internal.h"
+
+#include <string.h>
+
+#if defined(MBEDTLS_PSA_CRYPTO_C)
+#include <psa/crypto.h>
+#endif
+
+#include "volc_atomic.h"
+#include "volc_memory.h"
+#include "volc_type.h"
+
+// indexed by mbedtls max fragment length code, MBEDTLS_SSL_MAX_FRAG_LEN_NONE .. MBEDTLS_SSL_MAX_FRAG_LEN_4096
+static volatile size_t g_default_tls_configs[5] = {0};
+
+#if defined(MBEDTLS_SSL_DTLS_SRTP)
+// order of preference, mirrors volc_srtp_profile_t
+static const mbedtls_ssl_srtp_profile g_dtls_srtp_profiles[] = {
+    MBEDTLS_TLS_SRTP_AES128_CM_HMAC_SHA1_80,
+    MBEDTLS_TLS_SRTP_AES128_CM_HMAC_SHA1_32,
+    MBEDTLS_TLS_SRTP_UNSET,
+};
+#endif
+
+int volc_tls_config_rng(void* p_rng, unsigned char* output, size_t len) {
+    volc_tls_config_impl_t* config = (volc_tls_config_impl_t*)p_rng;
+    int ret = 0;
+    volc_mutex_lock(config->rng_lock);
+    ret = mbedtls_ctr_drbg_random(&config->ctr_drbg, output, len);
+    volc_mutex_unlock(config->rng_lock);
+    return ret;
+}
+
+static uint32_t _volc_tls_config_setup(mbedtls_ssl_config* conf, volc_tls_config_impl_t* config, int endpoint, int transport) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    VOLC_CHK(mbedtls_ssl_config_defaults(conf, endpoint, transport, MBEDTLS_SSL_PRESET_DEFAULT) == 0, VOLC_STATUS_CREATE_SSL_FAILED);
+    mbedtls_ssl_conf_ca_chain(conf, &config->cacert, NULL);
+    mbedtls_ssl_conf_rng(conf, volc_tls_config_rng, config);
+    if (transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM) {
+        // DTLS peers authenticate each other by certificate fingerprint, so always ask for the peer certificate
+        mbedtls_ssl_conf_authmode(conf, MBEDTLS_SSL_VERIFY_OPTIONAL);
+#if defined(MBEDTLS_SSL_DTLS_SRTP)
+        VOLC_CHK(mbedtls_ssl_conf_dtls_srtp_protection_profiles(conf, g_dtls_srtp_profiles) == 0, VOLC_STATUS_CREATE_SSL_FAILED);
+#endif
+#if defined(MBEDTLS_SSL_DTLS_HELLO_VERIFY) && defined(MBEDTLS_SSL_SRV_C)
+        // the media path is already validated by ICE, a HelloVerifyRequest round trip buys nothing
+        if (endpoint == MBEDTLS_SSL_IS_SERVER) {
+            mbedtls_ssl_conf_dtls_cookies(conf, NULL, NULL, NULL);
+        }
+#endif
+        goto err_out_label;
+    }
+    mbedtls_ssl_conf_authmode(conf, MBEDTLS_SSL_VERIFY_NONE);
+    if (endpoint == MBEDTLS_SSL_IS_SERVER) {
+        volc_tls_session_tickets_conf(conf);
+    }
+#if defined(MBEDTLS_SSL_PROTO_TLS1_3) && defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_TLS1_3_SIGNAL_NEW_SESSION_TICKETS_ENABLED)
+    mbedtls_ssl_conf_tls13_enable_signal_new_session_tickets(conf, MBEDTLS_SSL_TLS1_3_SIGNAL_NEW_SESSION_TICKETS_ENABLED);
+#endif
+err_out_label:
+    return ret;
+}
+
+static void _volc_tls_config_free(volc_tls_config_impl_t* config) {
+    mbedtls_ssl_config_free(&config->client_conf);
+    mbedtls_ssl_config_free(&config->server_conf);
+    mbedtls_ssl_config_free(&config->dtls_client_conf);
+    mbedtls_ssl_config_free(&config->dtls_server_conf);
+    mbedtls_x509_crt_free(&config->cacert);
+    volc_tls_verify_cache_free(config->verify_cache);
+    mbedtls_ctr_drbg_free(&config->ctr_drbg);
+    mbedtls_entropy_free(&config->entropy);
+    if (config->rng_lock != NULL) {
+        volc_mutex_destroy(config->rng_lock);
+    }
+    if (config->async_pkey != NULL) {
+        mbedtls_pk_free(config->async_pkey);
+        volc_free(config->async_pkey);
+    }
+    if (config->key_lock != NULL) {
+        volc_mutex_destroy(config->key_lock);
+    }
+    volc_free(config);
+}
+
+uint32_t volc_tls_config_create(volc_tls_config_t* p_config) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_config_impl_t* config = NULL;
+
+    VOLC_CHK(p_config != NULL, VOLC_STATUS_NULL_ARG);
+    config = (volc_tls_config_impl_t*)volc_malloc(sizeof(volc_tls_config_impl_t));
+    VOLC_CHK(config != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    memset(config, 0, sizeof(volc_tls_config_impl_t));
+    config->ref_count = 1;
+    mbedtls_ssl_config_init(&config->client_conf);
+    mbedtls_ssl_config_init(&config->server_conf);
+    mbedtls_ssl_config_init(&config->dtls_client_conf);
+    mbedtls_ssl_config_init(&config->dtls_server_conf);
+    mbedtls_x509_crt_init(&config->cacert);
+    mbedtls_ctr_drbg_init(&config->ctr_drbg);
+    mbedtls_entropy_init(&config->entropy);
+    config->rng_lock = volc_mutex_create(false);
+    VOLC_CHK(config->rng_lock != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+#if defined(MBEDTLS_PSA_CRYPTO_C)
+    // TLS 1.3 key schedule runs on PSA, initialization is idempotent
+    VOLC_CHK(psa_crypto_init() == PSA_SUCCESS, VOLC_STATUS_CREATE_SSL_FAILED);
+#endif
+    // entropy is gathered once here instead of on every connection
+    VOLC_CHK(mbedtls_ctr_drbg_seed(&config->ctr_drbg, mbedtls_entropy_func, &config->entropy, NULL, 0) == 0, VOLC_STATUS_CREATE_SSL_FAILED);
+    VOLC_CHK_STATUS(_volc_tls_config_setup(&config->client_conf, config, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM));
+    VOLC_CHK_STATUS(_volc_tls_config_setup(&config->server_conf, config, MBEDTLS_SSL_IS_SERVER, MBEDTLS_SSL_TRANSPORT_STREAM));
+    VOLC_CHK_STATUS(_volc_tls_config_setup(&config->dtls_client_conf, config, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_DATAGRAM));
+    VOLC_CHK_STATUS(_volc_tls_config_setup(&config->dtls_server_conf, config, MBEDTLS_SSL_IS_SERVER, MBEDTLS_SSL_TRANSPORT_DATAGRAM));
+    *p_config = (volc_tls_config_t)config;
+
+err_out_label:
+    if (VOLC_STATUS_FAILED(ret) && config != NULL) {
+        _volc_tls_config_free(config);
+    }
+    return ret;
+}
+
+uint32_t volc_tls_config_destroy(volc_tls_config_t config) {
+    if (config != NULL) {
+        volc_tls_config_release((volc_tls_config_impl_t*)config);
+    }
+    return VOLC_STATUS_SUCCESS;
+}
+
+void volc_tls_config_retain(volc_tls_config_impl_t* config) {
+    volc_atomic_increment(&config->ref_count);
+}
+
+void volc_tls_config_release(volc_tls_config_impl_t* config) {
+    // volc_atomic_decrement returns the value before the decrement
+    if (volc_atomic_decrement(&config->ref_count) == 1) {
+        _volc_tls_config_free(config);
+    }
+}
+
+static bool _volc_tls_max_frag_len_code(uint32_t max_fragment_length, unsigned char* p_code) {
+    switch (max_fragment_length) {
+        case 0:
+            *p_code = 0;
+            return true;
+        case 512:
+            *p_code = 1;
+            return true;
+        case 1024:
+            *p_code = 2;
+            return true;
+        case 2048:
+            *p_code = 3;
+            return true;
+        case 4096:
+            *p_code = 4;
+            return true;
+        default:
+            return false;
+    }
+}
+
+volc_tls_config_impl_t* volc_tls_config_get_default(uint32_t max_fragment_length) {
+    unsigned char code = 0;
+    size_t config = 0;
+    size_t expected = 0;
+    volc_tls_config_t created = NULL;
+
+    if (!_volc_tls_max_frag_len_code(max_fragment_length, &code)) {
+        return NULL;
+    }
+    config = volc_atomic_load(&g_default_tls_configs[code]);
+    if (config == 0) {
+        if (VOLC_STATUS_FAILED(volc_tls_config_create(&created))) {
+            return NULL;
+        }
+        if (VOLC_STATUS_FAILED(volc_tls_config_set_max_fragment_length(created, max_fragment_length))) {
+            volc_tls_config_destroy(created);
+            return NULL;
+        }
+        // the default config lives until process exit
+        if (!volc_atomic_compare_exchange(&g_default_tls_configs[code], &expected, (size_t)created)) {
+            volc_tls_config_destroy(created);
+        }
+        config = volc_atomic_load(&g_default_tls_configs[code]);
+    }
+    return (volc_tls_config_impl_t*)config;
+}
+
+uint32_t volc_tls_config_add_ca_cert(volc_tls_config_t config, const uint8_t* data, size_t len) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_config_impl_t* p_config = (volc_tls_config_impl_t*)config;
+
+    VOLC_CHK(p_config != NULL && data != NULL, VOLC_STATUS_NULL_ARG);
+    // PEM input must include the terminating NUL in len, DER is detected automatically
+    VOLC_CHK(mbedtls_x509_crt_parse(&p_config->cacert, data, len) == 0, VOLC_STATUS_INVALID_ARG);
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_tls_config_set_own_cert(volc_tls_config_t config, volc_cert_t cert, volc_pkey_t pkey) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_config_impl_t* p_config = (volc_tls_config_impl_t*)config;
+
+    VOLC_CHK(p_config != NULL && cert != NULL && pkey != NULL, VOLC_STATUS_NULL_ARG);
+    // the workers' key copy is replaced below, async crypto workers may still be using the old one once the config is shared
+    VOLC_CHK(p_config->ref_count == 1, VOLC_STATUS_INVALID_OPERATION);
+    VOLC_CHK(mbedtls_ssl_conf_own_cert(&p_config->client_conf, (mbedtls_x509_crt*)cert, (mbedtls_pk_context*)pkey) == 0, VOLC_STATUS_INVALID_ARG);
+    VOLC_CHK(mbedtls_ssl_conf_own_cert(&p_config->server_conf, (mbedtls_x509_crt*)cert, (mbedtls_pk_context*)pkey) == 0, VOLC_STATUS_INVALID_ARG);
+    VOLC_CHK(mbedtls_ssl_conf_own_cert(&p_config->dtls_client_conf, (mbedtls_x509_crt*)cert, (mbedtls_pk_context*)pkey) == 0, VOLC_STATUS_INVALID_ARG);
+    VOLC_CHK(mbedtls_ssl_conf_own_cert(&p_config->dtls_server_conf, (mbedtls_x509_crt*)cert, (mbedtls_pk_context*)pkey) == 0, VOLC_STATUS_INVALID_ARG);
+    p_config->own_cert = (mbedtls_x509_crt*)cert;
+    p_config->own_pkey = (mbedtls_pk_context*)pkey;
+    VOLC_CHK_STATUS(volc_tls_async_update_key(p_config));
+err_out_label:
+    return ret;
+}
+
+static mbedtls_ssl_protocol_version _volc_tls_protocol_version(volc_tls_version_e version) {
+    return version == VOLC_TLS_VERSION_1_3 ? MBEDTLS_SSL_VERSION_TLS1_3 : MBEDTLS_SSL_VERSION_TLS1_2;
+}
+
+uint32_t volc_tls_config_set_version_range(volc_tls_config_t config, volc_tls_version_e min_version, volc_tls_version_e max_version) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_config_impl_t* p_config = (volc_tls_config_impl_t*)config;
+
+    VOLC_CHK(p_config != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK(min_version <= max_version, VOLC_STATUS_INVALID_ARG);
+#if !defined(MBEDTLS_SSL_PROTO_TLS1_3)
+    VOLC_CHK(max_version < VOLC_TLS_VERSION_1_3, VOLC_STATUS_NOT_IMPLEMENTED);
+#endif
+    // DTLS 1.3 is not available, the datagram configs keep DTLS 1.2
+    mbedtls_ssl_conf_min_tls_version(&p_config->client_conf, _volc_tls_protocol_version(min_version));
+    mbedtls_ssl_conf_max_tls_version(&p_config->client_conf, _volc_tls_protocol_version(max_version));
+    mbedtls_ssl_conf_min_tls_version(&p_config->server_conf, _volc_tls_protocol_version(min_version));
+    mbedtls_ssl_conf_max_tls_version(&p_config->server_conf, _volc_tls_protocol_version(max_version));
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_tls_config_enable_early_data(volc_tls_config_t config, bool enable) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_config_impl_t* p_config = (volc_tls_config_impl_t*)config;
+
+    VOLC_CHK(p_config != NULL, VOLC_STATUS_NULL_ARG);
+#if defined(MBEDTLS_SSL_EARLY_DATA) && defined(MBEDTLS_SSL_CLI_C)
+    mbedtls_ssl_conf_early_data(&p_config->client_conf, enable ? MBEDTLS_SSL_EARLY_DATA_ENABLED : MBEDTLS_SSL_EARLY_DATA_DISABLED);
+#else
+    VOLC_CHK(!enable, VOLC_STATUS_NOT_IMPLEMENTED);
+#endif
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_tls_config_set_max_fragment_length(volc_tls_config_t config, uint32_t max_fragment_length) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_config_impl_t* p_config = (volc_tls_config_impl_t*)config;
+    unsigned char code = 0;
+
+    VOLC_CHK(p_config != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK(_volc_tls_max_frag_len_code(max_fragment_length, &code), VOLC_STATUS_INVALID_ARG);
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    // only clients ask for it, servers always honour the extension
+    VOLC_CHK(mbedtls_ssl_conf_max_frag_len(&p_config->client_conf, code) == 0, VOLC_STATUS_INVALID_ARG);
+    VOLC_CHK(mbedtls_ssl_conf_max_frag_len(&p_config->dtls_client_conf, code) == 0, VOLC_STATUS_INVALID_ARG);
+    p_config->max_fragment_length = max_fragment_length;
+#else
+    VOLC_CHK(code == 0, VOLC_STATUS_NOT_IMPLEMENTED);
+#endif
+
+err_out_label:
+    return ret;
+}
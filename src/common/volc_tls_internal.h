@@ -0,0 +1,87 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef __HAL_VOLC_TLS_INTERNAL_H__
+#define __HAL_VOLC_TLS_INTERNAL_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/pk.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/x509_crt.h>
+
+#include "volc_mutex.h"
+#include "volc_worker_pool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// verified chain fingerprints, see volc_tls_verify.c
+typedef struct volc_tls_verify_cache volc_tls_verify_cache_t;
+
+typedef struct {
+    mbedtls_ssl_config client_conf;
+    mbedtls_ssl_config server_conf;
+    mbedtls_ssl_config dtls_client_conf;
+    mbedtls_ssl_config dtls_server_conf;
+    mbedtls_entropy_context entropy;
+    mbedtls_ctr_drbg_context ctr_drbg;
+    volc_mutex_t rng_lock;
+    mbedtls_x509_crt cacert;
+    uint32_t max_fragment_length;
+    // clients verify the server chain after the handshake when set, mbedtls itself runs with VERIFY_NONE
+    bool verify_peer;
+    volc_tls_verify_cache_t* verify_cache;
+    // own certificate and key, the async private key hooks look the key up by certificate
+    mbedtls_x509_crt* own_cert;
+    mbedtls_pk_context* own_pkey;
+    // server private key operations are offloaded to this pool when set; the workers sign with their own copy of own_pkey so they
+    // never share RSA blinding or ECP state with handshakes signing on the calling thread, key_lock serializes the workers
+    volc_worker_pool_t async_pool;
+    mbedtls_pk_context* async_pkey;
+    volc_mutex_t key_lock;
+    volatile size_t ref_count;
+} volc_tls_config_impl_t;
+
+// thread-safe f_rng over the config's DRBG, usable wherever mbedtls wants a rng callback
+int volc_tls_config_rng(void* p_rng, unsigned char* output, size_t len);
+// process-wide default config, one per max fragment length (0 or 512/1024/2048/4096), created on first use
+volc_tls_config_impl_t* volc_tls_config_get_default(uint32_t max_fragment_length);
+void volc_tls_config_retain(volc_tls_config_impl_t* config);
+void volc_tls_config_release(volc_tls_config_impl_t* config);
+
+// checks the peer chain against the config's CA store and the expected host name, consulting the verified chain cache first;
+// returns 0 or MBEDTLS_ERR_X509_CERT_VERIFY_FAILED
+int volc_tls_verify_peer(volc_tls_config_impl_t* config, const mbedtls_x509_crt* chain, const char* host);
+void volc_tls_verify_cache_free(volc_tls_verify_cache_t* cache);
+
+// called on the dispatching thread once an offloaded private key operation of the connection has finished
+void volc_tls_async_ready(mbedtls_ssl_context* ssl);
+// rebuilds the workers' copy of own_pkey, call whenever own_pkey or async_pool changes
+uint32_t volc_tls_async_update_key(volc_tls_config_impl_t* config);
+
+// returns a finished connection to its post volc_tls_create_ex state while keeping the mbedtls record buffers,
+// handle settings (write coalescing, record sizing) survive
+uint32_t volc_tls_recycle(volc_tls_t tls);
+
+// runs mbedtls_ssl_setup ahead of volc_tls_start so the record buffers are allocated before the first connection
+uint32_t volc_tls_warm_up(volc_tls_t tls, bool is_server);
+
+// process-wide client session cache keyed by host name
+void volc_tls_session_cache_load(mbedtls_ssl_context* ssl, const char* host);
+void volc_tls_session_cache_save(mbedtls_ssl_context* ssl, const char* host);
+void volc_tls_session_cache_remove(const char* host);
+
+// attaches the shared ticket keys to a server config when tickets were enabled
+void volc_tls_session_tickets_conf(mbedtls_ssl_config* conf);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __HAL_VOLC_TLS_INTERNAL_H__ */
@@ -0,0 +1,157 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_tls_pool.h"
+#include "volc_tls_internal.h"
+
+#include <string.h>
+
+#include "volc_memory.h"
+#include "volc_mutex.h"
+#include "volc_type.h"
+
+#define VOLC_TLS_POOL_DEFAULT_WARM_SIZE 4
+#define VOLC_TLS_POOL_DEFAULT_MAX_IDLE  32
+
+typedef struct {
+    volc_mutex_t lock;
+    volc_tls_options_t options;
+    // retained for the lifetime of the pool so options.config stays valid for new contexts
+    volc_tls_config_impl_t* config;
+    volc_tls_t* idle;
+    uint32_t idle_count;
+    uint32_t max_idle;
+    bool is_server;
+} volc_tls_pool_impl_t;
+
+void volc_tls_pool_get_default_config(volc_tls_pool_config_t* config) {
+    if (NULL == config) {
+        return;
+    }
+    memset(config, 0, sizeof(volc_tls_pool_config_t));
+    volc_tls_get_default_options(&config->options);
+    config->warm_size = VOLC_TLS_POOL_DEFAULT_WARM_SIZE;
+    config->max_idle = VOLC_TLS_POOL_DEFAULT_MAX_IDLE;
+}
+
+uint32_t volc_tls_pool_create(const volc_tls_pool_config_t* config, volc_tls_pool_t* p_pool) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_pool_impl_t* pool = NULL;
+    volc_tls_pool_config_t default_config;
+    uint32_t i = 0;
+
+    VOLC_CHK(p_pool != NULL, VOLC_STATUS_NULL_ARG);
+    if (NULL == config) {
+        volc_tls_pool_get_default_config(&default_config);
+        config = &default_config;
+    }
+    VOLC_CHK(config->warm_size <= config->max_idle, VOLC_STATUS_INVALID_ARG);
+    pool = (volc_tls_pool_impl_t*)volc_malloc(sizeof(volc_tls_pool_impl_t));
+    VOLC_CHK(pool != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    memset(pool, 0, sizeof(volc_tls_pool_impl_t));
+    pool->options = config->options;
+    pool->max_idle = config->max_idle;
+    pool->is_server = config->is_server;
+    if (pool->options.config != NULL) {
+        pool->config = (volc_tls_config_impl_t*)pool->options.config;
+        volc_tls_config_retain(pool->config);
+    }
+    pool->lock = volc_mutex_create(false);
+    VOLC_CHK(pool->lock != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    if (pool->max_idle > 0) {
+        pool->idle = (volc_tls_t*)volc_malloc(sizeof(volc_tls_t) * pool->max_idle);
+        VOLC_CHK(pool->idle != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    }
+    for (i = 0; i < config->warm_size; i++) {
+        VOLC_CHK_STATUS(volc_tls_create_ex(&pool->options, &pool->idle[pool->idle_count]));
+        pool->idle_count++;
+        VOLC_CHK_STATUS(volc_tls_warm_up(pool->idle[pool->idle_count - 1], pool->is_server));
+    }
+    *p_pool = (volc_tls_pool_t)pool;
+
+err_out_label:
+    if (VOLC_STATUS_FAILED(ret) && pool != NULL) {
+        volc_tls_pool_destroy((volc_tls_pool_t)pool);
+    }
+    return ret;
+}
+
+uint32_t volc_tls_pool_destroy(volc_tls_pool_t pool) {
+    volc_tls_pool_impl_t* p_pool = (volc_tls_pool_impl_t*)pool;
+    uint32_t i = 0;
+
+    if (NULL == p_pool) {
+        return VOLC_STATUS_SUCCESS;
+    }
+    for (i = 0; i < p_pool->idle_count; i++) {
+        volc_tls_destroy(p_pool->idle[i]);
+    }
+    VOLC_SAFE_MEMFREE(p_pool->idle);
+    if (p_pool->lock != NULL) {
+        volc_mutex_destroy(p_pool->lock);
+    }
+    if (p_pool->config != NULL) {
+        volc_tls_config_release(p_pool->config);
+    }
+    volc_free(p_pool);
+    return VOLC_STATUS_SUCCESS;
+}
+
+uint32_t volc_tls_pool_acquire(volc_tls_pool_t pool, volc_tls_t* p_tls) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_pool_impl_t* p_pool = (volc_tls_pool_impl_t*)pool;
+    volc_tls_t tls = NULL;
+
+    VOLC_CHK(p_pool != NULL && p_tls != NULL, VOLC_STATUS_NULL_ARG);
+    volc_mutex_lock(p_pool->lock);
+    if (p_pool->idle_count > 0) {
+        tls = p_pool->idle[--p_pool->idle_count];
+    }
+    volc_mutex_unlock(p_pool->lock);
+    if (NULL == tls) {
+        VOLC_CHK_STATUS(volc_tls_create_ex(&p_pool->options, &tls));
+    }
+    *p_tls = tls;
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_tls_pool_release(volc_tls_pool_t pool, volc_tls_t tls) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_pool_impl_t* p_pool = (volc_tls_pool_impl_t*)pool;
+    bool owned = false;
+    bool pooled = false;
+
+    VOLC_CHK(p_pool != NULL && tls != NULL, VOLC_STATUS_NULL_ARG);
+    owned = true;
+    // reset outside the lock, close_notify may call into the transport
+    VOLC_CHK_STATUS(volc_tls_recycle(tls));
+    volc_mutex_lock(p_pool->lock);
+    if (p_pool->idle_count < p_pool->max_idle) {
+        p_pool->idle[p_pool->idle_count++] = tls;
+        pooled = true;
+    }
+    volc_mutex_unlock(p_pool->lock);
+
+err_out_label:
+    if (owned && !pooled) {
+        volc_tls_destroy(tls);
+    }
+    return ret;
+}
+
+uint32_t volc_tls_pool_get_idle_count(volc_tls_pool_t pool) {
+    volc_tls_pool_impl_t* p_pool = (volc_tls_pool_impl_t*)pool;
+    uint32_t count = 0;
+
+    if (NULL == p_pool) {
+        return 0;
+    }
+    volc_mutex_lock(p_pool->lock);
+    count = p_pool->idle_count;
+    volc_mutex_unlock(p_pool->lock);
+    return count;
+}
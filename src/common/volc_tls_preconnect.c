@@ -0,0 +1,322 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_tls_preconnect.h"
+#include "volc_tls_internal.h"
+
+#include <string.h>
+
+#include "volc_atomic.h"
+#include "volc_happy_eyeballs.h"
+#include "volc_memory.h"
+#include "volc_socket.h"
+#include "volc_time.h"
+#include "volc_type.h"
+
+#define VOLC_TLS_PRECONNECT_DEFAULT_MAX_IDLE          4
+#define VOLC_TLS_PRECONNECT_DEFAULT_IDLE_TIMEOUT_MS   30000
+#define VOLC_TLS_PRECONNECT_DEFAULT_HANDSHAKE_TIMEOUT 10000
+
+struct volc_tls_preconnect_pool_impl;
+
+typedef struct volc_tls_preconnect_entry {
+    struct volc_tls_preconnect_entry* next;
+    // NULL once the pool was destroyed while the connection was still being set up
+    struct volc_tls_preconnect_pool_impl* owner;
+    char host[VOLC_TLS_MAX_HOST_NAME_LENGTH + 1];
+    uint16_t port;
+    // copied so the worker never touches the pool, the entry holds its own config reference
+    volc_tls_options_t options;
+    uint32_t handshake_timeout_ms;
+    // set from the loop thread, polled by the worker between handshake steps
+    volatile size_t canceled;
+    bool ready;
+    uint64_t ready_ms;
+    volc_tls_t tls;
+    int sockfd;
+} volc_tls_preconnect_entry_t;
+
+typedef struct volc_tls_preconnect_pool_impl {
+    volc_worker_pool_t pool;
+    volc_tls_preconnect_config_t config;
+    // retained for the lifetime of the pool so options.config stays valid for new connections
+    volc_tls_config_impl_t* tls_config;
+    volc_tls_preconnect_entry_t* entries;
+} volc_tls_preconnect_pool_impl_t;
+
+void volc_tls_preconnect_get_default_config(volc_tls_preconnect_config_t* config) {
+    if (config == NULL) {
+        return;
+    }
+    memset(config, 0, sizeof(volc_tls_preconnect_config_t));
+    volc_tls_get_default_options(&config->options);
+    config->max_idle = VOLC_TLS_PRECONNECT_DEFAULT_MAX_IDLE;
+    config->idle_timeout_ms = VOLC_TLS_PRECONNECT_DEFAULT_IDLE_TIMEOUT_MS;
+    config->handshake_timeout_ms = VOLC_TLS_PRECONNECT_DEFAULT_HANDSHAKE_TIMEOUT;
+}
+
+static void _volc_tls_preconnect_entry_free(volc_tls_preconnect_entry_t* entry) {
+    // close_notify goes out before the socket is closed
+    volc_tls_destroy(entry->tls);
+    if (entry->sockfd >= 0) {
+        volc_close(entry->sockfd);
+    }
+    if (entry->options.config != NULL) {
+        volc_tls_config_release((volc_tls_config_impl_t*)entry->options.config);
+    }
+    volc_free(entry);
+}
+
+static void _volc_tls_preconnect_unlink(volc_tls_preconnect_pool_impl_t* p_impl, volc_tls_preconnect_entry_t* entry) {
+    volc_tls_preconnect_entry_t** pp = NULL;
+    for (pp = &p_impl->entries; *pp != NULL; pp = &(*pp)->next) {
+        if (*pp == entry) {
+            *pp = entry->next;
+            break;
+        }
+    }
+}
+
+static void _volc_tls_preconnect_purge(volc_tls_preconnect_pool_impl_t* p_impl) {
+    volc_tls_preconnect_entry_t** pp = &p_impl->entries;
+    volc_tls_preconnect_entry_t* entry = NULL;
+    uint64_t now = volc_get_montionic_time_ms();
+
+    while (*pp != NULL) {
+        entry = *pp;
+        if (entry->ready && now - entry->ready_ms >= p_impl->config.idle_timeout_ms) {
+            // servers drop idle connections on their own, handing out a stale one would cost more than connecting anew
+            *pp = entry->next;
+            _volc_tls_preconnect_entry_free(entry);
+        } else {
+            pp = &entry->next;
+        }
+    }
+}
+
+// keeps at most max_idle ready connections by closing the oldest one, connections still being set up do not count;
+// entries become ready one at a time, so a single eviction restores the limit
+static void _volc_tls_preconnect_trim(volc_tls_preconnect_pool_impl_t* p_impl) {
+    volc_tls_preconnect_entry_t* entry = NULL;
+    volc_tls_preconnect_entry_t* oldest = NULL;
+    uint32_t ready = 0;
+
+    for (entry = p_impl->entries; entry != NULL; entry = entry->next) {
+        if (entry->ready) {
+            ready++;
+            if (oldest == NULL || entry->ready_ms < oldest->ready_ms) {
+                oldest = entry;
+            }
+        }
+    }
+    if (ready > p_impl->config.max_idle) {
+        _volc_tls_preconnect_unlink(p_impl, oldest);
+        _volc_tls_preconnect_entry_free(oldest);
+    }
+}
+
+static volc_tls_preconnect_entry_t* _volc_tls_preconnect_find(volc_tls_preconnect_pool_impl_t* p_impl, const char* host, uint16_t port) {
+    volc_tls_preconnect_entry_t* entry = NULL;
+    for (entry = p_impl->entries; entry != NULL; entry = entry->next) {
+        if (entry->port == port && strcmp(entry->host, host) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// runs on a worker thread: connect and drive the handshake to completion on a private non-blocking socket
+static uint32_t _volc_tls_preconnect_task(void* arg) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_preconnect_entry_t* entry = (volc_tls_preconnect_entry_t*)arg;
+    volc_happy_eyeballs_config_t he_config;
+    struct volc_pollfd pfd;
+    uint64_t deadline = volc_get_montionic_time_ms() + entry->handshake_timeout_ms;
+    uint64_t now = 0;
+    short events = 0;
+    int r = 0;
+
+    VOLC_CHK(volc_atomic_load(&entry->canceled) == 0, VOLC_STATUS_USER_CANCELED);
+    volc_happy_eyeballs_get_default_config(&he_config);
+    he_config.timeout_ms = entry->handshake_timeout_ms;
+    VOLC_CHK_STATUS(volc_happy_eyeballs_connect(entry->host, entry->port, &he_config, &entry->sockfd, NULL));
+    VOLC_CHK_STATUS(volc_tls_create_ex(&entry->options, &entry->tls));
+
+    r = volc_tls_start(entry->tls, false, entry->host, volc_tls_socket_send, volc_tls_socket_recv, (void*)(intptr_t)entry->sockfd);
+    VOLC_CHK(r == 0 || r == VOLC_MBEDTLS_ERR_SSL_WANT_READ || r == VOLC_MBEDTLS_ERR_SSL_WANT_WRITE, VOLC_STATUS_SSL_CONNECTION_FAILED);
+    while (r != 0) {
+        ret = volc_tls_handshake_step(entry->tls, &events);
+        if (ret == VOLC_STATUS_SUCCESS) {
+            break;
+        }
+        VOLC_CHK(ret == VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY, ret);
+        VOLC_CHK(volc_atomic_load(&entry->canceled) == 0, VOLC_STATUS_USER_CANCELED);
+        now = volc_get_montionic_time_ms();
+        VOLC_CHK(now < deadline, VOLC_STATUS_OPERATION_TIMED_OUT);
+        pfd.fd = entry->sockfd;
+        pfd.events = events;
+        pfd.revents = 0;
+        // bounded wait so a destroyed pool does not keep a worker busy until the handshake deadline
+        volc_poll(&pfd, 1, (int)VOLC_MIN(deadline - now, 100));
+    }
+
+err_out_label:
+    return ret;
+}
+
+static void _volc_tls_preconnect_done(void* arg, uint32_t status) {
+    volc_tls_preconnect_entry_t* entry = (volc_tls_preconnect_entry_t*)arg;
+    volc_tls_preconnect_pool_impl_t* p_impl = entry->owner;
+
+    if (p_impl == NULL || VOLC_STATUS_FAILED(status)) {
+        if (p_impl != NULL) {
+            _volc_tls_preconnect_unlink(p_impl, entry);
+        }
+        _volc_tls_preconnect_entry_free(entry);
+        return;
+    }
+    entry->ready = true;
+    entry->ready_ms = volc_get_montionic_time_ms();
+    _volc_tls_preconnect_trim(p_impl);
+}
+
+uint32_t volc_tls_preconnect_pool_create(volc_worker_pool_t pool, const volc_tls_preconnect_config_t* config, volc_tls_preconnect_pool_t* p_preconnect) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_preconnect_pool_impl_t* p_impl = NULL;
+
+    VOLC_CHK(pool != NULL && p_preconnect != NULL, VOLC_STATUS_NULL_ARG);
+    p_impl = (volc_tls_preconnect_pool_impl_t*)volc_malloc(sizeof(volc_tls_preconnect_pool_impl_t));
+    VOLC_CHK(p_impl != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    memset(p_impl, 0, sizeof(volc_tls_preconnect_pool_impl_t));
+    p_impl->pool = pool;
+    if (config != NULL) {
+        p_impl->config = *config;
+    } else {
+        volc_tls_preconnect_get_default_config(&p_impl->config);
+    }
+    p_impl->config.max_idle = VOLC_MAX(1, p_impl->config.max_idle);
+    if (p_impl->config.idle_timeout_ms == 0) {
+        p_impl->config.idle_timeout_ms = VOLC_TLS_PRECONNECT_DEFAULT_IDLE_TIMEOUT_MS;
+    }
+    if (p_impl->config.handshake_timeout_ms == 0) {
+        p_impl->config.handshake_timeout_ms = VOLC_TLS_PRECONNECT_DEFAULT_HANDSHAKE_TIMEOUT;
+    }
+    if (p_impl->config.options.config != NULL) {
+        p_impl->tls_config = (volc_tls_config_impl_t*)p_impl->config.options.config;
+        volc_tls_config_retain(p_impl->tls_config);
+    }
+    *p_preconnect = (volc_tls_preconnect_pool_t)p_impl;
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_tls_preconnect_pool_destroy(volc_tls_preconnect_pool_t preconnect) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_preconnect_pool_impl_t* p_impl = (volc_tls_preconnect_pool_impl_t*)preconnect;
+    volc_tls_preconnect_entry_t* entry = NULL;
+
+    VOLC_CHK(p_impl != NULL, VOLC_STATUS_NULL_ARG);
+    while (p_impl->entries != NULL) {
+        entry = p_impl->entries;
+        p_impl->entries = entry->next;
+        if (entry->ready) {
+            _volc_tls_preconnect_entry_free(entry);
+        } else {
+            // in-flight connections are owned by the worker pool until their done callback runs
+            entry->owner = NULL;
+            volc_atomic_store(&entry->canceled, 1);
+        }
+    }
+    if (p_impl->tls_config != NULL) {
+        volc_tls_config_release(p_impl->tls_config);
+    }
+    volc_free(p_impl);
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_tls_preconnect(volc_tls_preconnect_pool_t preconnect, const char* host, uint16_t port) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_preconnect_pool_impl_t* p_impl = (volc_tls_preconnect_pool_impl_t*)preconnect;
+    volc_tls_preconnect_entry_t* entry = NULL;
+
+    VOLC_CHK(p_impl != NULL && host != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK(host[0] != '\0' && strlen(host) <= VOLC_TLS_MAX_HOST_NAME_LENGTH, VOLC_STATUS_INVALID_ARG_LEN);
+    _volc_tls_preconnect_purge(p_impl);
+    VOLC_CHK(_volc_tls_preconnect_find(p_impl, host, port) == NULL, VOLC_STATUS_SUCCESS);
+
+    // room is made once the new connection is ready, so a failed connect does not cost a ready one
+    entry = (volc_tls_preconnect_entry_t*)volc_malloc(sizeof(volc_tls_preconnect_entry_t));
+    VOLC_CHK(entry != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    memset(entry, 0, sizeof(volc_tls_preconnect_entry_t));
+    entry->owner = p_impl;
+    strncpy(entry->host, host, VOLC_TLS_MAX_HOST_NAME_LENGTH);
+    entry->port = port;
+    entry->options = p_impl->config.options;
+    entry->handshake_timeout_ms = p_impl->config.handshake_timeout_ms;
+    entry->sockfd = -1;
+    if (entry->options.config != NULL) {
+        volc_tls_config_retain((volc_tls_config_impl_t*)entry->options.config);
+    }
+    ret = volc_worker_pool_submit(p_impl->pool, _volc_tls_preconnect_task, _volc_tls_preconnect_done, entry);
+    if (VOLC_STATUS_FAILED(ret)) {
+        _volc_tls_preconnect_entry_free(entry);
+        goto err_out_label;
+    }
+    entry->next = p_impl->entries;
+    p_impl->entries = entry;
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_tls_preconnect_take(volc_tls_preconnect_pool_t preconnect, const char* host, uint16_t port, volc_tls_t* p_tls, int* p_sockfd) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_preconnect_pool_impl_t* p_impl = (volc_tls_preconnect_pool_impl_t*)preconnect;
+    volc_tls_preconnect_entry_t* entry = NULL;
+    struct volc_pollfd pfd;
+
+    VOLC_CHK(p_impl != NULL && host != NULL && p_tls != NULL && p_sockfd != NULL, VOLC_STATUS_NULL_ARG);
+    _volc_tls_preconnect_purge(p_impl);
+    entry = _volc_tls_preconnect_find(p_impl, host, port);
+    VOLC_CHK(entry != NULL && entry->ready, VOLC_STATUS_NOT_FOUND);
+
+    _volc_tls_preconnect_unlink(p_impl, entry);
+    pfd.fd = entry->sockfd;
+    pfd.events = VOLC_EVLOOP_POLLIN;
+    pfd.revents = 0;
+    // readable alone is fine (TLS 1.3 session tickets), a reset or closed peer is not
+    if (volc_poll(&pfd, 1, 0) < 0 || (pfd.revents & (VOLC_EVLOOP_POLLERR | VOLC_EVLOOP_POLLHUP)) != 0) {
+        _volc_tls_preconnect_entry_free(entry);
+        VOLC_CHK(0, VOLC_STATUS_NOT_FOUND);
+    }
+    *p_tls = entry->tls;
+    *p_sockfd = entry->sockfd;
+    entry->tls = NULL;
+    entry->sockfd = -1;
+    _volc_tls_preconnect_entry_free(entry);
+
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_tls_preconnect_get_ready_count(volc_tls_preconnect_pool_t preconnect) {
+    volc_tls_preconnect_pool_impl_t* p_impl = (volc_tls_preconnect_pool_impl_t*)preconnect;
+    volc_tls_preconnect_entry_t* entry = NULL;
+    uint32_t count = 0;
+
+    if (p_impl == NULL) {
+        return 0;
+    }
+    _volc_tls_preconnect_purge(p_impl);
+    for (entry = p_impl->entries; entry != NULL; entry = entry->next) {
+        if (entry->ready) {
+            count++;
+        }
+    }
+    return count;
+}
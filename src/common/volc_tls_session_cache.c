@@ -0,0 +1,210 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_tls.h"
+#include "volc_tls_internal.h"
+
+#include <string.h>
+
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/ssl_ticket.h>
+
+#include "volc_atomic.h"
+#include "volc_memory.h"
+#include "volc_mutex.h"
+#include "volc_time.h"
+#include "volc_type.h"
+
+#define VOLC_TLS_SESSION_CACHE_SIZE             16
+#define VOLC_TLS_SESSION_CACHE_HOST_LENGTH      255
+#define VOLC_TLS_SESSION_CACHE_DEFAULT_LIFETIME 7200
+
+typedef struct {
+    char host[VOLC_TLS_SESSION_CACHE_HOST_LENGTH + 1];
+    mbedtls_ssl_session session;
+    uint64_t expire_ms;
+    uint64_t last_used_ms;
+    bool used;
+} volc_tls_session_entry_t;
+
+typedef struct {
+    volc_tls_session_entry_t entries[VOLC_TLS_SESSION_CACHE_SIZE];
+    uint32_t lifetime_s;
+#if defined(MBEDTLS_SSL_TICKET_C)
+    bool tickets_enabled;
+    mbedtls_ssl_ticket_context ticket;
+    mbedtls_entropy_context entropy;
+    mbedtls_ctr_drbg_context ctr_drbg;
+#endif
+} volc_tls_session_cache_t;
+
+static volatile size_t g_session_cache_lock = 0;
+static volc_tls_session_cache_t g_session_cache = {.lifetime_s = VOLC_TLS_SESSION_CACHE_DEFAULT_LIFETIME};
+
+static volc_mutex_t _volc_tls_session_cache_lock(void) {
+    size_t lock = volc_atomic_load(&g_session_cache_lock);
+    size_t expected = 0;
+    volc_mutex_t mutex = NULL;
+
+    if (lock == 0) {
+        mutex = volc_mutex_create(false);
+        if (!volc_atomic_compare_exchange(&g_session_cache_lock, &expected, (size_t)mutex)) {
+            volc_mutex_destroy(mutex);
+        }
+        lock = volc_atomic_load(&g_session_cache_lock);
+    }
+    volc_mutex_lock((volc_mutex_t)lock);
+    return (volc_mutex_t)lock;
+}
+
+static volc_tls_session_entry_t* _volc_tls_session_cache_find(const char* host) {
+    uint32_t i = 0;
+    for (i = 0; i < VOLC_TLS_SESSION_CACHE_SIZE; i++) {
+        if (g_session_cache.entries[i].used && strcmp(g_session_cache.entries[i].host, host) == 0) {
+            return &g_session_cache.entries[i];
+        }
+    }
+    return NULL;
+}
+
+static void _volc_tls_session_entry_clear(volc_tls_session_entry_t* entry) {
+    if (entry->used) {
+        mbedtls_ssl_session_free(&entry->session);
+        entry->used = false;
+    }
+}
+
+void volc_tls_session_cache_load(mbedtls_ssl_context* ssl, const char* host) {
+    volc_mutex_t lock = NULL;
+    volc_tls_session_entry_t* entry = NULL;
+    uint64_t now = volc_get_montionic_time_ms();
+
+    if (ssl == NULL || host == NULL || host[0] == '\0') {
+        return;
+    }
+    lock = _volc_tls_session_cache_lock();
+    entry = _volc_tls_session_cache_find(host);
+    if (entry != NULL && now >= entry->expire_ms) {
+        _volc_tls_session_entry_clear(entry);
+        entry = NULL;
+    }
+    if (entry != NULL) {
+        // a rejected session only costs the full handshake we would have done anyway
+        mbedtls_ssl_set_session(ssl, &entry->session);
+        entry->last_used_ms = now;
+    }
+    volc_mutex_unlock(lock);
+}
+
+void volc_tls_session_cache_save(mbedtls_ssl_context* ssl, const char* host) {
+    volc_mutex_t lock = NULL;
+    volc_tls_session_entry_t* entry = NULL;
+    mbedtls_ssl_session session;
+    uint64_t now = volc_get_montionic_time_ms();
+    uint32_t i = 0;
+
+    if (ssl == NULL || host == NULL || host[0] == '\0' || strlen(host) > VOLC_TLS_SESSION_CACHE_HOST_LENGTH) {
+        return;
+    }
+    mbedtls_ssl_session_init(&session);
+    if (mbedtls_ssl_get_session(ssl, &session) != 0) {
+        mbedtls_ssl_session_free(&session);
+        return;
+    }
+
+    lock = _volc_tls_session_cache_lock();
+    entry = _volc_tls_session_cache_find(host);
+    if (entry == NULL) {
+        entry = &g_session_cache.entries[0];
+        for (i = 0; i < VOLC_TLS_SESSION_CACHE_SIZE && entry->used; i++) {
+            volc_tls_session_entry_t* candidate = &g_session_cache.entries[i];
+            if (!candidate->used || candidate->last_used_ms < entry->last_used_ms) {
+                entry = candidate;
+            }
+        }
+    }
+    _volc_tls_session_entry_clear(entry);
+    strncpy(entry->host, host, VOLC_TLS_SESSION_CACHE_HOST_LENGTH);
+    entry->host[VOLC_TLS_SESSION_CACHE_HOST_LENGTH] = '\0';
+    // the entry takes ownership of the exported session
+    entry->session = session;
+    entry->expire_ms = now + (uint64_t)g_session_cache.lifetime_s * 1000;
+    entry->last_used_ms = now;
+    entry->used = true;
+    volc_mutex_unlock(lock);
+}
+
+void volc_tls_session_cache_remove(const char* host) {
+    volc_mutex_t lock = NULL;
+    volc_tls_session_entry_t* entry = NULL;
+
+    if (host == NULL) {
+        return;
+    }
+    lock = _volc_tls_session_cache_lock();
+    entry = _volc_tls_session_cache_find(host);
+    if (entry != NULL) {
+        _volc_tls_session_entry_clear(entry);
+    }
+    volc_mutex_unlock(lock);
+}
+
+void volc_tls_session_tickets_conf(mbedtls_ssl_config* conf) {
+#if defined(MBEDTLS_SSL_TICKET_C)
+    volc_mutex_t lock = _volc_tls_session_cache_lock();
+    if (g_session_cache.tickets_enabled) {
+        mbedtls_ssl_conf_session_tickets_cb(conf, mbedtls_ssl_ticket_write, mbedtls_ssl_ticket_parse, &g_session_cache.ticket);
+    }
+    volc_mutex_unlock(lock);
+#else
+    VOLC_UNUSED_PARAM(conf);
+#endif
+}
+
+void volc_tls_session_cache_set_lifetime(uint32_t lifetime_s) {
+    volc_mutex_t lock = _volc_tls_session_cache_lock();
+    g_session_cache.lifetime_s = lifetime_s;
+    volc_mutex_unlock(lock);
+}
+
+void volc_tls_session_cache_clear(void) {
+    volc_mutex_t lock = _volc_tls_session_cache_lock();
+    uint32_t i = 0;
+    for (i = 0; i < VOLC_TLS_SESSION_CACHE_SIZE; i++) {
+        _volc_tls_session_entry_clear(&g_session_cache.entries[i]);
+    }
+    volc_mutex_unlock(lock);
+}
+
+uint32_t volc_tls_enable_server_session_tickets(uint32_t lifetime_s) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+#if defined(MBEDTLS_SSL_TICKET_C)
+    volc_mutex_t lock = _volc_tls_session_cache_lock();
+
+    VOLC_CHK(!g_session_cache.tickets_enabled, VOLC_STATUS_SUCCESS);
+    mbedtls_entropy_init(&g_session_cache.entropy);
+    mbedtls_ctr_drbg_init(&g_session_cache.ctr_drbg);
+    mbedtls_ssl_ticket_init(&g_session_cache.ticket);
+    VOLC_CHK(mbedtls_ctr_drbg_seed(&g_session_cache.ctr_drbg, mbedtls_entropy_func, &g_session_cache.entropy, NULL, 0) == 0, VOLC_STATUS_CREATE_SSL_FAILED);
+    // the ticket context generates a fresh key every lifetime and keeps the previous one for decryption
+    VOLC_CHK(mbedtls_ssl_ticket_setup(&g_session_cache.ticket, mbedtls_ctr_drbg_random, &g_session_cache.ctr_drbg, MBEDTLS_CIPHER_AES_256_GCM,
+                                      lifetime_s > 0 ? lifetime_s : VOLC_TLS_SESSION_CACHE_DEFAULT_LIFETIME) == 0,
+             VOLC_STATUS_CREATE_SSL_FAILED);
+    g_session_cache.tickets_enabled = true;
+
+err_out_label:
+    if (VOLC_STATUS_FAILED(ret)) {
+        mbedtls_ssl_ticket_free(&g_session_cache.ticket);
+        mbedtls_ctr_drbg_free(&g_session_cache.ctr_drbg);
+        mbedtls_entropy_free(&g_session_cache.entropy);
+    }
+    volc_mutex_unlock(lock);
+#else
+    VOLC_UNUSED_PARAM(lifetime_s);
+    ret = VOLC_STATUS_NOT_IMPLEMENTED;
+#endif
+    return ret;
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_tls.h"
+#include "volc_tls_internal.h"
+
+#include <string.h>
+
+#include <mbedtls/x509_crt.h>
+
+#include "volc_crypto_internal.h"
+#include "volc_memory.h"
+#include "volc_mutex.h"
+#include "volc_time.h"
+#include "volc_type.h"
+
+#define VOLC_TLS_VERIFY_CACHE_SIZE        32
+#define VOLC_TLS_VERIFY_CACHE_DEFAULT_TTL 3600
+#define VOLC_TLS_VERIFY_DIGEST_LENGTH     32
+
+typedef struct {
+    uint8_t digest[VOLC_TLS_VERIFY_DIGEST_LENGTH];
+    uint64_t expire_ms;
+    uint64_t last_used_ms;
+    bool used;
+} volc_tls_verify_entry_t;
+
+struct volc_tls_verify_cache {
+    volc_mutex_t lock;
+    uint32_t ttl_s;
+    volc_tls_verify_entry_t entries[VOLC_TLS_VERIFY_CACHE_SIZE];
+};
+
+// the host is part of the key, a chain verified for one name says nothing about another
+static void _volc_tls_verify_digest(const mbedtls_x509_crt* chain, const char* host, uint8_t digest[VOLC_TLS_VERIFY_DIGEST_LENGTH]) {
+    volc_sha_state_t sha;
+    const mbedtls_x509_crt* crt = NULL;
+
+    volc_sha256_state_init(&sha);
+    volc_sha_state_update(&sha, (const uint8_t*)host, strlen(host) + 1);
+    for (crt = chain; crt != NULL && crt->raw.len > 0; crt = crt->next) {
+        volc_sha_state_update(&sha, crt->raw.p, crt->raw.len);
+    }
+    volc_sha_state_finish(&sha, digest);
+}
+
+static bool _volc_tls_verify_chain_expired(const mbedtls_x509_crt* chain) {
+#if defined(MBEDTLS_HAVE_TIME_DATE)
+    const mbedtls_x509_crt* crt = NULL;
+    for (crt = chain; crt != NULL && crt->raw.len > 0; crt = crt->next) {
+        if (mbedtls_x509_time_is_past(&crt->valid_to)) {
+            return true;
+        }
+    }
+#else
+    VOLC_UNUSED_PARAM(chain);
+#endif
+    return false;
+}
+
+static bool _volc_tls_verify_cache_lookup(volc_tls_verify_cache_t* cache, const uint8_t* digest) {
+    uint64_t now = volc_get_montionic_time_ms();
+    bool hit = false;
+    uint32_t i = 0;
+
+    volc_mutex_lock(cache->lock);
+    for (i = 0; i < VOLC_TLS_VERIFY_CACHE_SIZE; i++) {
+        volc_tls_verify_entry_t* entry = &cache->entries[i];
+        if (!entry->used || memcmp(entry->digest, digest, VOLC_TLS_VERIFY_DIGEST_LENGTH) != 0) {
+            continue;
+        }
+        if (now >= entry->expire_ms) {
+            entry->used = false;
+        } else {
+            entry->last_used_ms = now;
+            hit = true;
+        }
+        break;
+    }
+    volc_mutex_unlock(cache->lock);
+    return hit;
+}
+
+static void _volc_tls_verify_cache_insert(volc_tls_verify_cache_t* cache, const uint8_t* digest) {
+    uint64_t now = volc_get_montionic_time_ms();
+    volc_tls_verify_entry_t* entry = NULL;
+    uint32_t i = 0;
+
+    volc_mutex_lock(cache->lock);
+    entry = &cache->entries[0];
+    for (i = 0; i < VOLC_TLS_VERIFY_CACHE_SIZE && entry->used; i++) {
+        volc_tls_verify_entry_t* candidate = &cache->entries[i];
+        if (!candidate->used || candidate->last_used_ms < entry->last_used_ms) {
+            entry = candidate;
+        }
+    }
+    memcpy(entry->digest, digest, VOLC_TLS_VERIFY_DIGEST_LENGTH);
+    entry->expire_ms = now + (uint64_t)cache->ttl_s * 1000;
+    entry->last_used_ms = now;
+    entry->used = true;
+    volc_mutex_unlock(cache->lock);
+}
+
+int volc_tls_verify_peer(volc_tls_config_impl_t* config, const mbedtls_x509_crt* chain, const char* host) {
+    uint8_t digest[VOLC_TLS_VERIFY_DIGEST_LENGTH];
+    uint32_t flags = 0;
+    bool cacheable = false;
+
+    if (NULL == chain || NULL == host) {
+        return MBEDTLS_ERR_X509_CERT_VERIFY_FAILED;
+    }
+    if (_volc_tls_verify_chain_expired(chain)) {
+        return MBEDTLS_ERR_X509_CERT_VERIFY_FAILED;
+    }
+    cacheable = config->verify_cache != NULL;
+    if (cacheable) {
+        _volc_tls_verify_digest(chain, host, digest);
+    }
+    if (cacheable && _volc_tls_verify_cache_lookup(config->verify_cache, digest)) {
+        return 0;
+    }
+    // the CA store only ever grows, so a chain that verified once stays valid until it expires
+    if (mbedtls_x509_crt_verify((mbedtls_x509_crt*)chain, &config->cacert, NULL, host[0] != '\0' ? host : NULL, &flags, NULL, NULL) != 0) {
+        return MBEDTLS_ERR_X509_CERT_VERIFY_FAILED;
+    }
+    if (cacheable) {
+        _volc_tls_verify_cache_insert(config->verify_cache, digest);
+    }
+    return 0;
+}
+
+void volc_tls_verify_cache_free(volc_tls_verify_cache_t* cache) {
+    if (NULL == cache) {
+        return;
+    }
+    if (cache->lock != NULL) {
+        volc_mutex_destroy(cache->lock);
+    }
+    volc_free(cache);
+}
+
+uint32_t volc_tls_config_enable_peer_verification(volc_tls_config_t config, bool enable, uint32_t cache_ttl_s) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_config_impl_t* p_config = (volc_tls_config_impl_t*)config;
+    volc_tls_verify_cache_t* cache = NULL;
+
+    VOLC_CHK(p_config != NULL, VOLC_STATUS_NULL_ARG);
+    // verify_peer and verify_cache are read by connections without a lock, only the creator may still change them
+    VOLC_CHK(p_config->ref_count == 1, VOLC_STATUS_INVALID_OPERATION);
+    if (enable && p_config->verify_cache == NULL) {
+        cache = (volc_tls_verify_cache_t*)volc_malloc(sizeof(volc_tls_verify_cache_t));
+        VOLC_CHK(cache != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+        memset(cache, 0, sizeof(volc_tls_verify_cache_t));
+        cache->lock = volc_mutex_create(false);
+        VOLC_CHK(cache->lock != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+        p_config->verify_cache = cache;
+        cache = NULL;
+    }
+    if (p_config->verify_cache != NULL) {
+        volc_mutex_lock(p_config->verify_cache->lock);
+        p_config->verify_cache->ttl_s = cache_ttl_s > 0 ? cache_ttl_s : VOLC_TLS_VERIFY_CACHE_DEFAULT_TTL;
+        volc_mutex_unlock(p_config->verify_cache->lock);
+    }
+    p_config->verify_peer = enable;
+
+err_out_label:
+    volc_tls_verify_cache_free(cache);
+    return ret;
+}
+
+uint32_t volc_tls_config_clear_verify_cache(volc_tls_config_t config) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_config_impl_t* p_config = (volc_tls_config_impl_t*)config;
+
+    VOLC_CHK(p_config != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK(p_config->verify_cache != NULL, VOLC_STATUS_SUCCESS);
+    volc_mutex_lock(p_config->verify_cache->lock);
+    memset(p_config->verify_cache->entries, 0, sizeof(p_config->verify_cache->entries));
+    volc_mutex_unlock(p_config->verify_cache->lock);
+
+err_out_label:
+    return ret;
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_worker_pool.h"
+
+#include <string.h>
+
+#include "volc_cond.h"
+#include "volc_memory.h"
+#include "volc_mutex.h"
+#include "volc_socket.h"
+#include "volc_thread.h"
+#include "volc_time.h"
+#include "volc_type.h"
+
+#define VOLC_WORKER_POOL_MAX_THREADS 8
+
+typedef struct volc_worker_job {
+    struct volc_worker_job* next;
+    volc_worker_task_t task;
+    volc_worker_done_t done;
+    void* arg;
+    uint32_t status;
+} volc_worker_job_t;
+
+typedef struct {
+    volc_worker_job_t* head;
+    volc_worker_job_t* tail;
+} volc_worker_job_list_t;
+
+typedef struct {
+    volc_mutex_t lock;
+    volc_cond_t cond;
+    volc_worker_job_list_t pending;
+    volc_worker_job_list_t completed;
+    volc_tid_t threads[VOLC_WORKER_POOL_MAX_THREADS];
+    uint32_t thread_count;
+    int notify_fds[2];
+    bool notified;
+    bool stopping;
+} volc_worker_pool_impl_t;
+
+static void _volc_worker_job_list_push(volc_worker_job_list_t* list, volc_worker_job_t* job) {
+    job->next = NULL;
+    if (list->tail != NULL) {
+        list->tail->next = job;
+    } else {
+        list->head = job;
+    }
+    list->tail = job;
+}
+
+static volc_worker_job_t* _volc_worker_job_list_take_all(volc_worker_job_list_t* list) {
+    volc_worker_job_t* head = list->head;
+    list->head = NULL;
+    list->tail = NULL;
+    return head;
+}
+
+static void* _volc_worker_pool_routine(void* arg) {
+    volc_worker_pool_impl_t* p_pool = (volc_worker_pool_impl_t*)arg;
+    volc_worker_job_t* job = NULL;
+    uint8_t byte = 1;
+    bool notify = false;
+
+    while (true) {
+        volc_mutex_lock(p_pool->lock);
+        while (p_pool->pending.head == NULL && !p_pool->stopping) {
+            volc_cond_wait(p_pool->cond, p_pool->lock, VOLC_INFINITE_TIME_VALUE);
+        }
+        if (p_pool->stopping) {
+            volc_mutex_unlock(p_pool->lock);
+            break;
+        }
+        job = p_pool->pending.head;
+        p_pool->pending.head = job->next;
+        if (p_pool->pending.head == NULL) {
+            p_pool->pending.tail = NULL;
+        }
+        volc_mutex_unlock(p_pool->lock);
+
+        job->status = job->task(job->arg);
+
+        volc_mutex_lock(p_pool->lock);
+        _volc_worker_job_list_push(&p_pool->completed, job);
+        // one pending byte is enough to wake the loop, dispatch drains the whole list
+        notify = !p_pool->notified;
+        p_pool->notified = true;
+        volc_mutex_unlock(p_pool->lock);
+        if (notify) {
+            volc_write(p_pool->notify_fds[1], &byte, sizeof(byte));
+        }
+    }
+    return NULL;
+}
+
+uint32_t volc_worker_pool_create(uint32_t thread_count, volc_worker_pool_t* p_pool) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_worker_pool_impl_t* p_impl = NULL;
+    uint32_t i = 0;
+
+    VOLC_CHK(p_pool != NULL, VOLC_STATUS_NULL_ARG);
+    thread_count = VOLC_MAX(1, VOLC_MIN(thread_count, VOLC_WORKER_POOL_MAX_THREADS));
+    p_impl = (volc_worker_pool_impl_t*)volc_malloc(sizeof(volc_worker_pool_impl_t));
+    VOLC_CHK(p_impl != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    memset(p_impl, 0, sizeof(volc_worker_pool_impl_t));
+    p_impl->notify_fds[0] = -1;
+    p_impl->notify_fds[1] = -1;
+    p_impl->lock = volc_mutex_create(false);
+    p_impl->cond = volc_cond_create();
+    VOLC_CHK(p_impl->lock != NULL && p_impl->cond != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    VOLC_CHK(volc_make_pipe(p_impl->notify_fds) == 0, VOLC_STATUS_INTERNAL_ERROR);
+    for (i = 0; i < thread_count; i++) {
+        VOLC_CHK(volc_thread_create(&p_impl->threads[i], NULL, _volc_worker_pool_routine, p_impl) == VOLC_STATUS_SUCCESS, VOLC_STATUS_CREATE_THREAD_FAILED);
+        p_impl->thread_count++;
+    }
+    *p_pool = (volc_worker_pool_t)p_impl;
+
+err_out_label:
+    if (VOLC_STATUS_FAILED(ret) && p_impl != NULL) {
+        volc_worker_pool_destroy((volc_worker_pool_t)p_impl);
+    }
+    return ret;
+}
+
+uint32_t volc_worker_pool_destroy(volc_worker_pool_t pool) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_worker_pool_impl_t* p_pool = (volc_worker_pool_impl_t*)pool;
+    volc_worker_job_t* job = NULL;
+    uint32_t i = 0;
+
+    VOLC_CHK(p_pool != NULL, VOLC_STATUS_NULL_ARG);
+    if (p_pool->lock != NULL && p_pool->cond != NULL) {
+        volc_mutex_lock(p_pool->lock);
+        p_pool->stopping = true;
+        volc_cond_broadcast(p_pool->cond);
+        volc_mutex_unlock(p_pool->lock);
+    }
+    for (i = 0; i < p_pool->thread_count; i++) {
+        volc_thread_join(p_pool->threads[i], NULL);
+        volc_thread_destroy(p_pool->threads[i]);
+    }
+
+    volc_worker_pool_dispatch(pool);
+    job = _volc_worker_job_list_take_all(&p_pool->pending);
+    while (job != NULL) {
+        volc_worker_job_t* next = job->next;
+        if (job->done != NULL) {
+            job->done(job->arg, VOLC_STATUS_USER_CANCELED);
+        }
+        volc_free(job);
+        job = next;
+    }
+
+    if (p_pool->notify_fds[0] >= 0) {
+        volc_close(p_pool->notify_fds[0]);
+        volc_close(p_pool->notify_fds[1]);
+    }
+    if (p_pool->cond != NULL) {
+        volc_cond_destroy(p_pool->cond);
+    }
+    if (p_pool->lock != NULL) {
+        volc_mutex_destroy(p_pool->lock);
+    }
+    volc_free(p_pool);
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_worker_pool_submit(volc_worker_pool_t pool, volc_worker_task_t task, volc_worker_done_t done, void* arg) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_worker_pool_impl_t* p_pool = (volc_worker_pool_impl_t*)pool;
+    volc_worker_job_t* job = NULL;
+
+    VOLC_CHK(p_pool != NULL && task != NULL, VOLC_STATUS_NULL_ARG);
+    job = (volc_worker_job_t*)volc_malloc(sizeof(volc_worker_job_t));
+    VOLC_CHK(job != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    job->task = task;
+    job->done = done;
+    job->arg = arg;
+    job->status = VOLC_STATUS_SUCCESS;
+
+    volc_mutex_lock(p_pool->lock);
+    if (p_pool->stopping) {
+        volc_mutex_unlock(p_pool->lock);
+        volc_free(job);
+        VOLC_CHK(0, VOLC_STATUS_INVALID_OPERATION);
+    }
+    _volc_worker_job_list_push(&p_pool->pending, job);
+    volc_cond_signal(p_pool->cond);
+    volc_mutex_unlock(p_pool->lock);
+
+err_out_label:
+    return ret;
+}
+
+int volc_worker_pool_get_notify_fd(volc_worker_pool_t pool) {
+    volc_worker_pool_impl_t* p_pool = (volc_worker_pool_impl_t*)pool;
+    return p_pool != NULL ? p_pool->notify_fds[0] : -1;
+}
+
+uint32_t volc_worker_pool_dispatch(volc_worker_pool_t pool) {
+    volc_worker_pool_impl_t* p_pool = (volc_worker_pool_impl_t*)pool;
+    volc_worker_job_t* job = NULL;
+    uint8_t buf[16];
+    uint32_t count = 0;
+
+    if (p_pool == NULL) {
+        return 0;
+    }
+    volc_mutex_lock(p_pool->lock);
+    job = _volc_worker_job_list_take_all(&p_pool->completed);
+    if (p_pool->notified) {
+        while (volc_read(p_pool->notify_fds[0], buf, sizeof(buf)) > 0) {
+        }
+        p_pool->notified = false;
+    }
+    volc_mutex_unlock(p_pool->lock);
+
+    while (job != NULL) {
+        volc_worker_job_t* next = job->next;
+        if (job->done != NULL) {
+            job->done(job->arg, job->status);
+        }
+        volc_free(job);
+        job = next;
+        count++;
+    }
+    return count;
+}
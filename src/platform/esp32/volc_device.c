@@ -44,4 +44,9 @@ uint32_t volc_get_compiler_info(char* info, uint32_t len) {
     snprintf(info, len, "%s/%d.%d.%d", "GCC", (int)__GNUC__, (int)__GNUC_MINOR__, (int)__GNUC_PATCHLEVEL__);
 #endif
     return VOLC_SUCCESS;
-}
\ No newline at end of file
+}
+
+uint32_t volc_get_cpu_features(void) {
+    // Xtensa and RISC-V cores have none of the listed extensions, AES and SHA run on the crypto peripheral through the mbedtls port
+    return 0;
+}
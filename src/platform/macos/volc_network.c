@@ -12,16 +12,21 @@
 
 #include "volc_type.h"
 
-static uint32_t _volc_ip_addr_from_socket_addr(volc_ip_addr_t* p_ip_address, const struct sockaddr_in* p_addr) {
+static uint32_t _volc_ip_addr_from_socket_addr(volc_ip_addr_t* p_ip_address, const struct sockaddr* p_addr) {
     uint32_t ret = VOLC_STATUS_SUCCESS;
     VOLC_CHK(p_ip_address != NULL && p_addr != NULL, VOLC_STATUS_NULL_ARG);
-    if(p_addr->sin_family == AF_INET) {
+    if(p_addr->sa_family == AF_INET) {
+        const struct sockaddr_in* p_addr4 = (const struct sockaddr_in*)p_addr;
         p_ip_address->family = VOLC_IP_FAMILY_TYPE_IPV4;
-        p_ip_address->port = (p_addr->sin_port);
-        memcpy(p_ip_address->address, &p_addr->sin_addr, VOLC_IPV4_ADDRESS_LENGTH);
-    } else if(p_addr->sin_family == AF_INET6) {
+        p_ip_address->port = (p_addr4->sin_port);
+        memcpy(p_ip_address->address, &p_addr4->sin_addr, VOLC_IPV4_ADDRESS_LENGTH);
+    } else if(p_addr->sa_family == AF_INET6) {
+        const struct sockaddr_in6* p_addr6 = (const struct sockaddr_in6*)p_addr;
+        // link-local addresses need a scope id which volc_ip_addr_t cannot carry
+        VOLC_CHK(!IN6_IS_ADDR_LINKLOCAL(&p_addr6->sin6_addr), VOLC_STATUS_INVALID_ARG);
         p_ip_address->family = VOLC_IP_FAMILY_TYPE_IPV6;
-        VOLC_CHK(0,VOLC_STATUS_FAILURE);
+        p_ip_address->port = (p_addr6->sin6_port);
+        memcpy(p_ip_address->address, &p_addr6->sin6_addr, VOLC_IPV6_ADDRESS_LENGTH);
     } else {
         ret = VOLC_STATUS_INVALID_ARG;
     }
@@ -58,7 +63,7 @@ uint32_t volc_get_local_ip(volc_ip_addr_t* dest_ip_list, uint32_t* p_dest_ip_lis
 
             // If callback is set, ensure the details are collected for the interface
             if (filter_set == true) {
-                if(_volc_ip_addr_from_socket_addr(&dest_ip_list[ip_count], (struct sockaddr_in*)ifa->ifa_addr) == VOLC_STATUS_SUCCESS) {
+                if(_volc_ip_addr_from_socket_addr(&dest_ip_list[ip_count], ifa->ifa_addr) == VOLC_STATUS_SUCCESS) {
                     ip_count++;
                 }
             }
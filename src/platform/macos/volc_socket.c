@@ -1,8 +1,10 @@
+#define __APPLE_USE_RFC_3542
 #include "volc_socket.h"
 
 #include <errno.h>
 #include <fcntl.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 
 #include <ifaddrs.h>
@@ -19,17 +21,25 @@
 #include "volc_type.h"
 #include "volc_errno.h"
 #include "volc_memory.h"
+#include "volc_time.h"
 #include <assert.h>
 
-static uint32_t _volc_ip_addr_to_socket_addr(const volc_ip_addr_t* p_ip_address, struct sockaddr_in* p_addr) {
+static uint32_t _volc_ip_addr_to_socket_addr(const volc_ip_addr_t* p_ip_address, struct sockaddr_storage* p_addr, socklen_t* p_addr_len) {
     uint32_t ret = VOLC_STATUS_SUCCESS;
-    VOLC_CHK(p_ip_address != NULL,VOLC_STATUS_NULL_ARG);
+    struct sockaddr_in* p_addr4 = (struct sockaddr_in*)p_addr;
+    struct sockaddr_in6* p_addr6 = (struct sockaddr_in6*)p_addr;
+    VOLC_CHK(p_ip_address != NULL && p_addr != NULL && p_addr_len != NULL, VOLC_STATUS_NULL_ARG);
+    memset(p_addr, 0, sizeof(struct sockaddr_storage));
     if(p_ip_address->family == VOLC_IP_FAMILY_TYPE_IPV4) {
-        p_addr->sin_family = AF_INET;
-        p_addr->sin_port = (p_ip_address->port);
-        memcpy(&p_addr->sin_addr, p_ip_address->address, VOLC_IPV4_ADDRESS_LENGTH);
+        p_addr4->sin_family = AF_INET;
+        p_addr4->sin_port = (p_ip_address->port);
+        memcpy(&p_addr4->sin_addr, p_ip_address->address, VOLC_IPV4_ADDRESS_LENGTH);
+        *p_addr_len = sizeof(struct sockaddr_in);
     } else if(p_ip_address->family == VOLC_IP_FAMILY_TYPE_IPV6) {
-        p_addr->sin_family = AF_INET6;
+        p_addr6->sin6_family = AF_INET6;
+        p_addr6->sin6_port = (p_ip_address->port);
+        memcpy(&p_addr6->sin6_addr, p_ip_address->address, VOLC_IPV6_ADDRESS_LENGTH);
+        *p_addr_len = sizeof(struct sockaddr_in6);
     } else {
         ret = VOLC_STATUS_INVALID_ARG;
     }
@@ -37,16 +47,19 @@ err_out_label:
     return ret;
 }
 
-static uint32_t _volc_ip_addr_from_socket_addr(volc_ip_addr_t* p_ip_address, const struct sockaddr_in* p_addr) {
+static uint32_t _volc_ip_addr_from_socket_addr(volc_ip_addr_t* p_ip_address, const struct sockaddr* p_addr) {
     uint32_t ret = VOLC_STATUS_SUCCESS;
     VOLC_CHK(p_ip_address != NULL && p_addr != NULL, VOLC_STATUS_NULL_ARG);
-    if(p_addr->sin_family == AF_INET) {
+    if(p_addr->sa_family == AF_INET) {
+        const struct sockaddr_in* p_addr4 = (const struct sockaddr_in*)p_addr;
         p_ip_address->family = VOLC_IP_FAMILY_TYPE_IPV4;
-        p_ip_address->port = (p_addr->sin_port);
-        memcpy(p_ip_address->address, &p_addr->sin_addr, VOLC_IPV4_ADDRESS_LENGTH);
-    } else if(p_addr->sin_family == AF_INET6) {
+        p_ip_address->port = (p_addr4->sin_port);
+        memcpy(p_ip_address->address, &p_addr4->sin_addr, VOLC_IPV4_ADDRESS_LENGTH);
+    } else if(p_addr->sa_family == AF_INET6) {
+        const struct sockaddr_in6* p_addr6 = (const struct sockaddr_in6*)p_addr;
         p_ip_address->family = VOLC_IP_FAMILY_TYPE_IPV6;
-        VOLC_CHK(0,VOLC_STATUS_FAILURE);
+        p_ip_address->port = (p_addr6->sin6_port);
+        memcpy(p_ip_address->address, &p_addr6->sin6_addr, VOLC_IPV6_ADDRESS_LENGTH);
     } else {
         ret = VOLC_STATUS_INVALID_ARG;
     }
@@ -61,9 +74,13 @@ int volc_socket (int __domain, int __type, int __protocol) {
 }
 
 int volc_bind (int __fd, const volc_ip_addr_t* __addr){
-    struct sockaddr_in addr;
-    _volc_ip_addr_to_socket_addr(__addr, &addr);
-    return bind(__fd, (struct sockaddr*)&addr, sizeof(addr));
+    struct sockaddr_storage addr;
+    socklen_t addr_len = 0;
+    if (_volc_ip_addr_to_socket_addr(__addr, &addr, &addr_len) != VOLC_STATUS_SUCCESS) {
+        errno = EINVAL;
+        return -1;
+    }
+    return bind(__fd, (struct sockaddr*)&addr, addr_len);
 }
 
 int volc_listen (int __fd, int __n) {
@@ -71,10 +88,12 @@ int volc_listen (int __fd, int __n) {
 }
 
 int volc_accept (int __fd, volc_ip_addr_t* __addr, int * __addr_len){
-    struct sockaddr_in addr;
+    struct sockaddr_storage addr;
     socklen_t addr_len = sizeof(addr);
     int ret = accept(__fd, (struct sockaddr*)&addr, &addr_len);
-    _volc_ip_addr_from_socket_addr(__addr, &addr);
+    if (ret >= 0 && __addr != NULL) {
+        _volc_ip_addr_from_socket_addr(__addr, (struct sockaddr*)&addr);
+    }
     if (__addr_len) {
         *__addr_len = addr_len;
     }
@@ -84,14 +103,14 @@ int volc_accept (int __fd, volc_ip_addr_t* __addr, int * __addr_len){
 int volc_connect (int __fd, volc_ip_addr_t* __addr) {
     uint32_t ret_status = VOLC_STATUS_SUCCESS;
     int r = 0;
-    struct sockaddr_in addr = {0};
-    _volc_ip_addr_to_socket_addr(__addr, &addr);
+    struct sockaddr_storage addr;
+    socklen_t addr_len = 0;
+    if (_volc_ip_addr_to_socket_addr(__addr, &addr, &addr_len) != VOLC_STATUS_SUCCESS) {
+        return VOLC_STATUS_EVLOOP_PERFORM_FAILED;
+    }
     do {
         errno = 0;
-        char ip[INET_ADDRSTRLEN] = {0};
-        inet_ntop(AF_INET, &addr.sin_addr, ip, sizeof(ip));
-        r = connect(__fd, (struct sockaddr*)&addr, (socklen_t)sizeof(addr));
-        printf("++++++++++++++++++++volc_connect %s af %d %d %d fd %d\n", ip, addr.sin_family,ntohs(addr.sin_port),addr.sin_port,__fd);
+        r = connect(__fd, (struct sockaddr*)&addr, addr_len);
     } while (r == -1 && errno == EINTR);
 
     if(r == -1 && errno != EINPROGRESS)  {
@@ -105,6 +124,77 @@ int volc_connect (int __fd, volc_ip_addr_t* __addr) {
     return ret_status; 
 }
 
+uint32_t volc_connect_check(int __fd, uint64_t deadline_ms) {
+    uint32_t ret = VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY;
+    struct volc_pollfd pfd = {.fd = __fd, .events = VOLC_EVLOOP_POLLOUT, .revents = 0};
+    int err = 0;
+    socklen_t len = sizeof(err);
+    int r = volc_poll(&pfd, 1, 0);
+    VOLC_CHK(r >= 0 || errno == EINTR, VOLC_STATUS_SOCKET_CONNECT_FAILED);
+    if (r > 0 && (pfd.revents & (VOLC_EVLOOP_POLLOUT | VOLC_EVLOOP_POLLERR | VOLC_EVLOOP_POLLHUP)) != 0) {
+        VOLC_CHK(getsockopt(__fd, SOL_SOCKET, SO_ERROR, &err, &len) == 0, VOLC_STATUS_SOCKET_CONNECT_FAILED);
+        if (err != 0) {
+            errno = err;
+            VOLC_CHK(0, VOLC_STATUS_SOCKET_CONNECT_FAILED);
+        }
+        ret = VOLC_STATUS_SUCCESS;
+        goto err_out_label;
+    }
+    VOLC_CHK(deadline_ms == VOLC_INFINITE_TIME_VALUE || volc_get_montionic_time_ms() < deadline_ms, VOLC_STATUS_OPERATION_TIMED_OUT);
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_connect_with_timeout(int __fd, volc_ip_addr_t* __addr, uint32_t timeout_ms) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    uint64_t now = volc_get_montionic_time_ms();
+    uint64_t deadline = now + timeout_ms;
+    struct volc_pollfd pfd = {.fd = __fd, .events = VOLC_EVLOOP_POLLOUT, .revents = 0};
+
+    ret = volc_connect(__fd, __addr);
+    VOLC_CHK(ret != VOLC_STATUS_EVLOOP_PERFORM_FAILED, VOLC_STATUS_SOCKET_CONNECT_FAILED);
+    while (ret == VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY) {
+        now = volc_get_montionic_time_ms();
+        volc_poll(&pfd, 1, now < deadline ? (int)(deadline - now) : 0);
+        ret = volc_connect_check(__fd, deadline);
+    }
+err_out_label:
+    return ret;
+}
+
+// darwin has no TCP_FASTOPEN_CONNECT, fast open goes through connectx with idempotent data
+uint32_t volc_sockopt_set_fast_open_connect(int __fd, bool enable) {
+    VOLC_UNUSED_PARAM(__fd);
+    return enable ? VOLC_STATUS_NOT_IMPLEMENTED : VOLC_STATUS_SUCCESS;
+}
+
+uint32_t volc_connect_fast_open(int __fd, volc_ip_addr_t* __addr, const void* data, size_t size, size_t* p_sent) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    struct sockaddr_storage addr;
+    socklen_t addr_len = 0;
+    sa_endpoints_t endpoints;
+    struct iovec iov = {.iov_base = (void*)data, .iov_len = size};
+    size_t sent = 0;
+    int r = 0;
+    VOLC_CHK(p_sent != NULL, VOLC_STATUS_NULL_ARG);
+    *p_sent = 0;
+    VOLC_CHK_STATUS(_volc_ip_addr_to_socket_addr(__addr, &addr, &addr_len));
+    memset(&endpoints, 0, sizeof(endpoints));
+    endpoints.sae_dstaddr = (struct sockaddr*)&addr;
+    endpoints.sae_dstaddrlen = addr_len;
+    do {
+        errno = 0;
+        r = connectx(__fd, &endpoints, SAE_ASSOCID_ANY, CONNECT_DATA_IDEMPOTENT, &iov, 1, &sent, NULL);
+    } while (r == -1 && errno == EINTR);
+    *p_sent = sent;
+    if (r == -1) {
+        VOLC_CHK(errno == EINPROGRESS, VOLC_STATUS_EVLOOP_PERFORM_FAILED);
+        ret = VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY;
+    }
+err_out_label:
+    return ret;
+}
+
 ssize_t volc_recv_msg (int __fd, void* data, size_t size, volc_ip_addr_t* p_addr,uint32_t* p_status){
     uint32_t ret_status = VOLC_STATUS_SUCCESS;
     struct msghdr msg = {0};
@@ -125,7 +215,7 @@ ssize_t volc_recv_msg (int __fd, void* data, size_t size, volc_ip_addr_t* p_addr
     if( r> 0) {
         ret_status = VOLC_STATUS_SUCCESS;
         if(p_addr != NULL) {
-            _volc_ip_addr_from_socket_addr(p_addr, &peer);
+            _volc_ip_addr_from_socket_addr(p_addr, (struct sockaddr*)&peer);
         }
     }else if(errno == EAGAIN || errno == EWOULDBLOCK) {
         ret_status = VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY;
@@ -144,11 +234,18 @@ ssize_t volc_send_msg (int __fd, void* data, size_t size , volc_ip_addr_t* __add
     struct iovec iov ={.iov_base = data,.iov_len = size};
     msg.msg_iov = &iov;
     msg.msg_iovlen = 1;
-    struct sockaddr_in addr;
-    _volc_ip_addr_to_socket_addr(__addr, &addr);
+    struct sockaddr_storage addr;
+    socklen_t addr_len = 0;
     int r = 0;
+    // a NULL address sends on an already connected socket
+    if (__addr != NULL && _volc_ip_addr_to_socket_addr(__addr, &addr, &addr_len) != VOLC_STATUS_SUCCESS) {
+        if (p_status != NULL) {
+            *p_status = VOLC_STATUS_EVLOOP_PERFORM_FAILED;
+        }
+        return -1;
+    }
     do{
-        r =  sendto(__fd,data,size,0, (struct sockaddr*)&addr, (socklen_t)sizeof(addr));
+        r =  sendto(__fd,data,size,0, __addr != NULL ? (struct sockaddr*)&addr : NULL, addr_len);
 
         // char ip[INET_ADDRSTRLEN] = {0};
         // inet_ntop(AF_INET, &addr.sin_addr, ip, sizeof(ip));
@@ -160,6 +257,8 @@ ssize_t volc_send_msg (int __fd, void* data, size_t size , volc_ip_addr_t* __add
         ret_status = VOLC_STATUS_SUCCESS;
     }else if(errno == EAGAIN || errno == EWOULDBLOCK) {
         ret_status = VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY;
+    } else if(r < 0 && errno == EMSGSIZE) {
+        ret_status = VOLC_STATUS_MESSAGE_TOO_BIG;
     } else if(r < 0) {
         ret_status = VOLC_STATUS_EVLOOP_PERFORM_FAILED;
     };
@@ -299,7 +398,120 @@ int volc_sockopt_set_buffer_size(int __fd, bool _is_send_buffer,int buffer_size)
     return getsockopt(__fd,SOL_SOCKET,opt_name,&buffer_size,&len);
  } ;
 
-int volc_getaddrinfo(const char* host, uint16_t port, volc_ip_addr_t** addrs, int* count) {
+static int _volc_socket_family(int __fd) {
+    struct sockaddr_storage addr;
+    socklen_t addr_len = sizeof(addr);
+    memset(&addr, 0, sizeof(addr));
+    if (getsockname(__fd, (struct sockaddr*)&addr, &addr_len) != 0) {
+        return AF_UNSPEC;
+    }
+    return addr.ss_family;
+}
+
+// darwin has no IP_MTU_DISCOVER, only the DF switch, and the cached path mtu is not exposed for ipv4
+uint32_t volc_sockopt_set_pmtu_discover(int __fd, volc_pmtu_discover_mode_e mode) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    int family = _volc_socket_family(__fd);
+    int value = (mode == VOLC_PMTU_DISCOVER_DO || mode == VOLC_PMTU_DISCOVER_PROBE) ? 1 : 0;
+    VOLC_CHK(family == AF_INET || family == AF_INET6, VOLC_STATUS_INVALID_ARG);
+    VOLC_CHK(mode <= VOLC_PMTU_DISCOVER_PROBE, VOLC_STATUS_INVALID_ARG);
+    if (family == AF_INET) {
+#ifdef IP_DONTFRAG
+        VOLC_CHK(setsockopt(__fd, IPPROTO_IP, IP_DONTFRAG, &value, sizeof(value)) == 0, VOLC_STATUS_SET_SOCKET_FLAG_FAILED);
+#else
+        VOLC_CHK(value == 0, VOLC_STATUS_NOT_IMPLEMENTED);
+#endif
+    } else {
+#ifdef IPV6_DONTFRAG
+        VOLC_CHK(setsockopt(__fd, IPPROTO_IPV6, IPV6_DONTFRAG, &value, sizeof(value)) == 0, VOLC_STATUS_SET_SOCKET_FLAG_FAILED);
+#else
+        VOLC_CHK(value == 0, VOLC_STATUS_NOT_IMPLEMENTED);
+#endif
+    }
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_sockopt_get_path_mtu(int __fd, uint32_t* p_mtu) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    int family = _volc_socket_family(__fd);
+    VOLC_CHK(p_mtu != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK(family == AF_INET || family == AF_INET6, VOLC_STATUS_INVALID_ARG);
+#ifdef IPV6_PATHMTU
+    if (family == AF_INET6) {
+        struct ip6_mtuinfo mtu_info;
+        socklen_t len = sizeof(mtu_info);
+        memset(&mtu_info, 0, sizeof(mtu_info));
+        VOLC_CHK(getsockopt(__fd, IPPROTO_IPV6, IPV6_PATHMTU, &mtu_info, &len) == 0, VOLC_STATUS_GET_SOCKET_FLAG_FAILED);
+        VOLC_CHK(mtu_info.ip6m_mtu > 0, VOLC_STATUS_GET_SOCKET_FLAG_FAILED);
+        *p_mtu = mtu_info.ip6m_mtu;
+        goto err_out_label;
+    }
+#endif
+    ret = VOLC_STATUS_NOT_IMPLEMENTED;
+err_out_label:
+    return ret;
+}
+uint32_t volc_get_max_udp_payload(int __fd, uint32_t* p_payload) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    uint32_t mtu = 0;
+    uint32_t header_size = 0;
+    VOLC_CHK(p_payload != NULL, VOLC_STATUS_NULL_ARG);
+    VOLC_CHK_STATUS(volc_sockopt_get_path_mtu(__fd, &mtu));
+    // ip header + udp header
+    header_size = (_volc_socket_family(__fd) == AF_INET6 ? 40 : 20) + 8;
+    VOLC_CHK(mtu > header_size, VOLC_STATUS_GET_SOCKET_FLAG_FAILED);
+    *p_payload = mtu - header_size;
+err_out_label:
+    return ret;
+}
+
+uint32_t volc_sockopt_set_ktls(int __fd, const volc_ktls_crypto_info_t* tx, const volc_ktls_crypto_info_t* rx) {
+    VOLC_UNUSED_PARAM(__fd);
+    VOLC_UNUSED_PARAM(tx);
+    VOLC_UNUSED_PARAM(rx);
+    return VOLC_STATUS_NOT_IMPLEMENTED;
+}
+
+ssize_t volc_ktls_recv(int __fd, void* data, size_t size, uint32_t* p_status) {
+    VOLC_UNUSED_PARAM(__fd);
+    VOLC_UNUSED_PARAM(data);
+    VOLC_UNUSED_PARAM(size);
+    if (p_status != NULL) {
+        *p_status = VOLC_STATUS_NOT_IMPLEMENTED;
+    }
+    return -1;
+}
+
+ssize_t volc_ktls_send(int __fd, const void* data, size_t size, uint32_t* p_status) {
+    uint32_t ret_status = VOLC_STATUS_SUCCESS;
+    ssize_t r = 0;
+    do {
+        r = send(__fd, data, size, 0);
+    } while (r < 0 && errno == EINTR);
+    if (r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        ret_status = VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY;
+    } else if (r < 0) {
+        ret_status = VOLC_STATUS_EVLOOP_PERFORM_FAILED;
+    }
+    if (p_status != NULL) {
+        *p_status = ret_status;
+    }
+    return r;
+}
+
+ssize_t volc_sendfile(int __fd, int file_fd, int64_t offset, size_t count, uint32_t* p_status) {
+    VOLC_UNUSED_PARAM(__fd);
+    VOLC_UNUSED_PARAM(file_fd);
+    VOLC_UNUSED_PARAM(offset);
+    VOLC_UNUSED_PARAM(count);
+    if (p_status != NULL) {
+        *p_status = VOLC_STATUS_NOT_IMPLEMENTED;
+    }
+    return -1;
+}
+
+int volc_getaddrinfo_with_family(const char* host, uint16_t port, uint16_t family, volc_ip_addr_t** addrs, int* count) {
     int index = 0;
     struct addrinfo hints;
     memset(&hints, 0, sizeof(hints));
@@ -307,6 +519,11 @@ int volc_getaddrinfo(const char* host, uint16_t port, volc_ip_addr_t** addrs, in
     struct addrinfo *cur = NULL;
 
     hints.ai_family     = AF_UNSPEC;
+    if (family == VOLC_IP_FAMILY_TYPE_IPV4) {
+        hints.ai_family = AF_INET;
+    } else if (family == VOLC_IP_FAMILY_TYPE_IPV6) {
+        hints.ai_family = AF_INET6;
+    }
     hints.ai_socktype   = SOCK_STREAM;
     hints.ai_protocol   = IPPROTO_TCP;
     hints.ai_flags = AI_CANONNAME | AI_ADDRCONFIG;
@@ -319,9 +536,10 @@ int volc_getaddrinfo(const char* host, uint16_t port, volc_ip_addr_t** addrs, in
 
     snprintf(port_str, sizeof(port_str), "%d", (int)port);
     int ret = getaddrinfo(host, port_str, &hints, &res);
-    if (ret < 0) {
+    if (ret != 0) {
         return VOLC_FAILED;
     }
+    *count = 0;
     cur = res;
     while(cur) {
         (*count)++;
@@ -330,7 +548,7 @@ int volc_getaddrinfo(const char* host, uint16_t port, volc_ip_addr_t** addrs, in
     *addrs = (volc_ip_addr_t*)volc_malloc(sizeof(volc_ip_addr_t) * (*count));
     cur = res;
     while (cur) {
-        _volc_ip_addr_from_socket_addr(&(*addrs)[index], (struct sockaddr_in*)cur->ai_addr);
+        _volc_ip_addr_from_socket_addr(&(*addrs)[index], cur->ai_addr);
         index++;
         cur = cur->ai_next;
     }
@@ -338,6 +556,10 @@ int volc_getaddrinfo(const char* host, uint16_t port, volc_ip_addr_t** addrs, in
     return VOLC_SUCCESS;
 }
 
+int volc_getaddrinfo(const char* host, uint16_t port, volc_ip_addr_t** addrs, int* count) {
+    return volc_getaddrinfo_with_family(host, port, 0, addrs, count);
+}
+
 int volc_freeaddrinfo(volc_ip_addr_t* addrs) {
     if (addrs) {
         volc_free(addrs);
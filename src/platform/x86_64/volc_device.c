@@ -1,8 +1,16 @@
 #include "volc_device.h"
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <sys/utsname.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(__aarch64__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
 
+#include "volc_atomic.h"
 #include "volc_errno.h"
 
 uint32_t volc_get_platform_name(char* platform, uint32_t len) {
@@ -53,4 +61,71 @@ uint32_t volc_get_compiler_info(char* info, uint32_t len) {
     snprintf(info, len, "%s/%d.%d.%d", "GCC", (int)__GNUC__, (int)__GNUC_MINOR__, (int)__GNUC_PATCHLEVEL__);
 #endif
     return VOLC_SUCCESS;
-}
\ No newline at end of file
+}
+
+#define VOLC_CPU_FEATURES_PROBED (1u << 31)
+#if defined(__x86_64__) || defined(__i386__)
+static uint32_t _volc_cpu_probe_x86(void) {
+    uint32_t features = 0;
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    unsigned int max_leaf = __get_cpuid_max(0, NULL);
+    uint32_t xcr0_lo = 0, xcr0_hi = 0;
+    bool ymm_enabled = false;
+
+    if (max_leaf < 1 || !__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+    features |= (edx & (1u << 26)) ? VOLC_CPU_FEATURE_SSE2 : 0;
+    features |= (ecx & (1u << 9)) ? VOLC_CPU_FEATURE_SSSE3 : 0;
+    features |= (ecx & (1u << 19)) ? VOLC_CPU_FEATURE_SSE41 : 0;
+    features |= (ecx & (1u << 20)) ? VOLC_CPU_FEATURE_SSE42 : 0;
+    features |= (ecx & (1u << 25)) ? VOLC_CPU_FEATURE_AESNI : 0;
+    features |= (ecx & (1u << 1)) ? VOLC_CPU_FEATURE_PCLMULQDQ : 0;
+    // AVX needs OSXSAVE and the OS saving both XMM and YMM state in XCR0
+    if ((ecx & (1u << 27)) && (ecx & (1u << 28))) {
+        __asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+        ymm_enabled = (xcr0_lo & 0x6) == 0x6;
+        features |= ymm_enabled ? VOLC_CPU_FEATURE_AVX : 0;
+    }
+    if (max_leaf >= 7) {
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        features |= (ymm_enabled && (ebx & (1u << 5))) ? VOLC_CPU_FEATURE_AVX2 : 0;
+        features |= (ebx & (1u << 8)) ? VOLC_CPU_FEATURE_BMI2 : 0;
+        features |= (ebx & (1u << 29)) ? VOLC_CPU_FEATURE_SHA : 0;
+    }
+    return features;
+}
+
+static uint32_t _volc_cpu_probe(void) {
+    return _volc_cpu_probe_x86();
+}
+#elif defined(__aarch64__)
+static uint32_t _volc_cpu_probe(void) {
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    uint32_t features = 0;
+
+    features |= (hwcap & HWCAP_ASIMD) ? VOLC_CPU_FEATURE_NEON : 0;
+    features |= (hwcap & HWCAP_AES) ? VOLC_CPU_FEATURE_ARM_AES : 0;
+    features |= (hwcap & HWCAP_PMULL) ? VOLC_CPU_FEATURE_ARM_PMULL : 0;
+    features |= (hwcap & HWCAP_SHA1) ? VOLC_CPU_FEATURE_ARM_SHA1 : 0;
+    features |= (hwcap & HWCAP_SHA2) ? VOLC_CPU_FEATURE_ARM_SHA2 : 0;
+    features |= (hwcap & HWCAP_CRC32) ? VOLC_CPU_FEATURE_ARM_CRC32 : 0;
+    return features;
+}
+#else
+static uint32_t _volc_cpu_probe(void) {
+    return 0;
+}
+#endif
+
+uint32_t volc_get_cpu_features(void) {
+    // the probe result never changes, racing first callers store the same value
+    static volatile size_t s_features = 0;
+    size_t features = volc_atomic_load(&s_features);
+
+    if (features == 0) {
+        features = VOLC_CPU_FEATURES_PROBED | _volc_cpu_probe();
+        volc_atomic_store(&s_features, features);
+    }
+    return (uint32_t)(features & ~VOLC_CPU_FEATURES_PROBED);
+}
@@ -115,4 +115,16 @@ uint32_t volc_file_delete(const char* path) {
     unlink(path);
 err_out_label:
     return ret;
-}
\ No newline at end of file
+}
+
+ssize_t volc_file_pread(int fd, uint8_t* buffer, size_t size, int64_t offset, uint32_t* p_status) {
+    ssize_t r = 0;
+
+    do {
+        r = pread(fd, buffer, size, (off_t) offset);
+    } while (r < 0 && errno == EINTR);
+    if (p_status != NULL) {
+        *p_status = r < 0 ? VOLC_STATUS_READ_FILE_FAILED : VOLC_STATUS_SUCCESS;
+    }
+    return r;
+}
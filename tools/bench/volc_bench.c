@@ -0,0 +1,100 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <mbedtls/version.h>
+
+#include "volc_crypto.h"
+#include "volc_device.h"
+#include "volc_time.h"
+#include "volc_type.h"
+
+#define VOLC_BENCH_DEFAULT_DURATION_MS 1000
+
+typedef struct {
+    const char* name;
+    volc_bench_suite_fn run;
+} volc_bench_suite_t;
+
+static const volc_bench_suite_t g_bench_suites[] = {
+    {"tls", volc_bench_tls},
+    {"srtp", volc_bench_srtp},
+    {"crc", volc_bench_crc},
+};
+
+void volc_bench_report(volc_bench_t* bench, const char* suite, const char* name, double value, const char* unit) {
+    fprintf(bench->out, "%s\n    {\"suite\": \"%s\", \"name\": \"%s\", \"value\": %.3f, \"unit\": \"%s\"}", bench->result_count == 0 ? "" : ",", suite, name,
+            value, unit);
+    bench->result_count++;
+    fflush(bench->out);
+}
+
+bool volc_bench_running(volc_bench_t* bench, uint64_t start_ms, uint64_t* p_elapsed_ms) {
+    *p_elapsed_ms = volc_get_montionic_time_ms() - start_ms;
+    return *p_elapsed_ms < bench->duration_ms;
+}
+
+static void _volc_bench_usage(const char* argv0) {
+    uint32_t i = 0;
+    fprintf(stderr, "usage: %s [--duration-ms N] [--suite NAME]... [--portable]\n  suites:", argv0);
+    for (i = 0; i < VOLC_ARRAY_SIZE(g_bench_suites); i++) {
+        fprintf(stderr, " %s", g_bench_suites[i].name);
+    }
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char** argv) {
+    volc_bench_t bench;
+    const char* selected[VOLC_ARRAY_SIZE(g_bench_suites)];
+    uint32_t selected_count = 0;
+    volc_crypto_implementations_t impls;
+    uint32_t failed = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+    int arg = 0;
+
+    memset(&bench, 0, sizeof(bench));
+    bench.out = stdout;
+    bench.duration_ms = VOLC_BENCH_DEFAULT_DURATION_MS;
+    for (arg = 1; arg < argc; arg++) {
+        if (strcmp(argv[arg], "--duration-ms") == 0 && arg + 1 < argc) {
+            bench.duration_ms = (uint32_t)strtoul(argv[++arg], NULL, 10);
+        } else if (strcmp(argv[arg], "--suite") == 0 && arg + 1 < argc && selected_count < VOLC_ARRAY_SIZE(selected)) {
+            selected[selected_count++] = argv[++arg];
+        } else if (strcmp(argv[arg], "--portable") == 0) {
+            // baseline run without the HAL's own hardware kernels, mbedtls keeps its AES/GHASH choice
+            volc_crypto_select_implementations(0);
+        } else {
+            _volc_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    memset(&impls, 0, sizeof(impls));
+    volc_crypto_get_implementations(&impls);
+    fprintf(bench.out, "{\n  \"mbedtls_version\": \"%s\",\n  \"duration_ms\": %u,\n", MBEDTLS_VERSION_STRING, bench.duration_ms);
+    fprintf(bench.out,
+            "  \"cpu_features\": \"0x%08x\",\n  \"implementations\": {\"aes\": \"%s\", \"ghash\": \"%s\", \"sha1\": \"%s\", \"sha256\": \"%s\", "
+            "\"aes_ctr\": \"%s\", \"sha1_batch\": \"%s\", \"crc32\": \"%s\", \"crc32c\": \"%s\"},\n",
+            volc_get_cpu_features(), impls.aes, impls.ghash, impls.sha1, impls.sha256, impls.aes_ctr, impls.sha1_batch, impls.crc32, impls.crc32c);
+    fprintf(bench.out, "  \"results\": [");
+    for (i = 0; i < VOLC_ARRAY_SIZE(g_bench_suites); i++) {
+        for (j = 0; j < selected_count && strcmp(selected[j], g_bench_suites[i].name) != 0; j++) {
+        }
+        if (selected_count > 0 && j == selected_count) {
+            continue;
+        }
+        if (VOLC_STATUS_FAILED(g_bench_suites[i].run(&bench))) {
+            fprintf(stderr, "suite %s failed\n", g_bench_suites[i].name);
+            failed++;
+        }
+    }
+    fprintf(bench.out, "\n  ]\n}\n");
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef __HAL_VOLC_BENCH_H__
+#define __HAL_VOLC_BENCH_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// shared state of one volc_hal_bench run, results are streamed to out as a single JSON document
+typedef struct {
+    FILE* out;
+    // minimum wall time spent on every measured case
+    uint32_t duration_ms;
+    uint32_t result_count;
+} volc_bench_t;
+
+typedef uint32_t (*volc_bench_suite_fn)(volc_bench_t* bench);
+
+// appends one {"suite", "name", "value", "unit"} record; names are stable so results can be diffed across builds
+void volc_bench_report(volc_bench_t* bench, const char* suite, const char* name, double value, const char* unit);
+
+// true while fewer than duration_ms have passed since start_ms, *p_elapsed_ms receives the elapsed time
+bool volc_bench_running(volc_bench_t* bench, uint64_t start_ms, uint64_t* p_elapsed_ms);
+
+uint32_t volc_bench_tls(volc_bench_t* bench);
+uint32_t volc_bench_srtp(volc_bench_t* bench);
+uint32_t volc_bench_crc(volc_bench_t* bench);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __HAL_VOLC_BENCH_H__ */
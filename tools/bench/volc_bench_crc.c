@@ -0,0 +1,80 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_bench.h"
+
+#include <string.h>
+
+#include "volc_crypto.h"
+#include "volc_memory.h"
+#include "volc_time.h"
+#include "volc_type.h"
+
+#define VOLC_BENCH_CRC_SUITE    "crc"
+#define VOLC_BENCH_CRC_MAX_SIZE (64 * 1024)
+// calls between two clock reads, keeps the timer out of the small buffer results
+#define VOLC_BENCH_CRC_INNER 256
+
+typedef enum {
+    VOLC_BENCH_CRC_32,
+    VOLC_BENCH_CRC_32C,
+    // plain copy of the same buffer as the speed of light reference
+    VOLC_BENCH_CRC_MEMCPY,
+} volc_bench_crc_kind_e;
+
+static void _volc_bench_crc_case(volc_bench_t* bench, uint8_t* src, uint8_t* dst, uint32_t size, volc_bench_crc_kind_e kind) {
+    static const char* names[] = {"crc32", "crc32c", "memcpy"};
+    volatile uint32_t sink = 0;
+    char name[64];
+    uint64_t start = 0;
+    uint64_t elapsed = 0;
+    uint64_t bytes = 0;
+    uint32_t i = 0;
+
+    start = volc_get_montionic_time_ms();
+    do {
+        for (i = 0; i < VOLC_BENCH_CRC_INNER; i++) {
+            if (kind == VOLC_BENCH_CRC_32) {
+                sink ^= volc_crc32(0, src, size);
+            } else if (kind == VOLC_BENCH_CRC_32C) {
+                sink ^= volc_crc32c(0, src, size);
+            } else {
+                memcpy(dst, src, size);
+                sink ^= dst[i % size];
+            }
+        }
+        bytes += (uint64_t)size * VOLC_BENCH_CRC_INNER;
+    } while (volc_bench_running(bench, start, &elapsed));
+
+    snprintf(name, sizeof(name), "%s/%u", names[kind], size);
+    volc_bench_report(bench, VOLC_BENCH_CRC_SUITE, name, (double)bytes / (1024.0 * 1024.0) * 1000.0 / (double)VOLC_MAX(elapsed, 1), "MiB/s");
+}
+
+uint32_t volc_bench_crc(volc_bench_t* bench) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    // STUN message, full size RTP packet and a bulk buffer
+    static const uint32_t sizes[] = {100, 1200, VOLC_BENCH_CRC_MAX_SIZE};
+    uint8_t* src = NULL;
+    uint8_t* dst = NULL;
+    uint32_t s = 0;
+    uint32_t i = 0;
+
+    src = (uint8_t*)volc_malloc(VOLC_BENCH_CRC_MAX_SIZE);
+    dst = (uint8_t*)volc_malloc(VOLC_BENCH_CRC_MAX_SIZE);
+    VOLC_CHK(src != NULL && dst != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    for (i = 0; i < VOLC_BENCH_CRC_MAX_SIZE; i++) {
+        src[i] = (uint8_t)(i * 131 + 7);
+    }
+    for (s = 0; s < VOLC_ARRAY_SIZE(sizes); s++) {
+        _volc_bench_crc_case(bench, src, dst, sizes[s], VOLC_BENCH_CRC_32);
+        _volc_bench_crc_case(bench, src, dst, sizes[s], VOLC_BENCH_CRC_32C);
+        _volc_bench_crc_case(bench, src, dst, sizes[s], VOLC_BENCH_CRC_MEMCPY);
+    }
+
+err_out_label:
+    VOLC_SAFE_MEMFREE(src);
+    VOLC_SAFE_MEMFREE(dst);
+    return ret;
+}
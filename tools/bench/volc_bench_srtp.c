@@ -0,0 +1,125 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_bench.h"
+
+#include <string.h>
+
+#include "volc_memory.h"
+#include "volc_srtp.h"
+#include "volc_time.h"
+#include "volc_type.h"
+
+#define VOLC_BENCH_SRTP_SUITE    "srtp"
+#define VOLC_BENCH_SRTP_BATCH    32
+#define VOLC_BENCH_SRTP_MAX_SIZE 1200
+
+typedef struct {
+    uint8_t buf[VOLC_BENCH_SRTP_MAX_SIZE + VOLC_SRTP_MAX_TRAILER_LENGTH];
+} volc_bench_srtp_packet_t;
+
+static void _volc_bench_srtp_fill(volc_bench_srtp_packet_t* packets, volc_srtp_packet_t* batch, uint32_t size, uint16_t* p_seq) {
+    uint32_t i = 0;
+
+    for (i = 0; i < VOLC_BENCH_SRTP_BATCH; i++) {
+        memset(packets[i].buf, 0x5a, size);
+        packets[i].buf[0] = 0x80;
+        packets[i].buf[1] = 96;
+        packets[i].buf[2] = (uint8_t)(*p_seq >> 8);
+        packets[i].buf[3] = (uint8_t)*p_seq;
+        packets[i].buf[8] = 0x12;
+        packets[i].buf[9] = 0x34;
+        packets[i].buf[10] = 0x56;
+        packets[i].buf[11] = 0x78;
+        (*p_seq)++;
+        batch[i].packet = packets[i].buf;
+        batch[i].len = size;
+        batch[i].capacity = sizeof(packets[i].buf);
+        batch[i].status = VOLC_STATUS_SUCCESS;
+    }
+}
+
+// every packet is protected by one session and unprotected by another, so the receive side pays its replay checks too
+static uint32_t _volc_bench_srtp_roundtrip(volc_bench_t* bench, volc_bench_srtp_packet_t* packets, const char* profile_name, volc_srtp_profile_t profile,
+                                           uint32_t size, bool batched) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    static const uint8_t master_key[VOLC_SRTP_MAX_MASTER_KEY_LENGTH] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    static const uint8_t master_salt[VOLC_SRTP_CM_MASTER_SALT_LENGTH] = {21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34};
+    volc_srtp_packet_t batch[VOLC_BENCH_SRTP_BATCH];
+    volc_srtp_session_t sender = NULL;
+    volc_srtp_session_t receiver = NULL;
+    volc_srtp_policy_t policy;
+    char name[128];
+    uint64_t start = 0;
+    uint64_t elapsed = 0;
+    uint64_t count = 0;
+    uint16_t seq = 0;
+    uint32_t i = 0;
+
+    memset(&policy, 0, sizeof(policy));
+    policy.profile = profile;
+    policy.master_key = master_key;
+    policy.master_key_length = VOLC_AES128_KEY_LENGTH;
+    policy.master_salt = master_salt;
+    policy.master_salt_length = profile == VOLC_SRTP_PROFILE_AEAD_AES_128_GCM ? VOLC_SRTP_GCM_MASTER_SALT_LENGTH : VOLC_SRTP_CM_MASTER_SALT_LENGTH;
+    VOLC_CHK_STATUS(volc_srtp_session_create(&policy, &sender));
+    VOLC_CHK_STATUS(volc_srtp_session_create(&policy, &receiver));
+
+    start = volc_get_montionic_time_ms();
+    do {
+        _volc_bench_srtp_fill(packets, batch, size, &seq);
+        if (batched) {
+            VOLC_CHK_STATUS(volc_srtp_protect_batch(sender, batch, VOLC_BENCH_SRTP_BATCH));
+            VOLC_CHK_STATUS(volc_srtp_unprotect_batch(receiver, batch, VOLC_BENCH_SRTP_BATCH));
+        } else {
+            for (i = 0; i < VOLC_BENCH_SRTP_BATCH; i++) {
+                batch[i].status = volc_srtp_protect(sender, batch[i].packet, &batch[i].len, batch[i].capacity);
+                if (batch[i].status == VOLC_STATUS_SUCCESS) {
+                    batch[i].status = volc_srtp_unprotect(receiver, batch[i].packet, &batch[i].len);
+                }
+            }
+        }
+        for (i = 0; i < VOLC_BENCH_SRTP_BATCH; i++) {
+            VOLC_CHK_STATUS(batch[i].status);
+        }
+        count += VOLC_BENCH_SRTP_BATCH;
+    } while (volc_bench_running(bench, start, &elapsed));
+
+    snprintf(name, sizeof(name), "roundtrip/%s/%u/%s", profile_name, size, batched ? "batch32" : "single");
+    volc_bench_report(bench, VOLC_BENCH_SRTP_SUITE, name, (double)count * 1000.0 / (double)VOLC_MAX(elapsed, 1), "packets/s");
+
+err_out_label:
+    volc_srtp_session_destroy(sender);
+    volc_srtp_session_destroy(receiver);
+    return ret;
+}
+
+uint32_t volc_bench_srtp(volc_bench_t* bench) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    static const uint32_t sizes[] = {160, VOLC_BENCH_SRTP_MAX_SIZE};
+    static const struct {
+        const char* name;
+        volc_srtp_profile_t profile;
+    } profiles[] = {
+        {"aes128-cm-sha1-80", VOLC_SRTP_PROFILE_AES128_CM_HMAC_SHA1_80},
+        {"aead-aes128-gcm", VOLC_SRTP_PROFILE_AEAD_AES_128_GCM},
+    };
+    volc_bench_srtp_packet_t* packets = NULL;
+    uint32_t p = 0;
+    uint32_t s = 0;
+
+    packets = (volc_bench_srtp_packet_t*)volc_malloc(sizeof(volc_bench_srtp_packet_t) * VOLC_BENCH_SRTP_BATCH);
+    VOLC_CHK(packets != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    for (p = 0; p < VOLC_ARRAY_SIZE(profiles); p++) {
+        for (s = 0; s < VOLC_ARRAY_SIZE(sizes); s++) {
+            VOLC_CHK_STATUS(_volc_bench_srtp_roundtrip(bench, packets, profiles[p].name, profiles[p].profile, sizes[s], false));
+            VOLC_CHK_STATUS(_volc_bench_srtp_roundtrip(bench, packets, profiles[p].name, profiles[p].profile, sizes[s], true));
+        }
+    }
+
+err_out_label:
+    VOLC_SAFE_MEMFREE(packets);
+    return ret;
+}
@@ -0,0 +1,270 @@
+/*
+ * Copyright (2025) Beijing Volcano Engine Technology Co., Ltd.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "volc_bench.h"
+
+#include <string.h>
+
+#include "volc_crypto.h"
+#include "volc_memory.h"
+#include "volc_time.h"
+#include "volc_tls.h"
+#include "volc_type.h"
+
+#define VOLC_BENCH_TLS_SUITE          "tls"
+#define VOLC_BENCH_TLS_HOST           "bench.volc.local"
+#define VOLC_BENCH_TLS_PIPE_SIZE      (64 * 1024)
+#define VOLC_BENCH_TLS_MAX_ROUNDS     64
+#define VOLC_BENCH_TLS_RSA_BITS       2048
+#define VOLC_BENCH_TLS_MAX_RECORD     16384
+
+// one direction of the in-memory transport, data in [off, len) is unread
+typedef struct {
+    uint8_t buf[VOLC_BENCH_TLS_PIPE_SIZE];
+    size_t off;
+    size_t len;
+} volc_bench_pipe_t;
+
+typedef struct {
+    volc_bench_pipe_t* tx;
+    volc_bench_pipe_t* rx;
+} volc_bench_endpoint_t;
+
+typedef struct {
+    volc_bench_pipe_t c2s;
+    volc_bench_pipe_t s2c;
+    volc_bench_endpoint_t client_end;
+    volc_bench_endpoint_t server_end;
+    volc_tls_t client;
+    volc_tls_t server;
+} volc_bench_link_t;
+
+typedef struct {
+    const char* name;
+    bool rsa;
+    volc_cert_t cert;
+    volc_pkey_t pkey;
+    volc_tls_config_t config;
+} volc_bench_identity_t;
+
+static int32_t _volc_bench_pipe_send(void* custom_data, const unsigned char* buf, unsigned long len) {
+    volc_bench_pipe_t* pipe = ((volc_bench_endpoint_t*)custom_data)->tx;
+    size_t n = 0;
+    if (pipe->off > 0 && pipe->len + len > VOLC_BENCH_TLS_PIPE_SIZE) {
+        memmove(pipe->buf, pipe->buf + pipe->off, pipe->len - pipe->off);
+        pipe->len -= pipe->off;
+        pipe->off = 0;
+    }
+    n = VOLC_MIN((size_t)len, VOLC_BENCH_TLS_PIPE_SIZE - pipe->len);
+    if (n == 0) {
+        return VOLC_MBEDTLS_ERR_SSL_WANT_WRITE;
+    }
+    memcpy(pipe->buf + pipe->len, buf, n);
+    pipe->len += n;
+    return (int32_t)n;
+}
+
+static int32_t _volc_bench_pipe_recv(void* custom_data, unsigned char* buf, unsigned long len) {
+    volc_bench_pipe_t* pipe = ((volc_bench_endpoint_t*)custom_data)->rx;
+    size_t n = VOLC_MIN((size_t)len, pipe->len - pipe->off);
+    if (n == 0) {
+        return VOLC_MBEDTLS_ERR_SSL_WANT_READ;
+    }
+    memcpy(buf, pipe->buf + pipe->off, n);
+    pipe->off += n;
+    if (pipe->off == pipe->len) {
+        pipe->off = 0;
+        pipe->len = 0;
+    }
+    return (int32_t)n;
+}
+
+static void _volc_bench_link_close(volc_bench_link_t* link) {
+    volc_tls_destroy(link->client);
+    volc_tls_destroy(link->server);
+    link->client = NULL;
+    link->server = NULL;
+}
+
+// runs client and server in lockstep over the in-memory pipes until both finished the handshake
+static uint32_t _volc_bench_link_open(volc_bench_link_t* link, volc_tls_config_t config) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    uint32_t client_status = VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY;
+    uint32_t server_status = VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY;
+    uint32_t round = 0;
+    short events = 0;
+    unsigned char byte = 0;
+
+    link->c2s.off = link->c2s.len = 0;
+    link->s2c.off = link->s2c.len = 0;
+    link->client_end.tx = &link->c2s;
+    link->client_end.rx = &link->s2c;
+    link->server_end.tx = &link->s2c;
+    link->server_end.rx = &link->c2s;
+    VOLC_CHK_STATUS(volc_tls_create_with_config(config, &link->client));
+    VOLC_CHK_STATUS(volc_tls_create_with_config(config, &link->server));
+    volc_tls_start(link->client, false, VOLC_BENCH_TLS_HOST, _volc_bench_pipe_send, _volc_bench_pipe_recv, &link->client_end);
+    volc_tls_start(link->server, true, VOLC_BENCH_TLS_HOST, _volc_bench_pipe_send, _volc_bench_pipe_recv, &link->server_end);
+    for (round = 0; round < VOLC_BENCH_TLS_MAX_ROUNDS; round++) {
+        if (client_status == VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY) {
+            client_status = volc_tls_handshake_step(link->client, &events);
+        }
+        if (server_status == VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY) {
+            server_status = volc_tls_handshake_step(link->server, &events);
+        }
+        if (client_status != VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY && server_status != VOLC_STATUS_EVLOOP_PERFORM_NEED_RETRY) {
+            break;
+        }
+    }
+    VOLC_CHK(client_status == VOLC_STATUS_SUCCESS && server_status == VOLC_STATUS_SUCCESS, VOLC_STATUS_SSL_CONNECTION_FAILED);
+    // TLS 1.3 tickets follow the handshake, let the client pick them up so the next connection can resume
+    volc_tls_read(link->client, &byte, 1);
+
+err_out_label:
+    if (VOLC_STATUS_FAILED(ret)) {
+        _volc_bench_link_close(link);
+    }
+    return ret;
+}
+
+static uint32_t _volc_bench_tls_handshake(volc_bench_t* bench, volc_bench_link_t* link, volc_bench_identity_t* identity, const char* version, bool resumed) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    uint64_t start = 0;
+    uint64_t elapsed = 0;
+    uint64_t count = 0;
+    char name[128];
+
+    volc_tls_session_cache_clear();
+    if (resumed) {
+        // seed the session cache with one full handshake
+        VOLC_CHK_STATUS(_volc_bench_link_open(link, identity->config));
+        _volc_bench_link_close(link);
+    }
+    start = volc_get_montionic_time_ms();
+    do {
+        if (!resumed) {
+            volc_tls_session_cache_clear();
+        }
+        VOLC_CHK_STATUS(_volc_bench_link_open(link, identity->config));
+        _volc_bench_link_close(link);
+        count++;
+    } while (volc_bench_running(bench, start, &elapsed));
+
+    snprintf(name, sizeof(name), "handshake/%s/%s/%s", version, identity->name, resumed ? "resumed" : "full");
+    volc_bench_report(bench, VOLC_BENCH_TLS_SUITE, name, (double)count * 1000.0 / (double)VOLC_MAX(elapsed, 1), "ops/s");
+
+err_out_label:
+    return ret;
+}
+
+static uint32_t _volc_bench_tls_throughput(volc_bench_t* bench, volc_bench_link_t* link, volc_bench_identity_t* identity, const char* version, uint32_t record_size) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    uint8_t* payload = NULL;
+    uint8_t* sink = NULL;
+    uint64_t start = 0;
+    uint64_t elapsed = 0;
+    uint64_t received = 0;
+    int n = 0;
+    char name[128];
+
+    payload = (uint8_t*)volc_malloc(record_size);
+    sink = (uint8_t*)volc_malloc(VOLC_BENCH_TLS_MAX_RECORD);
+    VOLC_CHK(payload != NULL && sink != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    memset(payload, 0xa5, record_size);
+    VOLC_CHK_STATUS(_volc_bench_link_open(link, identity->config));
+
+    start = volc_get_montionic_time_ms();
+    do {
+        n = volc_tls_write(link->client, payload, record_size);
+        VOLC_CHK(n > 0 || n == VOLC_MBEDTLS_ERR_SSL_WANT_WRITE, VOLC_STATUS_SSL_CONNECTION_FAILED);
+        // drain on every write, the measured cost is encrypt plus decrypt of the same bytes
+        while ((n = volc_tls_read(link->server, sink, VOLC_BENCH_TLS_MAX_RECORD)) > 0) {
+            received += (uint64_t)n;
+        }
+        VOLC_CHK(n == VOLC_MBEDTLS_ERR_SSL_WANT_READ, VOLC_STATUS_SSL_CONNECTION_FAILED);
+    } while (volc_bench_running(bench, start, &elapsed));
+
+    snprintf(name, sizeof(name), "throughput/%s/%s/%u", version, identity->name, record_size);
+    volc_bench_report(bench, VOLC_BENCH_TLS_SUITE, name, (double)received / (1024.0 * 1024.0) * 1000.0 / (double)VOLC_MAX(elapsed, 1), "MiB/s");
+
+err_out_label:
+    _volc_bench_link_close(link);
+    VOLC_SAFE_MEMFREE(payload);
+    VOLC_SAFE_MEMFREE(sink);
+    return ret;
+}
+
+static uint32_t _volc_bench_tls_memory(volc_bench_t* bench, volc_bench_link_t* link, volc_bench_identity_t* identity, const char* version) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    volc_tls_memory_report_t report;
+    char name[128];
+
+    VOLC_CHK_STATUS(_volc_bench_link_open(link, identity->config));
+    VOLC_CHK_STATUS(volc_tls_get_memory_report(link->client, &report));
+    snprintf(name, sizeof(name), "memory/%s/%s/client", version, identity->name);
+    volc_bench_report(bench, VOLC_BENCH_TLS_SUITE, name, (double)report.total_size, "bytes");
+    VOLC_CHK_STATUS(volc_tls_get_memory_report(link->server, &report));
+    snprintf(name, sizeof(name), "memory/%s/%s/server", version, identity->name);
+    volc_bench_report(bench, VOLC_BENCH_TLS_SUITE, name, (double)report.total_size, "bytes");
+
+err_out_label:
+    _volc_bench_link_close(link);
+    return ret;
+}
+
+uint32_t volc_bench_tls(volc_bench_t* bench) {
+    uint32_t ret = VOLC_STATUS_SUCCESS;
+    static const uint32_t record_sizes[] = {256, 1024, 4096, 16384};
+    static const struct {
+        const char* name;
+        volc_tls_version_e version;
+    } versions[] = {
+        {"tls1.2", VOLC_TLS_VERSION_1_2},
+        {"tls1.3", VOLC_TLS_VERSION_1_3},
+    };
+    volc_bench_identity_t identities[] = {
+        {"rsa2048", true, NULL, NULL, NULL},
+        {"ecdsa-p256", false, NULL, NULL, NULL},
+    };
+    volc_bench_link_t* link = NULL;
+    uint32_t i = 0;
+    uint32_t v = 0;
+    uint32_t r = 0;
+
+    // resumption over TLS 1.3 and TLS 1.2 both go through tickets, they must be on before the configs are created
+    volc_tls_enable_server_session_tickets(0);
+    link = (volc_bench_link_t*)volc_malloc(sizeof(volc_bench_link_t));
+    VOLC_CHK(link != NULL, VOLC_STATUS_NOT_ENOUGH_MEMORY);
+    memset(link, 0, sizeof(volc_bench_link_t));
+    for (i = 0; i < VOLC_ARRAY_SIZE(identities); i++) {
+        VOLC_CHK_STATUS(volc_certificate_and_key_create(VOLC_BENCH_TLS_RSA_BITS, identities[i].rsa, &identities[i].cert, &identities[i].pkey));
+        VOLC_CHK_STATUS(volc_tls_config_create(&identities[i].config));
+        VOLC_CHK_STATUS(volc_tls_config_set_own_cert(identities[i].config, identities[i].cert, identities[i].pkey));
+    }
+
+    for (v = 0; v < VOLC_ARRAY_SIZE(versions); v++) {
+        for (i = 0; i < VOLC_ARRAY_SIZE(identities); i++) {
+            VOLC_CHK_STATUS(volc_tls_config_set_version_range(identities[i].config, versions[v].version, versions[v].version));
+            VOLC_CHK_STATUS(_volc_bench_tls_handshake(bench, link, &identities[i], versions[v].name, false));
+            VOLC_CHK_STATUS(_volc_bench_tls_handshake(bench, link, &identities[i], versions[v].name, true));
+            VOLC_CHK_STATUS(_volc_bench_tls_memory(bench, link, &identities[i], versions[v].name));
+        }
+        // record protection cost does not depend on the certificate, measure it once per version
+        for (r = 0; r < VOLC_ARRAY_SIZE(record_sizes); r++) {
+            VOLC_CHK_STATUS(_volc_bench_tls_throughput(bench, link, &identities[1], versions[v].name, record_sizes[r]));
+        }
+    }
+
+err_out_label:
+    for (i = 0; i < VOLC_ARRAY_SIZE(identities); i++) {
+        volc_tls_config_destroy(identities[i].config);
+        if (identities[i].cert != NULL) {
+            volc_certificate_and_key_destroy(&identities[i].cert, &identities[i].pkey);
+        }
+    }
+    VOLC_SAFE_MEMFREE(link);
+    volc_tls_session_cache_clear();
+    return ret;
+}